@@ -1,5 +1,24 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "ui/SvgCache.h"
+
+namespace
+{
+    // holds the SVG cache from the first editor until JUCE shuts down, so closing and reopening editors skips the parsing
+    class SvgCacheKeepAlive  : private juce::DeletedAtShutdown
+    {
+    public:
+        SvgCacheKeepAlive() = default;
+        ~SvgCacheKeepAlive() override { clearSingletonInstance(); }
+        
+        JUCE_DECLARE_SINGLETON (SvgCacheKeepAlive, false)
+        
+    private:
+        juce::SharedResourcePointer<SvgCache> svgCache;
+    };
+    
+    JUCE_IMPLEMENT_SINGLETON (SvgCacheKeepAlive)
+}
 
 PluginEditor::PluginEditor (PluginProcessor& p, juce::UndoManager& um)
 : AudioProcessorEditor (&p), audioProcessor (p)
@@ -7,6 +26,8 @@ PluginEditor::PluginEditor (PluginProcessor& p, juce::UndoManager& um)
 , nonParamTree(p.getPluginNonParamTree())
 , editorContent(p, um)
 {
+    SvgCacheKeepAlive::getInstance();
+    
     setSize (1264, 618);
     
     addAndMakeVisible(editorContent);
@@ -3,11 +3,13 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "ui/EditorContent.h"
+#include "ui/FrameScheduler.h"
 
 //==============================================================================
 /**
 */
 class PluginEditor  : public juce::AudioProcessorEditor
+                    , public FrameScheduler::Owner
 {
 public:
     PluginEditor (PluginProcessor&, juce::UndoManager&);
@@ -15,12 +17,16 @@ public:
 
     void paint (juce::Graphics&) override;
     void resized() override;
+    
+    FrameScheduler& getFrameScheduler() override { return frameScheduler; }
 
 private:
     PluginProcessor& audioProcessor;
     juce::AudioProcessorValueTreeState& apvts;
     juce::ValueTree nonParamTree;
     
+    // before the content, so it outlives every component that animates
+    FrameScheduler frameScheduler { *this };
     EditorContent editorContent;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginEditor)
@@ -5,11 +5,10 @@ PluginProcessor::PluginProcessor()
 
 : AudioProcessor (BusesProperties()
                   .withOutput ("Output", juce::AudioChannelSet::stereo(), true))
-, midiFifo(16)
-, apvts(*this, &undoManager, juce::Identifier("Parameters"),
+, apvts(*this, &undoManager, ParamIDs::parameterTree,
         ParameterHelper::createParameterLayout())
 , nonParamStateTree(ParameterHelper::createNonParameterLayout())
-, presetManager(apvts, nonParamStateTree)
+, presetManager(apvts, nonParamStateTree, tableRebuilder)
 , effectsProcessorGraph()
 , lfoTree(nonParamStateTree.getChildWithName(ParamIDs::lfoTree))
 , lfo1(*apvts.getParameter(ParamIDs::lfo1FrequencyTime),
@@ -32,7 +31,7 @@ PluginProcessor::PluginProcessor()
     delayNode = effectsProcessorGraph.addNode(std::make_unique<DelayProcessor>(apvts, nonParamStateTree, lfo1, lfo2, bpm));
     reverbNode = effectsProcessorGraph.addNode(std::make_unique<ReverbProcessor>(apvts, nonParamStateTree, lfo1, lfo2));
     filterNode = effectsProcessorGraph.addNode(std::make_unique<FilterProcessor>(apvts, nonParamStateTree, lfo1, lfo2));
-    waveshaperNode = effectsProcessorGraph.addNode(std::make_unique<WaveshaperProcessor>(apvts, nonParamStateTree, lfo1, lfo2, waveshaperControlTable, waveshaperTransformTable));
+    waveshaperNode = effectsProcessorGraph.addNode(std::make_unique<WaveshaperProcessor>(apvts, nonParamStateTree, lfo1, lfo2, waveshaperControlTable, waveshaperTransformTable, waveshaperTableVersion, tableRebuilder, presetManager.getChangeBatcher()));
     
     effectsOrder.add(delayNode);
     effectsOrder.add(reverbNode);
@@ -60,46 +59,21 @@ PluginProcessor::PluginProcessor()
     
     /* ----- HANDLE ENVELOPE TABLES ----- */
     
-    apvts.addParameterListener(ParamIDs::oscSlope1Amp, this);
-    apvts.addParameterListener(ParamIDs::oscSlope2Amp, this);
-    apvts.addParameterListener(ParamIDs::oscSlope3Amp, this);
-    apvts.addParameterListener(ParamIDs::oscSlope1Pitch, this);
-    apvts.addParameterListener(ParamIDs::oscSlope2Pitch, this);
-    apvts.addParameterListener(ParamIDs::oscSlope3Pitch, this);
-    apvts.addParameterListener(ParamIDs::noiseSlope1Amp, this);
-    apvts.addParameterListener(ParamIDs::noiseSlope2Amp, this);
-    apvts.addParameterListener(ParamIDs::noiseSlope3Amp, this);
-    apvts.addParameterListener(ParamIDs::noiseSlope1Cutoff, this);
-    apvts.addParameterListener(ParamIDs::noiseSlope2Cutoff, this);
-    apvts.addParameterListener(ParamIDs::noiseSlope3Cutoff, this);
-    
-    oscAmpTables.add(new juce::dsp::LookupTableTransform<float>());
-    oscAmpTables.add(new juce::dsp::LookupTableTransform<float>());
-    oscAmpTables.add(new juce::dsp::LookupTableTransform<float>());
-    updateTableWithSlope(oscAmpTables[0], *apvts.getRawParameterValue(ParamIDs::oscSlope1Amp));
-    updateTableWithSlope(oscAmpTables[1], *apvts.getRawParameterValue(ParamIDs::oscSlope2Amp));
-    updateTableWithSlope(oscAmpTables[2], *apvts.getRawParameterValue(ParamIDs::oscSlope3Amp));
-    
-    oscPitchTables.add(new juce::dsp::LookupTableTransform<float>());
-    oscPitchTables.add(new juce::dsp::LookupTableTransform<float>());
-    oscPitchTables.add(new juce::dsp::LookupTableTransform<float>());
-    updateTableWithSlope(oscPitchTables[0], *apvts.getRawParameterValue(ParamIDs::oscSlope1Pitch));
-    updateTableWithSlope(oscPitchTables[1], *apvts.getRawParameterValue(ParamIDs::oscSlope2Pitch));
-    updateTableWithSlope(oscPitchTables[2], *apvts.getRawParameterValue(ParamIDs::oscSlope3Pitch));
-    
-    noiseAmpTables.add(new juce::dsp::LookupTableTransform<float>());
-    noiseAmpTables.add(new juce::dsp::LookupTableTransform<float>());
-    noiseAmpTables.add(new juce::dsp::LookupTableTransform<float>());
-    updateTableWithSlope(noiseAmpTables[0], *apvts.getRawParameterValue(ParamIDs::noiseSlope1Amp));
-    updateTableWithSlope(noiseAmpTables[1], *apvts.getRawParameterValue(ParamIDs::noiseSlope2Amp));
-    updateTableWithSlope(noiseAmpTables[2], *apvts.getRawParameterValue(ParamIDs::noiseSlope3Amp));
-    
-    noiseFilterTables.add(new juce::dsp::LookupTableTransform<float>());
-    noiseFilterTables.add(new juce::dsp::LookupTableTransform<float>());
-    noiseFilterTables.add(new juce::dsp::LookupTableTransform<float>());
-    updateTableWithSlope(noiseFilterTables[0], *apvts.getRawParameterValue(ParamIDs::noiseSlope1Cutoff));
-    updateTableWithSlope(noiseFilterTables[1], *apvts.getRawParameterValue(ParamIDs::noiseSlope2Cutoff));
-    updateTableWithSlope(noiseFilterTables[2], *apvts.getRawParameterValue(ParamIDs::noiseSlope3Cutoff));
+    oscAmpSlopeJobs = { addSlopeTable(oscAmpTables, ParamIDs::oscSlope1Amp),
+                        addSlopeTable(oscAmpTables, ParamIDs::oscSlope2Amp),
+                        addSlopeTable(oscAmpTables, ParamIDs::oscSlope3Amp) };
+    
+    oscPitchSlopeJobs = { addSlopeTable(oscPitchTables, ParamIDs::oscSlope1Pitch),
+                          addSlopeTable(oscPitchTables, ParamIDs::oscSlope2Pitch),
+                          addSlopeTable(oscPitchTables, ParamIDs::oscSlope3Pitch) };
+    
+    noiseAmpSlopeJobs = { addSlopeTable(noiseAmpTables, ParamIDs::noiseSlope1Amp),
+                          addSlopeTable(noiseAmpTables, ParamIDs::noiseSlope2Amp),
+                          addSlopeTable(noiseAmpTables, ParamIDs::noiseSlope3Amp) };
+    
+    noiseFilterSlopeJobs = { addSlopeTable(noiseFilterTables, ParamIDs::noiseSlope1Cutoff),
+                             addSlopeTable(noiseFilterTables, ParamIDs::noiseSlope2Cutoff),
+                             addSlopeTable(noiseFilterTables, ParamIDs::noiseSlope3Cutoff) };
     
     /* ----- CAST PARAMETERS ----- */
     
@@ -181,14 +155,37 @@ void PluginProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     lfo1.prepare(spec);
     lfo2.prepare(spec);
     
-    masterGain.prepare(spec);
-    masterGain.setRampDurationSeconds(0.0005f);
+    masterStage.prepare(sampleRate);
+    presetManager.getTransition().prepare(sampleRate);
+    
+    outputAnalyzer.prepare(sampleRate, samplesPerBlock);
+    scopeAnalyzer.prepare(sampleRate, samplesPerBlock);
 }
 
 void PluginProcessor::releaseResources()
 {
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
+    outputAnalyzer.release();
+    scopeAnalyzer.release();
+}
+
+void PluginProcessor::setNonRealtime (bool isNonRealtime) noexcept
+{
+    juce::AudioProcessor::setNonRealtime(isNonRealtime);
+    effectsProcessorGraph.setNonRealtime(isNonRealtime);
+}
+
+void PluginProcessor::setHighestQuality (bool shouldUseHighestQuality) noexcept
+{
+    if (auto waveshaper = dynamic_cast<WaveshaperProcessor*>(waveshaperNode->getProcessor()))
+        waveshaper->setHighestQuality(shouldUseHighestQuality);
+}
+
+void PluginProcessor::finishPendingLoads()
+{
+    tableRebuilder.runPendingJobs();
+    
+    if (auto reverb = dynamic_cast<ReverbProcessor*>(reverbNode->getProcessor()))
+        reverb->finishImpulseResponseLoad();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -233,11 +230,21 @@ void PluginProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::Midi
     
     /* ----- SYNTH PROCESSING ----- */
     
-    juce::MidiMessage message;
-    while (midiFifo.pop(message))
-        midiMessages.addEvent(message, 0);
-
-    synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    // queued events go straight to the synth, splitting the render where each one lands among the host's MIDI
+    int renderedSamples = 0;
+    
+    noteEvents.drainBlock(getSampleRate(), buffer.getNumSamples(), [&] (const NoteEvent& event, int sampleOffset)
+    {
+        if (sampleOffset > renderedSamples)
+        {
+            synth.renderNextBlock(buffer, midiMessages, renderedSamples, sampleOffset - renderedSamples);
+            renderedSamples = sampleOffset;
+        }
+        
+        playNoteEvent(event);
+    });
+    
+    synth.renderNextBlock(buffer, midiMessages, renderedSamples, buffer.getNumSamples() - renderedSamples);
     midiMessages.clear();
     
     /* ----- EFFECTS GRAPH PROCESSING ----- */
@@ -248,87 +255,77 @@ void PluginProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::Midi
     
     effectsProcessorGraph.processBlock(buffer, midiMessages);
     
-    /* ----- APPLY MASTER GAIN ----- */
+    /* ----- MASTER GAIN, OUTPUT GUARD AND METERING HAND-OFF ----- */
     
     const float gainVal = LFO::processLFOSample(masterGainParam,
                                                 lfoTree.getChildWithName(ParamIDs::lfoMasterGain),
                                                 masterGainParam->convertTo0to1(masterGainParam->get()),
                                                 lfo1.buffer.getSample(0, 0),
                                                 lfo2.buffer.getSample(0, 0));
-    masterGain.setGainLinear(juce::Decibels::decibelsToGain(gainVal));
-    juce::dsp::AudioBlock<float> block (buffer);
-    masterGain.process(juce::dsp::ProcessContextReplacing<float>(block));
+    auto& presetTransition = presetManager.getTransition();
+    const float outputGain = juce::Decibels::decibelsToGain(gainVal) * presetTransition.advance(buffer.getNumSamples());
     
-    /* ----- STORE LEVELS FOR METER ----- */
+    // preset fades ramp across the whole block, so consecutive blocks join into one smooth fade
+    if (presetTransition.isRamping())
+        masterStage.setTargetGain(outputGain, buffer.getNumSamples());
+    else
+        masterStage.setTargetGain(outputGain);
     
-    leftRMS.store(buffer.getRMSLevel(0, 0, buffer.getNumSamples()));
-    rightRMS.store(buffer.getRMSLevel(1, 0, buffer.getNumSamples()));
+    masterStage.process(buffer, outputAnalyzer);
     
-    auto leftMinMax = buffer.findMinMax(0, 0, buffer.getNumSamples());
-    leftPeak.store(juce::jmax(std::abs(leftMinMax.getStart()), std::abs(leftMinMax.getEnd())));
-    auto rightMinMax = buffer.findMinMax(1, 0, buffer.getNumSamples());
-    rightPeak.store(juce::jmax(std::abs(rightMinMax.getStart()), std::abs(rightMinMax.getEnd())));
+    // returns straight away unless the analyzer panel is open
+    scopeAnalyzer.pushBlock(buffer);
 }
 
 float PluginProcessor::getRMSLevel (const int channel)
 {
-    if (channel == 0)
-        return juce::Decibels::gainToDecibels(leftRMS.load());
-    if (channel == 1)
-        return juce::Decibels::gainToDecibels(rightRMS.load());
-    
-    jassert(false);
-    return 0.0f;
+    return outputAnalyzer.getRMSLevel(channel);
 }
 
-float PluginProcessor::getSimplePeak (const int channel)
+float PluginProcessor::getTruePeak (const int channel)
 {
-    if (channel == 0)
-        return juce::Decibels::gainToDecibels(leftPeak.load());
-    if (channel == 1)
-        return juce::Decibels::gainToDecibels(rightPeak.load());
-    
-    jassert(false);
-    return 0.0f;
+    return outputAnalyzer.getTruePeakAndReset(channel);
 }
 
 void PluginProcessor::parameterChanged (const juce::String& parameterID, float newValue)
 {
+    // slopes are dragged and automated far faster than the tables need rebuilding, so the rebuilder
+    // collapses each burst into one rebuild a frame, reading the slope again when it runs
     if (parameterID == ParamIDs::oscSlope1Amp)
-        updateTableWithSlope(oscAmpTables[0], newValue);
+        tableRebuilder.request(oscAmpSlopeJobs[0]);
     
     else if (parameterID == ParamIDs::oscSlope2Amp)
-        updateTableWithSlope(oscAmpTables[1], newValue);
+        tableRebuilder.request(oscAmpSlopeJobs[1]);
     
     else if (parameterID == ParamIDs::oscSlope3Amp)
-        updateTableWithSlope(oscAmpTables[2], newValue);
+        tableRebuilder.request(oscAmpSlopeJobs[2]);
     
     else if (parameterID == ParamIDs::oscSlope1Pitch)
-        updateTableWithSlope(oscPitchTables[0], newValue);
+        tableRebuilder.request(oscPitchSlopeJobs[0]);
     
     else if (parameterID == ParamIDs::oscSlope2Pitch)
-        updateTableWithSlope(oscPitchTables[1], newValue);
+        tableRebuilder.request(oscPitchSlopeJobs[1]);
     
     else if (parameterID == ParamIDs::oscSlope3Pitch)
-        updateTableWithSlope(oscPitchTables[2], newValue);
+        tableRebuilder.request(oscPitchSlopeJobs[2]);
     
     else if (parameterID == ParamIDs::noiseSlope1Amp)
-        updateTableWithSlope(noiseAmpTables[0], newValue);
+        tableRebuilder.request(noiseAmpSlopeJobs[0]);
     
     else if (parameterID == ParamIDs::noiseSlope2Amp)
-        updateTableWithSlope(noiseAmpTables[1], newValue);
+        tableRebuilder.request(noiseAmpSlopeJobs[1]);
     
     else if (parameterID == ParamIDs::noiseSlope3Amp)
-        updateTableWithSlope(noiseAmpTables[2], newValue);
+        tableRebuilder.request(noiseAmpSlopeJobs[2]);
     
     else if (parameterID == ParamIDs::noiseSlope1Cutoff)
-        updateTableWithSlope(noiseFilterTables[0], newValue);
+        tableRebuilder.request(noiseFilterSlopeJobs[0]);
     
     else if (parameterID == ParamIDs::noiseSlope2Cutoff)
-        updateTableWithSlope(noiseFilterTables[1], newValue);
+        tableRebuilder.request(noiseFilterSlopeJobs[1]);
     
     else if (parameterID == ParamIDs::noiseSlope3Cutoff)
-        updateTableWithSlope(noiseFilterTables[2], newValue);
+        tableRebuilder.request(noiseFilterSlopeJobs[2]);
 }
 
 void PluginProcessor::connectEffectsGraph()
@@ -370,7 +367,36 @@ void PluginProcessor::connectEffectsGraph()
     // TODO handle bypassing, or maybe handle in a different callback
 }
 
-void PluginProcessor::updateTableWithSlope (juce::dsp::LookupTableTransform<float>* table, const float newSlope)
+void PluginProcessor::playNoteEvent (const NoteEvent& event)
+{
+    switch (event.type)
+    {
+        case NoteEvent::Type::noteOn:
+            synth.noteOn(event.channel, event.number, event.getVelocity());
+            break;
+            
+        case NoteEvent::Type::noteOff:
+            synth.noteOff(event.channel, event.number, event.getVelocity(), true);
+            break;
+            
+        case NoteEvent::Type::controller:
+            synth.handleController(event.channel, event.number, event.value);
+            break;
+    }
+}
+
+int PluginProcessor::addSlopeTable (juce::OwnedArray<SwappableTable>& tables, const juce::String& slopeParameterID)
+{
+    auto* table = tables.add(new SwappableTable());
+    auto* slope = apvts.getRawParameterValue(slopeParameterID);
+    
+    updateTableWithSlope(table, slope->load());
+    apvts.addParameterListener(slopeParameterID, this);
+    
+    return tableRebuilder.addJob([this, table, slope] { updateTableWithSlope(table, slope->load()); });
+}
+
+void PluginProcessor::updateTableWithSlope (SwappableTable* table, const float newSlope)
 {
     (*table).initialise([&] (float i) {
         if (newSlope < -10.0f)
@@ -380,11 +406,14 @@ void PluginProcessor::updateTableWithSlope (juce::dsp::LookupTableTransform<floa
         else
             return newSlope == 0.0f ? i : (expf(newSlope * i) - 1.0f) / (expf(newSlope) - 1.0f);
     }, 0.0f, 1.0f, 64);
+    
+    envelopeTableVersion.fetch_add(1);
 }
 
 void PluginProcessor::valueTreeChildOrderChanged (juce::ValueTree &parentTreeWhoseChildrenHaveMoved, int oldIndex, int newIndex)
 {
-    shouldUpdateEffectsGraph.store(true);
+    // a reorder is several moves; the audio thread should only ever rewire to the finished order
+    presetManager.getChangeBatcher().runOrDefer(&effectsOrderTree, [this] { shouldUpdateEffectsGraph.store(true); });
 }
 
 //==============================================================================
@@ -397,21 +426,15 @@ juce::AudioProcessorEditor* PluginProcessor::createEditor()
 
 void PluginProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    juce::XmlElement xmlParent ("parent");
-
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xmlAPVTS (state.createXml());
-    xmlParent.addChildElement(xmlAPVTS.release());
-
-    std::unique_ptr<juce::XmlElement> xmlNonAPVTS (nonParamStateTree.createXml());
-    xmlParent.addChildElement(xmlNonAPVTS.release());
-    
-    std::unique_ptr<juce::XmlElement> xml = presetManager.getStateXml();
-    copyXmlToBinary(*xml, destData);
+    presetManager.writeStateBinary(destData);
 }
 
 void PluginProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
+    if (presetManager.loadStateFromBinary(data, sizeInBytes))
+        return;
+    
+    // sessions saved before the binary format
     std::unique_ptr<juce::XmlElement> xmlState (getXmlFromBinary(data, sizeInBytes));
     presetManager.loadStateFromXml(std::move(xmlState));
 }
@@ -422,6 +445,8 @@ juce::ValueTree PluginProcessor::getPluginNonParamTree() { return nonParamStateT
 
 PresetManager& PluginProcessor::getPresetManager() { return presetManager; }
 
+TableRebuilder& PluginProcessor::getTableRebuilder() { return tableRebuilder; }
+
 LFOVisualizer& PluginProcessor::getLFOVisualizer (const int lfoNum)
 {
     jassert(lfoNum == 0 || lfoNum == 1);
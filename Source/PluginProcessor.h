@@ -8,11 +8,16 @@
 #include "dsp/DelayProcessor.h"
 #include "dsp/ReverbProcessor.h"
 #include "dsp/FilterProcessor.h"
+#include "dsp/OutputAnalyzer.h"
+#include "dsp/ScopeAnalyzer.h"
+#include "dsp/MasterStage.h"
 #include "dsp/WaveshaperProcessor.h"
 #include "service/ParamIDs.h"
 #include "service/PresetManager.h"
+#include "service/NoteEventQueue.h"
 #include "service/ParameterHelper.h"
-#include "service/farbot/fifo.hpp"
+#include "service/SwappableTable.h"
+#include "service/TableRebuilder.h"
 #include "ui/LFOVisualizer.h"
 
 class PluginProcessor  : public juce::AudioProcessor,
@@ -32,8 +37,18 @@ public:
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
     
+    /* passed on to the effects graph, so its processors see the same mode as the host set */
+    void setNonRealtime (bool isNonRealtime) noexcept override;
+    /* an explicit opt-in for the render tool; offline bounces from a host keep the patch's own quality settings */
+    void setHighestQuality (bool shouldUseHighestQuality) noexcept;
+    /* runs any table rebuilds still waiting for the rebuild thread and finishes the impulse response load here,
+       so a render without an editor starts from the loaded state. Call after prepareToPlay, with nothing processing */
+    void finishPendingLoads();
+    
     float getRMSLevel (const int channel);
-    float getSimplePeak (const int channel);
+    float getTruePeak (const int channel);
+    OutputAnalyzer& getOutputAnalyzer() { return outputAnalyzer; }
+    ScopeAnalyzer& getScopeAnalyzer() { return scopeAnalyzer; }
     
     void parameterChanged (const juce::String& parameterID, float newValue) override;
     void valueTreeChildOrderChanged (juce::ValueTree &parentTreeWhoseChildrenHaveMoved, int oldIndex, int newIndex) override;
@@ -59,23 +74,31 @@ public:
     juce::AudioProcessorValueTreeState& getPluginAPVST();
     juce::ValueTree getPluginNonParamTree();
     PresetManager& getPresetManager();
+    TableRebuilder& getTableRebuilder();
     LFOVisualizer& getLFOVisualizer (const int lfoNum);
     
     // TODO Maybe make private and pass to PluginEditor constructor
-    juce::OwnedArray<juce::dsp::LookupTableTransform<float>> oscAmpTables;
-    juce::OwnedArray<juce::dsp::LookupTableTransform<float>> oscPitchTables;
-    juce::OwnedArray<juce::dsp::LookupTableTransform<float>> noiseAmpTables;
-    juce::OwnedArray<juce::dsp::LookupTableTransform<float>> noiseFilterTables;
-    juce::dsp::LookupTableTransform<float> waveshaperControlTable;
-    juce::dsp::LookupTableTransform<float> waveshaperTransformTable;
+    juce::OwnedArray<SwappableTable> oscAmpTables;
+    juce::OwnedArray<SwappableTable> oscPitchTables;
+    juce::OwnedArray<SwappableTable> noiseAmpTables;
+    juce::OwnedArray<SwappableTable> noiseFilterTables;
+    SwappableTable waveshaperControlTable;
+    SwappableTable waveshaperTransformTable;
+    
+    // bumped after every rebuild of the tables above, so the editor only redraws curves that changed
+    std::atomic<uint32_t> envelopeTableVersion { 0 };
+    std::atomic<uint32_t> waveshaperTableVersion { 0 };
     
-    farbot::fifo<juce::MidiMessage, farbot::fifo_options::concurrency::single, farbot::fifo_options::concurrency::single, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty> midiFifo;
+    // notes and controllers from the editor, external control threads or a test harness
+    NoteEventQueue noteEvents;
     
     juce::AudioProcessorGraph::Node::Ptr inputNode, outputNode, delayNode, reverbNode, filterNode, waveshaperNode;
     
 private:
     void connectEffectsGraph();
-    void updateTableWithSlope (juce::dsp::LookupTableTransform<float>* table, const float newSlope);
+    void playNoteEvent (const NoteEvent& event);
+    int addSlopeTable (juce::OwnedArray<SwappableTable>& tables, const juce::String& slopeParameterID);
+    void updateTableWithSlope (SwappableTable* table, const float newSlope);
     
     juce::AudioProcessorValueTreeState apvts;
     juce::ValueTree nonParamStateTree;
@@ -85,6 +108,10 @@ private:
     juce::ReferenceCountedArray<juce::AudioProcessorGraph::Node> effectsOrder;
     juce::ValueTree effectsOrderTree;
     
+    // declared after the graph, so its thread has stopped before the waveshaper it rebuilds for is destroyed
+    TableRebuilder tableRebuilder;
+    std::array<int, 3> oscAmpSlopeJobs, oscPitchSlopeJobs, noiseAmpSlopeJobs, noiseFilterSlopeJobs;
+    
     std::atomic<bool> shouldUpdateEffectsGraph = false;
     
     juce::UndoManager undoManager;
@@ -93,15 +120,15 @@ private:
     const int numOscVoices { 8 };
     
     std::atomic<float> bpm { 120.0f };
-    std::atomic<float> leftRMS { 0.0f }, rightRMS { 0.0f };
-    std::atomic<float> leftPeak { 0.0f }, rightPeak { 0.0f };
+    OutputAnalyzer outputAnalyzer;
+    ScopeAnalyzer scopeAnalyzer;
     
     juce::ValueTree lfoTree;
     LFO lfo1;
     LFO lfo2;
     
     juce::AudioParameterFloat* masterGainParam { nullptr };
-    juce::dsp::Gain<float> masterGain;
+    MasterStage masterStage;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginProcessor);
 };
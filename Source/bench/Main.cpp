@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 22 Oct 2026 10:41:09am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RenderBenchmark.h"
+
+static const char* const usage =
+    "LaunchCodesBenchmark [--out=<file>]\n"
+    "\n"
+    "  --out=<file>        write the report here rather than to stdout\n";
+
+int main (int argc, char* argv[])
+{
+    // components, images and fonts expect JUCE's message manager, even with nothing on screen
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args (argc, argv);
+    
+    return juce::ConsoleApplication::invokeCatchingFailures([&]
+    {
+        if (args.containsOption("--help|-h"))
+        {
+            std::cout << usage;
+            return 0;
+        }
+        
+        // a processor of its own, which no host ever sees, so the drags write no automation into anyone's session
+        PluginProcessor processor;
+        std::unique_ptr<juce::AudioProcessorEditor> editor (processor.createEditorIfNeeded());
+        
+        if (editor == nullptr)
+            juce::ConsoleApplication::fail("Couldn't create the editor");
+        
+        RenderBenchmark benchmark (*editor, processor);
+        const juce::String report = benchmark.run();
+        
+        if (! args.containsOption("--out"))
+        {
+            std::cout << report;
+            return 0;
+        }
+        
+        const juce::File reportFile = args.getFileForOption("--out");
+        
+        if (! reportFile.replaceWithText(report))
+            juce::ConsoleApplication::fail("Couldn't write to " + reportFile.getFullPathName());
+        
+        std::cout << "Render benchmark written to " << reportFile.getFullPathName() << std::endl;
+        return 0;
+    });
+}
@@ -0,0 +1,296 @@
+/*
+  ==============================================================================
+
+    RenderBenchmark.cpp
+    Created: 20 Oct 2026 3:58:12am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "RenderBenchmark.h"
+#include "../ui/ComponentIDs.h"
+#include "../ui/XYControlPad.h"
+#include "../ui/WaveshaperModule.h"
+#include "../service/ParamIDs.h"
+
+RenderBenchmark::RenderBenchmark (juce::Component& t_content, PluginProcessor& t_processor)
+: content(t_content)
+, processor(t_processor)
+, apvts(t_processor.getPluginAPVST())
+, nonParamTree(t_processor.getPluginNonParamTree())
+{
+}
+
+juce::String RenderBenchmark::run()
+{
+    report = "Render benchmark, " + juce::Time::getCurrentTime().toString(true, true) + "\n";
+    report << "times in ms, over " << timedPaints << " paints after " << warmupPaints << " untimed\n";
+    
+    const auto originalBounds = content.getBounds();
+    
+    for (const float sizeFactor : { 1.0f, 0.75f, 1.5f })
+    {
+        const auto bounds = originalBounds.withSize(juce::roundToInt(originalBounds.getWidth() * sizeFactor),
+                                                    juce::roundToInt(originalBounds.getHeight() * sizeFactor));
+        content.setBounds(bounds);
+        
+        for (const float scale : { 1.0f, 1.5f, 2.0f })
+            benchmarkPaints(content.getLocalBounds(), scale);
+    }
+    
+    content.setBounds(originalBounds);
+    
+    benchmarkDrags();
+    
+    return report;
+}
+
+void RenderBenchmark::benchmarkPaints (juce::Rectangle<int> contentBounds, float scale)
+{
+    report << "\n== " << contentBounds.getWidth() << " x " << contentBounds.getHeight() << " at " << scale << "x ==\n";
+    
+    std::vector<double> wholeEditor;
+    
+    for (int i = 0; i < warmupPaints + timedPaints; i++)
+    {
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        renderArea(contentBounds, scale);
+        
+        if (i >= warmupPaints)
+            wholeEditor.push_back(juce::Time::getMillisecondCounterHiRes() - start);
+    }
+    
+    report << formatTimings("whole editor", wholeEditor);
+    
+    juce::Array<juce::Component*> components;
+    collectComponents(content, components);
+    
+    std::vector<std::pair<double, juce::String>> lines;
+    
+    for (auto* component : components)
+    {
+        const auto bounds = component->getLocalBounds();
+        
+        if (bounds.isEmpty())
+            continue;
+        
+        juce::Image image (juce::Image::ARGB,
+                           juce::jmax(1, juce::roundToInt(bounds.getWidth() * scale)),
+                           juce::jmax(1, juce::roundToInt(bounds.getHeight() * scale)),
+                           true);
+        std::vector<double> milliseconds;
+        
+        for (int i = 0; i < warmupPaints + timedPaints; i++)
+        {
+            image.clear(image.getBounds());
+            juce::Graphics g (image);
+            g.addTransform(juce::AffineTransform::scale(scale));
+            
+            // the component's own paint alone; its children get their own line
+            const double start = juce::Time::getMillisecondCounterHiRes();
+            component->paint(g);
+            
+            if (i >= warmupPaints)
+                milliseconds.push_back(juce::Time::getMillisecondCounterHiRes() - start);
+        }
+        
+        std::sort(milliseconds.begin(), milliseconds.end());
+        const double p90 = milliseconds[(size_t) (milliseconds.size() * 9 / 10)];
+        lines.emplace_back(p90, formatTimings(describe(*component), milliseconds));
+    }
+    
+    // most expensive first
+    std::sort(lines.begin(), lines.end(), [] (const auto& a, const auto& b) { return a.first > b.first; });
+    
+    for (const auto& line : lines)
+        report << line.second;
+}
+
+void RenderBenchmark::benchmarkDrags()
+{
+    // the processor is the benchmark's own, so nothing here reaches a host or needs putting back
+    report << "\n== drags, change to rebuilt tables and finished render, " << dragSteps << " steps ==\n";
+    
+    /* ----- REVERB PAD ----- */
+    
+    juce::Component* pad = nullptr;
+    juce::Array<juce::Component*> components;
+    collectComponents(content, components);
+    
+    for (auto* component : components)
+        if (dynamic_cast<XYControlPad*>(component) != nullptr)
+            pad = component;
+    
+    auto* reverbWidth = apvts.getParameter(ParamIDs::reverbWidth);
+    auto* reverbSize = apvts.getParameter(ParamIDs::reverbSize);
+    
+    reverbWidth->beginChangeGesture();
+    reverbSize->beginChangeGesture();
+    
+    benchmarkDrag("reverb pad", pad, [=] (float t)
+    {
+        // a circle round the middle of the pad
+        reverbWidth->setValueNotifyingHost(0.5f + 0.4f * std::cos(t * juce::MathConstants<float>::twoPi));
+        reverbSize->setValueNotifyingHost(0.5f + 0.4f * std::sin(t * juce::MathConstants<float>::twoPi));
+    });
+    
+    reverbWidth->endChangeGesture();
+    reverbSize->endChangeGesture();
+    
+    /* ----- ENVELOPE NODES ----- */
+    
+    auto* attack = apvts.getParameter(ParamIDs::oscAttackAmp);
+    auto* peak = apvts.getParameter(ParamIDs::oscPeakAmp);
+    
+    attack->beginChangeGesture();
+    peak->beginChangeGesture();
+    
+    benchmarkDrag("amp envelope attack node", findComponentWithID(content, ComponentIDs::oscAmpEnv), [=] (float t)
+    {
+        attack->setValueNotifyingHost(0.1f + 0.6f * t);
+        peak->setValueNotifyingHost(1.0f - 0.5f * t);
+    });
+    
+    attack->endChangeGesture();
+    peak->endChangeGesture();
+    
+    /* ----- WAVESHAPER NODE ----- */
+    
+    juce::Component* waveshaper = nullptr;
+    
+    for (auto* component : components)
+        if (dynamic_cast<WaveshaperModule*>(component) != nullptr)
+            waveshaper = component;
+    
+    juce::ValueTree nodeTree = nonParamTree.getChildWithName(ParamIDs::waveshaperNodeTree);
+    juce::ValueTree node;
+    
+    for (auto child : nodeTree)
+        if (child.hasProperty(ParamIDs::nodeX) && child[ParamIDs::nodeEnabled])
+            node = child;
+    
+    if (node.isValid())
+    {
+        const float startX = node[ParamIDs::nodeX], startY = node[ParamIDs::nodeY];
+        
+        // small moves, so the node stays between its neighbours as the editor would keep it
+        benchmarkDrag("waveshaper node", waveshaper, [=] (float t) mutable
+        {
+            node.setProperty(ParamIDs::nodeX, startX + 0.02f * std::sin(t * juce::MathConstants<float>::twoPi), nullptr);
+            node.setProperty(ParamIDs::nodeY, juce::jlimit(-1.0f, 1.0f, startY + 0.2f * std::cos(t * juce::MathConstants<float>::twoPi)), nullptr);
+        });
+    }
+    else
+    {
+        report << "waveshaper node: no enabled node to drag\n";
+    }
+}
+
+void RenderBenchmark::benchmarkDrag (const juce::String& name,
+                                     juce::Component* view,
+                                     const std::function<void (float)>& changeForStep)
+{
+    // nothing is on screen here, so visibility is all there is to go on
+    if (view == nullptr || ! view->isVisible())
+    {
+        report << name << ": not visible, skipped\n";
+        return;
+    }
+    
+    const auto area = content.getLocalArea(view, view->getLocalBounds());
+    std::vector<double> milliseconds;
+    
+    for (int step = 0; step < dragSteps; step++)
+    {
+        // parameter listeners and attachments all run synchronously on the message thread, like a real drag;
+        // the tables they ask for are built on the rebuild thread, and the render after picks them up
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        changeForStep((float) step / (dragSteps - 1));
+        waitForTableRebuilds();
+        renderArea(area, 1.0f);
+        milliseconds.push_back(juce::Time::getMillisecondCounterHiRes() - start);
+    }
+    
+    report << formatTimings(name, milliseconds);
+}
+
+void RenderBenchmark::renderArea (juce::Rectangle<int> area, float scale)
+{
+    // paints everything that overlaps the area, as the peer would for a repaint of it
+    content.createComponentSnapshot(area, true, scale);
+}
+
+void RenderBenchmark::waitForTableRebuilds()
+{
+    auto& rebuilder = processor.getTableRebuilder();
+    const juce::uint32 ticket = rebuilder.getRequestTicket();
+    
+    rebuilder.runSoon();
+    
+    while (! rebuilder.hasFinished(ticket))
+        juce::Thread::yield();
+}
+
+juce::String RenderBenchmark::describe (juce::Component& component) const
+{
+    juce::StringArray names;
+    
+    for (auto* c = &component; c != nullptr && c != &content; c = c->getParentComponent())
+    {
+        if (c->getComponentID().isNotEmpty())
+            names.insert(0, c->getComponentID());
+        else if (c->getName().isNotEmpty())
+            names.insert(0, c->getName());
+        else if (c == &component)
+            names.insert(0, typeid(*c).name());
+    }
+    
+    return names.joinIntoString("/");
+}
+
+juce::Component* RenderBenchmark::findComponentWithID (juce::Component& parent, const juce::String& id) const
+{
+    for (auto* child : parent.getChildren())
+    {
+        if (child->getComponentID() == id)
+            return child;
+        
+        if (auto* found = findComponentWithID(*child, id))
+            return found;
+    }
+    
+    return nullptr;
+}
+
+void RenderBenchmark::collectComponents (juce::Component& parent, juce::Array<juce::Component*>& components)
+{
+    for (auto* child : parent.getChildren())
+    {
+        if (! child->isVisible())
+            continue;
+        
+        components.add(child);
+        collectComponents(*child, components);
+    }
+}
+
+juce::String RenderBenchmark::formatTimings (const juce::String& name, std::vector<double> milliseconds)
+{
+    if (milliseconds.empty())
+        return name + ": no samples\n";
+    
+    std::sort(milliseconds.begin(), milliseconds.end());
+    
+    auto percentile = [&milliseconds] (int percent)
+    {
+        return milliseconds[juce::jmin(milliseconds.size() - 1, milliseconds.size() * (size_t) percent / 100)];
+    };
+    
+    return juce::String::formatted("%-60s p50 %7.3f  p90 %7.3f  p99 %7.3f  max %7.3f\n",
+                                   name.toRawUTF8(),
+                                   percentile(50),
+                                   percentile(90),
+                                   percentile(99),
+                                   milliseconds.back());
+}
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    RenderBenchmark.h
+    Created: 20 Oct 2026 3:58:12am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/*
+    Times the editor's painting offscreen, so it can be held to a budget on
+    machines that rasterise in software. The LaunchCodesBenchmark console
+    tool runs it on an editor that's never put on screen, for a processor
+    of its own that no host sees.
+    
+    For each content size and scale factor it renders every visible
+    component's own paint() into an image over and over, and the whole
+    editor once per pass, and reports percentiles. It then plays drag
+    sequences on the reverb pad, the oscillator amp envelope and a
+    waveshaper node through the same parameters and node properties the
+    mouse handlers write to. Each step is timed from the change, through
+    the table rebuilds it asks for, to the finished render of the view it
+    dirties.
+*/
+class RenderBenchmark
+{
+public:
+    RenderBenchmark (juce::Component& content, PluginProcessor& processor);
+    
+    juce::String run();
+
+private:
+    void benchmarkPaints (juce::Rectangle<int> contentBounds, float scale);
+    void benchmarkDrags();
+    
+    /* times steps of one drag, where changeForStep moves the control to position t in [0, 1] */
+    void benchmarkDrag (const juce::String& name,
+                        juce::Component* view,
+                        const std::function<void (float)>& changeForStep);
+    
+    void renderArea (juce::Rectangle<int> area, float scale);
+    void waitForTableRebuilds();
+    
+    juce::String describe (juce::Component& component) const;
+    juce::Component* findComponentWithID (juce::Component& parent, const juce::String& id) const;
+    
+    static void collectComponents (juce::Component& parent, juce::Array<juce::Component*>& components);
+    static juce::String formatTimings (const juce::String& name, std::vector<double> milliseconds);
+    
+    juce::Component& content;
+    PluginProcessor& processor;
+    juce::AudioProcessorValueTreeState& apvts;
+    juce::ValueTree nonParamTree;
+    
+    juce::String report;
+    
+    static constexpr int warmupPaints { 3 };
+    static constexpr int timedPaints { 20 };
+    static constexpr int dragSteps { 60 };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RenderBenchmark);
+};
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 20 Oct 2026 11:06:52am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineRenderer.h"
+
+static const char* const usage =
+    "LaunchCodesRender --out=<file.wav> (--midi=<file.mid> | --notes=<list>) [options]\n"
+    "\n"
+    "  --out=<file>        WAV file to write\n"
+    "  --midi=<file>       standard MIDI file to play\n"
+    "  --notes=<list>      note@start:length[/velocity], ... in seconds, velocity 0 to 1\n"
+    "  --state=<file>      .preset file, or a state blob saved by a host\n"
+    "  --rate=<hz>         sample rate, 48000 by default\n"
+    "  --block=<samples>   block size, 512 by default\n"
+    "  --bits=<16|24|32>   bit depth, 24 by default\n"
+    "  --tail=<seconds>    time rendered after the last event, 2 by default\n"
+    "  --bpm=<bpm>         tempo for synced effects, if the MIDI file has none; 120 by default\n"
+    "  --patch-quality     keep the patch's antialiasing, as a host bounce would, rather than the highest\n";
+
+int main (int argc, char* argv[])
+{
+    // the processor's trees, timers and analyzers expect JUCE's message manager, even with no editor
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args (argc, argv);
+    
+    return juce::ConsoleApplication::invokeCatchingFailures([&]
+    {
+        if (args.containsOption("--help|-h") || ! args.containsOption("--out"))
+        {
+            std::cout << usage;
+            return args.containsOption("--help|-h") ? 0 : 1;
+        }
+        
+        auto check = [] (const juce::Result& result)
+        {
+            if (result.failed())
+                juce::ConsoleApplication::fail(result.getErrorMessage());
+        };
+        
+        // anything not given keeps its default
+        auto getNumber = [&] (const juce::String& option, double fallback)
+        {
+            return args.containsOption(option) ? args.getValueForOption(option).getDoubleValue() : fallback;
+        };
+        
+        OfflineRenderer::Settings settings;
+        settings.sampleRate = getNumber("--rate", settings.sampleRate);
+        settings.blockSize = (int) getNumber("--block", settings.blockSize);
+        settings.bitDepth = (int) getNumber("--bits", settings.bitDepth);
+        settings.tailSeconds = getNumber("--tail", settings.tailSeconds);
+        settings.bpm = getNumber("--bpm", settings.bpm);
+        settings.highestQuality = ! args.containsOption("--patch-quality");
+        
+        juce::MidiMessageSequence sequence;
+        
+        if (args.containsOption("--midi"))
+            check(OfflineRenderer::readMidiFile(args.getExistingFileForOption("--midi"), sequence, settings.bpm));
+        else if (args.containsOption("--notes"))
+            check(OfflineRenderer::parseNoteList(args.getValueForOption("--notes"), sequence));
+        else
+            juce::ConsoleApplication::fail("Nothing to play: give --midi or --notes");
+        
+        OfflineRenderer renderer;
+        
+        if (args.containsOption("--state"))
+            check(renderer.loadState(args.getExistingFileForOption("--state")));
+        
+        const juce::File outputFile = args.getFileForOption("--out");
+        check(renderer.render(sequence, outputFile, settings));
+        
+        std::cout << "Rendered " << juce::String(renderer.getRenderedSeconds(), 2) << " s to " << outputFile.getFullPathName()
+                  << " in " << juce::String(renderer.getProcessingSeconds(), 2) << " s ("
+                  << juce::String(renderer.getRealtimeFactor(), 1) << "x realtime)" << std::endl;
+        
+        return 0;
+    });
+}
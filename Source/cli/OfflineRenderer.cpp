@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 20 Oct 2026 11:06:52am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+juce::Result OfflineRenderer::loadState (const juce::File& stateFile)
+{
+    if (! stateFile.existsAsFile())
+        return juce::Result::fail("Couldn't find state file: " + stateFile.getFullPathName());
+    
+    if (stateFile.hasFileExtension(PresetManager::extension))
+    {
+        std::unique_ptr<juce::XmlElement> xml = juce::parseXML(stateFile);
+        
+        if (xml == nullptr)
+            return juce::Result::fail("Couldn't read preset: " + stateFile.getFullPathName());
+        
+        processor.getPresetManager().loadStateFromXml(std::move(xml));
+    }
+    else
+    {
+        juce::MemoryBlock data;
+        
+        if (! stateFile.loadFileAsData(data) || data.isEmpty())
+            return juce::Result::fail("Couldn't read state: " + stateFile.getFullPathName());
+        
+        processor.setStateInformation(data.getData(), (int) data.getSize());
+    }
+    
+    return juce::Result::ok();
+}
+
+juce::Result OfflineRenderer::render (const juce::MidiMessageSequence& sequence, const juce::File& outputFile, const Settings& settings)
+{
+    if (settings.sampleRate <= 0.0 || settings.blockSize <= 0)
+        return juce::Result::fail("The sample rate and block size must be positive");
+    
+    if (settings.bitDepth != 16 && settings.bitDepth != 24 && settings.bitDepth != 32)
+        return juce::Result::fail("The bit depth must be 16, 24 or 32");
+    
+    /* ----- OUTPUT FILE ----- */
+    
+    outputFile.deleteFile();
+    auto outputStream = std::make_unique<juce::FileOutputStream>(outputFile);
+    
+    if (! outputStream->openedOk())
+        return juce::Result::fail("Couldn't open " + outputFile.getFullPathName() + " for writing");
+    
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor(outputStream.get(), settings.sampleRate, 2,
+                                                                              settings.bitDepth, {}, 0));
+    
+    if (writer == nullptr)
+        return juce::Result::fail("Couldn't write a WAV file at " + juce::String(settings.sampleRate) + " Hz");
+    
+    // the writer owns the stream now
+    outputStream.release();
+    
+    /* ----- PROCESSOR ----- */
+    
+    playHead.bpm = settings.bpm;
+    playHead.sampleRate = settings.sampleRate;
+    playHead.position = 0;
+    
+    processor.setNonRealtime(true);
+    processor.setHighestQuality(settings.highestQuality);
+    processor.setPlayHead(&playHead);
+    processor.setPlayConfigDetails(0, 2, settings.sampleRate, settings.blockSize);
+    processor.prepareToPlay(settings.sampleRate, settings.blockSize);
+    
+    // there's no editor to wait for, so whatever the state load asked the background threads for has to land now,
+    // or the same render could pick up an impulse or a table a few blocks in one run and not the next
+    processor.finishPendingLoads();
+    
+    /* ----- RENDER ----- */
+    
+    const juce::int64 totalSamples = (juce::int64) std::ceil((sequence.getEndTime() + settings.tailSeconds) * settings.sampleRate);
+    
+    juce::AudioBuffer<float> buffer (2, settings.blockSize);
+    juce::MidiBuffer midi;
+    int nextEvent = 0;
+    double processingMs = 0.0;
+    
+    for (juce::int64 position = 0; position < totalSamples; position += settings.blockSize)
+    {
+        const int numSamples = (int) juce::jmin((juce::int64) settings.blockSize, totalSamples - position);
+        buffer.setSize(2, numSamples, false, false, true);
+        midi.clear();
+        
+        for (; nextEvent < sequence.getNumEvents(); nextEvent++)
+        {
+            const juce::MidiMessage& message = sequence.getEventPointer(nextEvent)->message;
+            const auto eventPosition = (juce::int64) std::llround(message.getTimeStamp() * settings.sampleRate);
+            
+            if (eventPosition >= position + numSamples)
+                break;
+            
+            if (! message.isMetaEvent())
+                midi.addEvent(message, (int) juce::jmax((juce::int64) 0, eventPosition - position));
+        }
+        
+        playHead.position = position;
+        
+        const double blockStart = juce::Time::getMillisecondCounterHiRes();
+        processor.processBlock(buffer, midi);
+        processingMs += juce::Time::getMillisecondCounterHiRes() - blockStart;
+        
+        if (! writer->writeFromAudioSampleBuffer(buffer, 0, numSamples))
+        {
+            processor.releaseResources();
+            return juce::Result::fail("Couldn't write to " + outputFile.getFullPathName());
+        }
+    }
+    
+    processor.releaseResources();
+    processor.setPlayHead(nullptr);
+    
+    renderedSeconds = (double) totalSamples / settings.sampleRate;
+    processingSeconds = processingMs / 1000.0;
+    
+    return juce::Result::ok();
+}
+
+juce::Result OfflineRenderer::readMidiFile (const juce::File& midiFile, juce::MidiMessageSequence& sequence, double& bpm)
+{
+    juce::FileInputStream stream (midiFile);
+    
+    if (! stream.openedOk())
+        return juce::Result::fail("Couldn't open MIDI file: " + midiFile.getFullPathName());
+    
+    juce::MidiFile file;
+    
+    if (! file.readFrom(stream))
+        return juce::Result::fail("Not a standard MIDI file: " + midiFile.getFullPathName());
+    
+    file.convertTimestampTicksToSeconds();
+    
+    for (int track = 0; track < file.getNumTracks(); track++)
+        sequence.addSequence(*file.getTrack(track), 0.0);
+    
+    sequence.updateMatchedPairs();
+    
+    juce::MidiMessageSequence tempoEvents;
+    file.findAllTempoEvents(tempoEvents);
+    
+    if (tempoEvents.getNumEvents() > 0)
+        bpm = 60.0 / tempoEvents.getEventPointer(0)->message.getTempoSecondsPerQuarterNote();
+    
+    return juce::Result::ok();
+}
+
+juce::Result OfflineRenderer::parseNoteList (const juce::String& noteList, juce::MidiMessageSequence& sequence)
+{
+    for (const auto& token : juce::StringArray::fromTokens(noteList, ", ", {}))
+    {
+        if (token.isEmpty())
+            continue;
+        
+        if (! token.containsChar('@') || ! token.containsChar(':'))
+            return juce::Result::fail("Notes look like note@start:length[/velocity], not " + token);
+        
+        const int note = token.upToFirstOccurrenceOf("@", false, false).getIntValue();
+        const juce::String timing = token.fromFirstOccurrenceOf("@", false, false);
+        const double start = timing.upToFirstOccurrenceOf(":", false, false).getDoubleValue();
+        const double length = timing.fromFirstOccurrenceOf(":", false, false).upToFirstOccurrenceOf("/", false, false).getDoubleValue();
+        const float velocity = timing.containsChar('/') ? timing.fromFirstOccurrenceOf("/", false, false).getFloatValue() : 1.0f;
+        
+        if (! juce::isPositiveAndBelow(note, 128) || start < 0.0 || length <= 0.0 || velocity < 0.0f || velocity > 1.0f)
+            return juce::Result::fail("Note out of range: " + token);
+        
+        sequence.addEvent(juce::MidiMessage::noteOn(1, note, velocity).withTimeStamp(start));
+        sequence.addEvent(juce::MidiMessage::noteOff(1, note).withTimeStamp(start + length));
+    }
+    
+    sequence.updateMatchedPairs();
+    return juce::Result::ok();
+}
+
+juce::Optional<juce::AudioPlayHead::PositionInfo> OfflineRenderer::OfflinePlayHead::getPosition() const
+{
+    PositionInfo info;
+    info.setBpm(bpm);
+    info.setTimeInSamples(position);
+    info.setTimeInSeconds((double) position / sampleRate);
+    info.setIsPlaying(true);
+    return info;
+}
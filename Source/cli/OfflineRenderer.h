@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 20 Oct 2026 11:06:52am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../PluginProcessor.h"
+
+/*
+    Drives a PluginProcessor with no editor and no device, as fast as it
+    will go, for the LaunchCodesRender command line tool.
+    
+    The processor is put in non-realtime mode before it's prepared, and
+    unless the settings ask for the patch's own quality, the waveshaper
+    uses its most accurate antialiasing whatever the patch says. State is
+    loaded from a .preset file, or from a blob as saved by a host. Notes
+    come from a standard MIDI file, or from a note list of the form
+        note@start:length[/velocity], ...
+    with times in seconds and velocity from 0 to 1.
+    
+    Errors come back as a failed juce::Result, for the caller to report.
+*/
+class OfflineRenderer
+{
+public:
+    struct Settings
+    {
+        double sampleRate { 48000.0 };
+        int blockSize { 512 };
+        int bitDepth { 24 };
+        double tailSeconds { 2.0 };
+        double bpm { 120.0 };
+        bool highestQuality { true };
+    };
+    
+    OfflineRenderer() = default;
+    
+    juce::Result loadState (const juce::File& stateFile);
+    juce::Result render (const juce::MidiMessageSequence& sequence, const juce::File& outputFile, const Settings& settings);
+    
+    double getRenderedSeconds() const noexcept { return renderedSeconds; }
+    double getProcessingSeconds() const noexcept { return processingSeconds; }
+    double getRealtimeFactor() const noexcept { return processingSeconds > 0.0 ? renderedSeconds / processingSeconds : 0.0; }
+    
+    /* merges every track, with timestamps in seconds; bpm is set from the file's first tempo, if it has one */
+    static juce::Result readMidiFile (const juce::File& midiFile, juce::MidiMessageSequence& sequence, double& bpm);
+    static juce::Result parseNoteList (const juce::String& noteList, juce::MidiMessageSequence& sequence);
+
+private:
+    /* a transport that is always playing, at whatever sample the render has reached */
+    class OfflinePlayHead  : public juce::AudioPlayHead
+    {
+    public:
+        juce::Optional<PositionInfo> getPosition() const override;
+        
+        double bpm { 120.0 };
+        double sampleRate { 48000.0 };
+        juce::int64 position { 0 };
+    };
+    
+    PluginProcessor processor;
+    OfflinePlayHead playHead;
+    
+    double renderedSeconds { 0.0 };
+    double processingSeconds { 0.0 };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer);
+};
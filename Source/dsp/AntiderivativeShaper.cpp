@@ -0,0 +1,318 @@
+/*
+  ==============================================================================
+
+    AntiderivativeShaper.cpp
+    Created: 19 Oct 2026 6:48:15pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "AntiderivativeShaper.h"
+
+namespace
+{
+    using DoubleVector = juce::dsp::SIMDRegister<double>;
+
+    constexpr int numLanes { (int) DoubleVector::SIMDNumElements };
+
+    // closer inputs than this lose too many digits to divide by
+    constexpr double illConditionedThreshold { 1.0e-4 };
+
+    inline int roundUpToLanes (int numValues) noexcept
+    {
+        return (numValues + numLanes - 1) / numLanes * numLanes;
+    }
+
+    // SIMDRegister has no division, so SSE gets its own and anything else goes lane by lane
+    inline DoubleVector divide (DoubleVector numerator, DoubleVector denominator) noexcept
+    {
+        DoubleVector quotient;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        quotient.value = _mm_div_pd(numerator.value, denominator.value);
+       #else
+        for (size_t lane = 0; lane < DoubleVector::SIMDNumElements; lane++)
+            quotient.set(lane, numerator.get(lane) / denominator.get(lane));
+       #endif
+
+        return quotient;
+    }
+
+    inline DoubleVector select (DoubleVector::vMaskType mask, DoubleVector ifSet, DoubleVector ifClear) noexcept
+    {
+        return (ifSet & mask) + (ifClear & ~mask);
+    }
+
+    inline DoubleVector::vMaskType isIllConditioned (DoubleVector difference) noexcept
+    {
+        return DoubleVector::lessThan(DoubleVector::abs(difference), DoubleVector::expand(illConditionedThreshold));
+    }
+
+    // the ill-conditioned lanes divide by one instead, and their result is masked out afterwards
+    inline DoubleVector divideGuarded (DoubleVector numerator, DoubleVector denominator, DoubleVector::vMaskType illConditioned) noexcept
+    {
+        return divide(numerator, select(illConditioned, DoubleVector::expand(1.0), denominator));
+    }
+
+    inline DoubleVector load (const double* values) noexcept
+    {
+        alignas (DoubleVector::SIMDRegisterSize) double lanes[numLanes];
+        std::copy(values, values + numLanes, lanes);
+        return DoubleVector::fromRawArray(lanes);
+    }
+
+    inline void store (DoubleVector vector, double* values) noexcept
+    {
+        alignas (DoubleVector::SIMDRegisterSize) double lanes[numLanes];
+        vector.copyToRawArray(lanes);
+        std::copy(lanes, lanes + numLanes, values);
+    }
+
+    inline void store (DoubleVector vector, float* samples, int numSamples) noexcept
+    {
+        alignas (DoubleVector::SIMDRegisterSize) double lanes[numLanes];
+        vector.copyToRawArray(lanes);
+
+        for (int lane = 0; lane < juce::jmin(numSamples, numLanes); lane++)
+            samples[lane] = (float) lanes[lane];
+    }
+}
+
+void AntiderivativeShaper::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    jassert (spec.numChannels <= channelStates.size());
+
+    const size_t rowSize = (size_t) (roundUpToLanes((int) spec.maximumBlockSize + 2) + numLanes);
+
+    inputs.resize(rowSize);
+    integrals.resize(rowSize);
+    quotients.resize(rowSize);
+
+    reset();
+}
+
+void AntiderivativeShaper::reset()
+{
+    channelStates.fill({});
+}
+
+void AntiderivativeShaper::initialise (const std::function<float (float)>& curve, int newNumPoints)
+{
+    jassert (newNumPoints > 2 && newNumPoints <= maxPoints);
+
+    // built aside, since a block that met half old and half new integrals would divide their mismatch by a tiny dx
+    Tables t;
+
+    t.numPoints = juce::jlimit(3, maxPoints, newNumPoints);
+    t.gridSpacing = 2.0 / (t.numPoints - 1);
+    t.inverseGridSpacing = (t.numPoints - 1) * 0.5;
+
+    for (int i = 0; i < t.numPoints; i++)
+        t.values[(size_t) i] = curve(juce::jmap((float) i, 0.0f, (float) (t.numPoints - 1), -1.0f, 1.0f));
+
+    // trapezoids are exact for a piecewise linear curve
+    t.firstIntegrals[0] = 0.0;
+
+    for (int i = 0; i < t.numPoints - 1; i++)
+        t.firstIntegrals[(size_t) i + 1] = t.firstIntegrals[(size_t) i] + t.gridSpacing * 0.5 * (t.values[(size_t) i] + t.values[(size_t) i + 1]);
+
+    // anchoring both integrals at zero keeps their magnitudes, and so the cancellation, small
+    const double firstOffset = t.evaluateFirstIntegral(t.find(DoubleVector::expand(0.0))).get(0);
+
+    for (int i = 0; i < t.numPoints; i++)
+        t.firstIntegrals[(size_t) i] -= firstOffset;
+
+    t.secondIntegrals[0] = 0.0;
+
+    for (int i = 0; i < t.numPoints - 1; i++)
+    {
+        const double difference = t.values[(size_t) i + 1] - t.values[(size_t) i];
+        t.secondIntegrals[(size_t) i + 1] = t.secondIntegrals[(size_t) i]
+                                          + t.firstIntegrals[(size_t) i] * t.gridSpacing
+                                          + t.gridSpacing * t.gridSpacing * (t.values[(size_t) i] * 0.5 + difference / 6.0);
+    }
+
+    const double secondOffset = t.evaluateSecondIntegral(t.find(DoubleVector::expand(0.0))).get(0);
+
+    for (int i = 0; i < t.numPoints; i++)
+        t.secondIntegrals[(size_t) i] -= secondOffset;
+
+    tables.nonRealtimeReplace(t);
+}
+
+void AntiderivativeShaper::processFirstOrder (float* const* channels, int numChannels, int numSamples) noexcept
+{
+    jassert (numChannels <= (int) channelStates.size());
+
+    TablesObject::ScopedAccess<farbot::ThreadType::realtime> snapshot (tables);
+
+    for (int channel = 0; channel < numChannels; channel++)
+        processFirstOrder(*snapshot, channels[channel], channelStates[(size_t) channel], numSamples);
+}
+
+void AntiderivativeShaper::processSecondOrder (float* const* channels, int numChannels, int numSamples) noexcept
+{
+    jassert (numChannels <= (int) channelStates.size());
+
+    TablesObject::ScopedAccess<farbot::ThreadType::realtime> snapshot (tables);
+
+    for (int channel = 0; channel < numChannels; channel++)
+        processSecondOrder(*snapshot, channels[channel], channelStates[(size_t) channel], numSamples);
+}
+
+void AntiderivativeShaper::processFirstOrder (const Tables& t, float* samples, ChannelState& state, int numSamples) noexcept
+{
+    const int rowSize = roundUpToLanes(numSamples + 1) + numLanes;
+    jassert (rowSize <= (int) inputs.size());
+
+    double* x = inputs.data();
+    double* integral = integrals.data();
+
+    x[0] = state.x1;
+
+    for (int i = 0; i < numSamples; i++)
+        x[i + 1] = samples[i];
+
+    // the lanes past the block repeat the last input, so they compute something finite and are never stored
+    std::fill(x + numSamples + 1, x + rowSize, x[numSamples]);
+
+    for (int i = 0; i < numSamples + 1; i += numLanes)
+        store(t.evaluateFirstIntegral(t.find(load(x + i))), integral + i);
+
+    for (int i = 0; i < numSamples; i += numLanes)
+    {
+        const DoubleVector x0 = load(x + i);
+        const DoubleVector x1 = load(x + i + 1);
+        const DoubleVector difference = x1 - x0;
+        const auto illConditioned = isIllConditioned(difference);
+
+        const DoubleVector quotient = divideGuarded(load(integral + i + 1) - load(integral + i), difference, illConditioned);
+        const DoubleVector fallback = t.evaluate(t.find((x0 + x1) * 0.5));
+
+        store(select(illConditioned, fallback, quotient), samples + i, numSamples - i);
+    }
+
+    state.x1 = x[numSamples];
+}
+
+void AntiderivativeShaper::processSecondOrder (const Tables& t, float* samples, ChannelState& state, int numSamples) noexcept
+{
+    const int rowSize = roundUpToLanes(numSamples + 2) + numLanes;
+    jassert (rowSize <= (int) inputs.size());
+
+    double* x = inputs.data();
+    double* integral = integrals.data();
+    double* quotient = quotients.data();
+
+    x[0] = state.x2;
+    x[1] = state.x1;
+
+    for (int i = 0; i < numSamples; i++)
+        x[i + 2] = samples[i];
+
+    std::fill(x + numSamples + 2, x + rowSize, x[numSamples + 1]);
+
+    for (int i = 0; i < numSamples + 2; i += numLanes)
+        store(t.evaluateSecondIntegral(t.find(load(x + i))), integral + i);
+
+    // quotient[i] is the mean of the first antiderivative over [x[i], x[i + 1]]
+    for (int i = 0; i < numSamples + 1; i += numLanes)
+    {
+        const DoubleVector x0 = load(x + i);
+        const DoubleVector x1 = load(x + i + 1);
+        const DoubleVector difference = x1 - x0;
+        const auto illConditioned = isIllConditioned(difference);
+
+        const DoubleVector mean = divideGuarded(load(integral + i + 1) - load(integral + i), difference, illConditioned);
+        const DoubleVector fallback = t.evaluateFirstIntegral(t.find((x0 + x1) * 0.5));
+
+        store(select(illConditioned, fallback, mean), quotient + i);
+    }
+
+    for (int i = 0; i < numSamples; i += numLanes)
+    {
+        const DoubleVector x0 = load(x + i);
+        const DoubleVector span = load(x + i + 2) - x0;
+        const auto illConditioned = isIllConditioned(span);
+
+        const DoubleVector output = divideGuarded((load(quotient + i + 1) - load(quotient + i)) * 2.0, span, illConditioned);
+        const DoubleVector fallback = t.evaluateSecondOrderFallback(load(x + i + 2), load(x + i + 1), x0);
+
+        store(select(illConditioned, fallback, output), samples + i, numSamples - i);
+    }
+
+    state.x2 = x[numSamples];
+    state.x1 = x[numSamples + 1];
+}
+
+AntiderivativeShaper::DoubleVector AntiderivativeShaper::Tables::evaluateSecondOrderFallback (DoubleVector x0, DoubleVector x1, DoubleVector x2) const noexcept
+{
+    // x0 and x2 nearly coincide, so expand around their midpoint instead
+    const DoubleVector midpoint = (x0 + x2) * 0.5;
+    const DoubleVector delta = midpoint - x1;
+    const auto illConditioned = isIllConditioned(delta);
+
+    const Segments atMidpoint = find(midpoint);
+
+    // 2 / delta * (F1 (midpoint) + (F2 (x1) - F2 (midpoint)) / delta), over a single division
+    const DoubleVector numerator = (evaluateFirstIntegral(atMidpoint) * delta
+                                    + evaluateSecondIntegral(find(x1)) - evaluateSecondIntegral(atMidpoint)) * 2.0;
+    const DoubleVector expanded = divideGuarded(numerator, delta * delta, illConditioned);
+
+    return select(illConditioned, evaluate(find((midpoint + x1) * 0.5)), expanded);
+}
+
+AntiderivativeShaper::Segments AntiderivativeShaper::Tables::find (DoubleVector x) const noexcept
+{
+    alignas (DoubleVector::SIMDRegisterSize) double positions[numLanes];
+    alignas (DoubleVector::SIMDRegisterSize) double fractions[numLanes], laneValues[numLanes], differences[numLanes];
+    alignas (DoubleVector::SIMDRegisterSize) double laneFirstIntegrals[numLanes], laneSecondIntegrals[numLanes];
+
+    // beyond the grid the curve holds its end value, so those inputs use the end segment and extend it linearly
+    const DoubleVector clamped = DoubleVector::min(DoubleVector::max(x, DoubleVector::expand(-1.0)), DoubleVector::expand(1.0));
+
+    ((clamped + 1.0) * inverseGridSpacing).copyToRawArray(positions);
+
+    for (int lane = 0; lane < numLanes; lane++)
+    {
+        const int index = juce::jmin((int) positions[lane], numPoints - 2);
+
+        fractions[lane] = positions[lane] - index;
+        laneValues[lane] = values[(size_t) index];
+        differences[lane] = values[(size_t) index + 1] - values[(size_t) index];
+        laneFirstIntegrals[lane] = firstIntegrals[(size_t) index];
+        laneSecondIntegrals[lane] = secondIntegrals[(size_t) index];
+    }
+
+    Segments s;
+    s.fraction = DoubleVector::fromRawArray(fractions);
+    s.beyondGrid = x - clamped;
+    s.value = DoubleVector::fromRawArray(laneValues);
+    s.difference = DoubleVector::fromRawArray(differences);
+    s.firstIntegral = DoubleVector::fromRawArray(laneFirstIntegrals);
+    s.secondIntegral = DoubleVector::fromRawArray(laneSecondIntegrals);
+    return s;
+}
+
+AntiderivativeShaper::DoubleVector AntiderivativeShaper::Tables::evaluate (const Segments& s) const noexcept
+{
+    return s.value + s.difference * s.fraction;
+}
+
+AntiderivativeShaper::DoubleVector AntiderivativeShaper::Tables::evaluateFirstIntegral (const Segments& s) const noexcept
+{
+    const DoubleVector onGrid = s.firstIntegral + s.fraction * gridSpacing * (s.value + s.difference * s.fraction * 0.5);
+
+    return onGrid + evaluate(s) * s.beyondGrid;
+}
+
+AntiderivativeShaper::DoubleVector AntiderivativeShaper::Tables::evaluateSecondIntegral (const Segments& s) const noexcept
+{
+    const DoubleVector offset = s.fraction * gridSpacing;
+    const DoubleVector onGrid = s.secondIntegral
+                              + s.firstIntegral * offset
+                              + offset * offset * (s.value * 0.5 + s.difference * s.fraction * (1.0 / 6.0));
+
+    return onGrid + (evaluateFirstIntegral(s) - evaluate(s) * s.beyondGrid * 0.5) * s.beyondGrid;
+}
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    AntiderivativeShaper.h
+    Created: 19 Oct 2026 6:48:15pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../service/farbot/RealtimeObject.hpp"
+
+/*
+    Antiderivative anti-aliasing for a transfer curve sampled on an even grid
+    over [-1, 1], the same grid juce::dsp::LookupTableTransform uses. Between
+    grid points the curve is linear, so its first and second antiderivatives
+    are exact piecewise quadratics and cubics, tabulated here as the values
+    at each grid point. Inputs beyond the grid hold the end values, as the
+    lookup table does.
+
+    First order replaces f(x[n]) with the mean of f over [x[n-1], x[n]] and
+    delays the signal by half a sample; second order uses the second
+    antiderivative and delays by one sample. Antiderivatives are kept in
+    double since the difference quotients cancel most of their digits.
+
+    Each block is evaluated in SIMDRegister<double> lanes of consecutive
+    samples: antiderivatives for every input, then the difference quotients.
+    Only the table lookups go lane by lane. Where neighbouring inputs are too
+    close to divide by, the fallback is computed for every lane and picked
+    with a mask, so there's no branch per sample. Inputs beyond the grid fold
+    into the same path, as the grid's end segment plus a linear extension.
+
+    initialise() builds the tables into a fresh copy and publishes it whole,
+    the way WaveshaperProcessor publishes its curve; each process call holds
+    one snapshot for every channel in the block.
+*/
+class AntiderivativeShaper
+{
+public:
+    AntiderivativeShaper() = default;
+
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    /* samples the curve at numPoints grid positions; any non-realtime thread, one at a time */
+    void initialise (const std::function<float (float)>& curve, int numPoints);
+
+    // eight times the editor's table; only short, steep segments still bend noticeably between grid points
+    static constexpr int maxPoints { 1025 };
+
+    void processFirstOrder (float* const* channels, int numChannels, int numSamples) noexcept;
+    void processSecondOrder (float* const* channels, int numChannels, int numSamples) noexcept;
+
+    static constexpr float getLatencyInSamples (int order) noexcept { return order * 0.5f; }
+
+private:
+    using DoubleVector = juce::dsp::SIMDRegister<double>;
+
+    // only the inputs are kept, so a rebuilt curve never meets stale integrals
+    struct ChannelState
+    {
+        double x1 { 0.0 }, x2 { 0.0 };
+    };
+
+    // where each lane's input sits on the grid, so the curve and both antiderivatives share one lookup
+    struct Segments
+    {
+        DoubleVector fraction, beyondGrid;
+        DoubleVector value, difference, firstIntegral, secondIntegral;
+    };
+
+    struct Tables
+    {
+        Segments find (DoubleVector x) const noexcept;
+
+        DoubleVector evaluate (const Segments& s) const noexcept;
+        DoubleVector evaluateFirstIntegral (const Segments& s) const noexcept;
+        DoubleVector evaluateSecondIntegral (const Segments& s) const noexcept;
+        DoubleVector evaluateSecondOrderFallback (DoubleVector x0, DoubleVector x1, DoubleVector x2) const noexcept;
+
+        int numPoints { 0 };
+        double gridSpacing { 0.0 }, inverseGridSpacing { 0.0 };
+
+        std::array<double, maxPoints> values {};
+        std::array<double, maxPoints> firstIntegrals {};
+        std::array<double, maxPoints> secondIntegrals {};
+    };
+
+    using TablesObject = farbot::RealtimeObject<Tables, farbot::RealtimeObjectOptions::nonRealtimeMutatable>;
+
+    void processFirstOrder (const Tables& t, float* samples, ChannelState& state, int numSamples) noexcept;
+    void processSecondOrder (const Tables& t, float* samples, ChannelState& state, int numSamples) noexcept;
+
+    TablesObject tables;
+    std::array<ChannelState, 2> channelStates;
+
+    // history slots ahead of each block, then room for the last group of lanes to run past its end
+    std::vector<double> inputs, integrals, quotients;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AntiderivativeShaper);
+};
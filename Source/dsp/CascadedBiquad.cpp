@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    CascadedBiquad.cpp
+    Created: 19 Oct 2026 5:21:38pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "CascadedBiquad.h"
+
+CascadedBiquad::CascadedBiquad()
+{
+    for (int stage = 0; stage < maxStages; stage++)
+        clearStage(stage);
+}
+
+void CascadedBiquad::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    jassert (spec.numChannels <= 2);
+    reset();
+}
+
+void CascadedBiquad::reset()
+{
+    state1.fill(0.0f);
+    state2.fill(0.0f);
+    outputs.fill(0.0f);
+}
+
+void CascadedBiquad::setNumStages (int newNumStages)
+{
+    newNumStages = juce::jlimit(1, maxStages, newNumStages);
+
+    for (int stage = newNumStages; stage < numStages; stage++)
+        clearStage(stage);
+
+    numStages = newNumStages;
+}
+
+void CascadedBiquad::setStageCoefficients (int stage, const std::array<float, 6>& coefficients) noexcept
+{
+    jassert (juce::isPositiveAndBelow(stage, numStages));
+
+    const float a0Reciprocal = 1.0f / coefficients[3];
+
+    for (int lane = stage * 2; lane < stage * 2 + 2; lane++)
+    {
+        b0[(size_t) lane] = coefficients[0] * a0Reciprocal;
+        b1[(size_t) lane] = coefficients[1] * a0Reciprocal;
+        b2[(size_t) lane] = coefficients[2] * a0Reciprocal;
+        a1[(size_t) lane] = coefficients[4] * a0Reciprocal;
+        a2[(size_t) lane] = coefficients[5] * a0Reciprocal;
+    }
+}
+
+void CascadedBiquad::clearStage (int stage) noexcept
+{
+    for (int lane = stage * 2; lane < stage * 2 + 2; lane++)
+    {
+        b0[(size_t) lane] = 1.0f;
+        b1[(size_t) lane] = b2[(size_t) lane] = a1[(size_t) lane] = a2[(size_t) lane] = 0.0f;
+        state1[(size_t) lane] = state2[(size_t) lane] = 0.0f;
+    }
+}
+
+void CascadedBiquad::process (const juce::dsp::ProcessContextReplacing<float>& context) noexcept
+{
+    static_assert (maxStages == 4, "add a case for every stage count");
+
+    // the stage count picks a fixed lane count, so each step stays one straight run the compiler can vectorise
+    switch (numStages)
+    {
+        case 1:  processStages<1>(context); break;
+        case 2:  processStages<2>(context); break;
+        case 3:  processStages<3>(context); break;
+        default: processStages<4>(context); break;
+    }
+}
+
+template <int activeStages>
+void CascadedBiquad::processStages (const juce::dsp::ProcessContextReplacing<float>& context) noexcept
+{
+    auto& block = context.getOutputBlock();
+    const int numSamples = (int) block.getNumSamples();
+    const bool isStereo = block.getNumChannels() > 1;
+
+    float* left = block.getChannelPointer(0);
+    float* right = isStereo ? block.getChannelPointer(1) : nullptr;
+
+    // the last stage finishes sample t on step t + activeStages - 1
+    const int lastStep = numSamples + activeStages - 1;
+    const int outputLane = (activeStages - 1) * 2;
+    float input[2] {};
+
+    auto runStep = [&] (auto isFillingOrDraining, int time)
+    {
+        if (time < numSamples)
+        {
+            input[0] = left[time];
+            input[1] = isStereo ? right[time] : left[time];
+        }
+
+        step<activeStages, decltype (isFillingOrDraining)::value>(input, time, numSamples);
+
+        const int finished = time - activeStages + 1;
+
+        if (finished >= 0)
+        {
+            left[finished] = outputs[(size_t) outputLane];
+
+            if (isStereo)
+                right[finished] = outputs[(size_t) outputLane + 1];
+        }
+    };
+
+    const int steadyStart = juce::jmin(activeStages - 1, lastStep);
+    const int steadyEnd = juce::jmax(steadyStart, numSamples);
+
+    for (int time = 0; time < steadyStart; time++)
+        runStep(std::true_type {}, time);
+
+    for (int time = steadyStart; time < steadyEnd; time++)
+        runStep(std::false_type {}, time);
+
+    for (int time = steadyEnd; time < lastStep; time++)
+        runStep(std::true_type {}, time);
+}
+
+template <int activeStages, bool isFillingOrDraining>
+void CascadedBiquad::step (const float* input, int time, int numSamples) noexcept
+{
+    constexpr int activeLanes = activeStages * 2;
+    alignas (32) float x[activeLanes];
+
+    // each stage takes what the stage before it produced on the previous step
+    x[0] = input[0];
+    x[1] = input[1];
+
+    for (int lane = 2; lane < activeLanes; lane++)
+        x[lane] = outputs[(size_t) lane - 2];
+
+    if (! isFillingOrDraining)
+    {
+        for (int lane = 0; lane < activeLanes; lane++)
+        {
+            const float y = b0[(size_t) lane] * x[lane] + state1[(size_t) lane];
+            state1[(size_t) lane] = b1[(size_t) lane] * x[lane] - a1[(size_t) lane] * y + state2[(size_t) lane];
+            state2[(size_t) lane] = b2[(size_t) lane] * x[lane] - a2[(size_t) lane] * y;
+            outputs[(size_t) lane] = y;
+        }
+
+        return;
+    }
+
+    // while filling or draining, stages with no sample to work on must keep their state
+    for (int lane = 0; lane < activeLanes; lane++)
+    {
+        const int sample = time - lane / 2;
+
+        if (sample < 0 || sample >= numSamples)
+            continue;
+
+        const float y = b0[(size_t) lane] * x[lane] + state1[(size_t) lane];
+        state1[(size_t) lane] = b1[(size_t) lane] * x[lane] - a1[(size_t) lane] * y + state2[(size_t) lane];
+        state2[(size_t) lane] = b2[(size_t) lane] * x[lane] - a2[(size_t) lane] * y;
+        outputs[(size_t) lane] = y;
+    }
+}
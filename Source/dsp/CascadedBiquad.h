@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    CascadedBiquad.h
+    Created: 19 Oct 2026 5:21:38pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPHelper.h"
+
+/*
+    Up to maxStages transposed direct form II biquads in series, for both
+    channels at once. Every (stage, channel) pair owns one lane of a small
+    array, and the stages are pipelined: at each step stage s works on the
+    sample stage s - 1 finished on the step before. That turns the whole
+    cascade into one straight run over numLanes values per step, which the
+    compiler keeps in vector registers, so a 48 dB/oct stereo filter costs
+    about what a single stereo biquad does when run one channel at a time.
+    Only the lanes of the stages in use are run, so a 12 dB/oct slope
+    costs one stage, not maxStages.
+
+    The pipeline is filled and drained inside every call to process(), so
+    there is no added latency.
+*/
+class CascadedBiquad
+{
+public:
+    static constexpr int maxStages { DSPHelper::maxFilterStages };
+
+    CascadedBiquad();
+
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    /* stages beyond the new count are cleared to pass straight through */
+    void setNumStages (int newNumStages);
+    int getNumStages() const noexcept { return numStages; }
+
+    /* takes the unnormalised b0 b1 b2 a0 a1 a2 layout of juce::dsp::IIR::ArrayCoefficients */
+    void setStageCoefficients (int stage, const std::array<float, 6>& coefficients) noexcept;
+
+    void process (const juce::dsp::ProcessContextReplacing<float>& context) noexcept;
+
+private:
+    static constexpr int numLanes { maxStages * 2 };
+
+    void clearStage (int stage) noexcept;
+
+    template <int activeStages>
+    void processStages (const juce::dsp::ProcessContextReplacing<float>& context) noexcept;
+
+    template <int activeStages, bool isFillingOrDraining>
+    void step (const float* input, int time, int numSamples) noexcept;
+
+    alignas (32) std::array<float, numLanes> b0 {}, b1 {}, b2 {}, a1 {}, a2 {};
+    alignas (32) std::array<float, numLanes> state1 {}, state2 {};
+    alignas (32) std::array<float, numLanes> outputs {};
+
+    int numStages { 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CascadedBiquad);
+};
@@ -20,6 +20,7 @@ struct DSPHelper
     static constexpr float minimumEnvGainDecibels = -1000.0f, centerEnvGainDecibels = -12.0f;
     static constexpr float minimumAttack = 0.001, maximumAttack = 10.0f, centerAttack = 0.5f, minimumDecay = 0.005f, maximumDecay = 20.0f, centerDecay = 1.0f, minimumRelease = 0.005f, maximumRelease = 30.0f, centerRelease = 1.5f;
     static constexpr float defaultFilterQ = 0.77f;
+    static constexpr int maxFilterStages = 4;
     
     static float mapNormalizedToFrequency (float normValue)
     {
@@ -31,6 +32,18 @@ struct DSPHelper
         return juce::mapFromLog10(denormValue, minimumFrequency, maximumFrequency);
     }
     
+    // Butterworth Qs for a cascade of numStages biquads; the resonant first stage
+    // is scaled by how far q sits from a lone Butterworth biquad
+    static float getCascadeStageQ (int stage, int numStages, float q)
+    {
+        const float butterworthQ = 1.0f / (2.0f * std::sin(juce::MathConstants<float>::pi * (2 * stage + 1) / (4 * numStages)));
+        
+        if (stage == 0)
+            return butterworthQ * q * juce::MathConstants<float>::sqrt2;
+        
+        return butterworthQ;
+    }
+    
     static float getDelayLowpassCutoff (float centerFreq, float width)
     {
         return juce::jlimit(minimumFrequency, maximumFrequency, centerFreq * width);
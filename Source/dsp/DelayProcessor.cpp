@@ -17,6 +17,7 @@ DelayProcessor::DelayProcessor(juce::AudioProcessorValueTreeState& t_apvts,
                                std::atomic<float>& t_bpm)
 : apvts(t_apvts)
 , delayTree(paramTree.getChildWithName(ParamIDs::delayTree))
+, tapTree(delayTree.getChildWithName(ParamIDs::delayTapTree))
 , lfoTree(paramTree.getChildWithName(ParamIDs::lfoTree))
 , lfo1(t_lfo1)
 , lfo2(t_lfo2)
@@ -38,6 +39,11 @@ DelayProcessor::DelayProcessor(juce::AudioProcessorValueTreeState& t_apvts,
     leftSyncState.store(delayTree[ParamIDs::delaySyncLeft]);
     rightSyncState.store(delayTree[ParamIDs::delaySyncRight]);
     filterOn.store(delayTree[ParamIDs::delayFilterIO]);
+    compactStorage.store(delayTree[ParamIDs::delayCompactStorage]);
+    delayMode.store(delayTree[ParamIDs::delayMode]);
+    rebuildTapSettings();
+    
+    startTimerHz(storageCheckRateHz);
 }
 
 void DelayProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
@@ -48,19 +54,18 @@ void DelayProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = getTotalNumOutputChannels();
     
-    delayL.prepare(spec);
-    delayR.prepare(spec);
-    delayL.setMaximumDelayInSamples(maxDelayInSeconds * sampleRate + 100.0f);
-    delayR.setMaximumDelayInSamples(maxDelayInSeconds * sampleRate + 100.0f);
+    // storage starts at what the current settings can reach and grows from the timer
+    delayLine.prepare(spec);
+    delayLine.setMaximumDelayInSamples((int) (getReachableDelayInSeconds() * sampleRate) + delayHeadroomInSamples,
+                                       getStorageFormat());
+    delayLine.setSmoothingTime(sampleRate, smoothingTimeInSeconds);
     
     delayMixer.prepare(spec);
     delayMixer.setWetLatency(0.0f);
     delayMixer.setMixingRule(juce::dsp::DryWetMixingRule::squareRoot4p5dB); // TODO try new rules
     
     delayBuffer.setSize(2, samplesPerBlock);
-    
-    leftDelaySmoothed.reset(sampleRate, smoothingTimeInSeconds);
-    rightDelaySmoothed.reset(sampleRate, smoothingTimeInSeconds);
+    tapBuffer.setSize(2, samplesPerBlock);
     
     lowpassDelayFilter.prepare(spec);
     highpassDelayFilter.prepare(spec);
@@ -87,12 +92,16 @@ void DelayProcessor::processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBu
     
     updateDelay();
     
-    for (int sample = 0; sample < buffer.getNumSamples(); sample++)
+    delayLine.readBlock(wetL, wetR, buffer.getNumSamples());
+    
+    // taps are gathered before the write so they see the same ring state as the main heads
+    const int mode = delayMode.load();
+    
+    if (mode == ParameterHelper::multiTap)
     {
-        delayL.setDelay(leftDelaySmoothed.getNextValue());
-        delayR.setDelay(rightDelaySmoothed.getNextValue());
-        wetL[sample] = delayL.popSample(0);
-        wetR[sample] = delayR.popSample(1);
+        updateTaps();
+        tapBuffer.clear();
+        delayLine.readTaps(tapBuffer.getWritePointer(0), tapBuffer.getWritePointer(1), buffer.getNumSamples());
     }
     
     if (filterOn.load())
@@ -109,10 +118,27 @@ void DelayProcessor::processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBu
                                                     lfo1.buffer.getSample(0, 0),
                                                     lfo2.buffer.getSample(0, 0));
     
-    for (int sample = 0; sample < buffer.getNumSamples(); sample++)
+    if (mode == ParameterHelper::pingPong)
+    {
+        // input enters on the left only and each echo crosses over to the other side
+        juce::FloatVectorOperations::add(dryL, dryR, buffer.getNumSamples());
+        juce::FloatVectorOperations::multiply(dryL, 0.5f, buffer.getNumSamples());
+        juce::FloatVectorOperations::addWithMultiply(dryL, wetR, feedbackVal, buffer.getNumSamples());
+        juce::FloatVectorOperations::copyWithMultiply(dryR, wetL, feedbackVal, buffer.getNumSamples());
+    }
+    else
+    {
+        juce::FloatVectorOperations::addWithMultiply(dryL, wetL, feedbackVal, buffer.getNumSamples());
+        juce::FloatVectorOperations::addWithMultiply(dryR, wetR, feedbackVal, buffer.getNumSamples());
+    }
+    
+    delayLine.writeBlock(dryL, dryR, buffer.getNumSamples());
+    
+    // taps are heard but not fed back, otherwise eight of them would run away quickly
+    if (mode == ParameterHelper::multiTap)
     {
-        delayL.pushSample(0, wetL[sample] * feedbackVal + dryL[sample]);
-        delayR.pushSample(1, wetR[sample] * feedbackVal + dryR[sample]);
+        juce::FloatVectorOperations::add(wetL, tapBuffer.getReadPointer(0), buffer.getNumSamples());
+        juce::FloatVectorOperations::add(wetR, tapBuffer.getReadPointer(1), buffer.getNumSamples());
     }
     
     delayMixer.setWetMixProportion(LFO::processLFOSample(delayMix,
@@ -139,8 +165,7 @@ void DelayProcessor::updateDelay()
                                                            leftDelaySync->convertTo0to1(leftDelaySync->getIndex()),
                                                            lfo1Val,
                                                            lfo2Val);
-            int numSixteenths = ParameterHelper::syncOptions[leftDelaySyncIndex].getIntValue();
-            leftDelay = numSixteenths / (bpmToUse / 60.f * 4.0f);
+            leftDelay = ParameterHelper::getSyncTimeInSeconds(leftDelaySyncIndex, bpmToUse);
             rightDelay = leftDelay;
         }
         else
@@ -162,8 +187,7 @@ void DelayProcessor::updateDelay()
                                                            leftDelaySync->convertTo0to1(leftDelaySync->getIndex()),
                                                            lfo1Val,
                                                            lfo2Val);
-            int numSixteenths = ParameterHelper::syncOptions[leftDelaySyncIndex].getIntValue();
-            leftDelay = numSixteenths / (bpmToUse / 60.f * 4.0f);
+            leftDelay = ParameterHelper::getSyncTimeInSeconds(leftDelaySyncIndex, bpmToUse);
         }
         else
         {
@@ -181,8 +205,7 @@ void DelayProcessor::updateDelay()
                                                             rightDelaySync->convertTo0to1(rightDelaySync->getIndex()),
                                                             lfo1Val,
                                                             lfo2Val);
-            int numSixteenths = ParameterHelper::syncOptions[rightDelaySyncIndex].getIntValue();
-            rightDelay = numSixteenths / (bpmToUse / 60.f * 4.0f);
+            rightDelay = ParameterHelper::getSyncTimeInSeconds(rightDelaySyncIndex, bpmToUse);
         }
         else
         {
@@ -205,8 +228,136 @@ void DelayProcessor::updateDelay()
                                                          lfo1Val,
                                                          lfo2Val);
     
-    leftDelaySmoothed.setTargetValue(juce::jmin(leftDelay * (1.0f + leftOffsetValue / 100.0f), maxDelayInSeconds) * getSampleRate());
-    rightDelaySmoothed.setTargetValue(juce::jmin(rightDelay * (1.0f + rightOffsetValue / 100.0f), maxDelayInSeconds) * getSampleRate());;
+    delayLine.setTargetDelay(juce::jmin(leftDelay * (1.0f + leftOffsetValue / 100.0f), maxDelayInSeconds) * getSampleRate(),
+                             juce::jmin(rightDelay * (1.0f + rightOffsetValue / 100.0f), maxDelayInSeconds) * getSampleRate());
+}
+
+float DelayProcessor::getReachableDelayInSeconds()
+{
+    const float leftReachable = getReachableChannelDelay(leftSyncState,
+                                                         leftDelaySync,
+                                                         ParamIDs::lfoLeftDelaySync,
+                                                         leftDelayTime,
+                                                         ParamIDs::lfoLeftDelayTime,
+                                                         leftDelayOffset,
+                                                         ParamIDs::lfoLeftDelayOffset);
+    
+    // linked channels share the left time/sync but keep their own offset
+    const float rightReachable = getReachableChannelDelay(linkState ? leftSyncState.load() : rightSyncState.load(),
+                                                          linkState ? leftDelaySync : rightDelaySync,
+                                                          linkState ? ParamIDs::lfoLeftDelaySync : ParamIDs::lfoRightDelaySync,
+                                                          linkState ? leftDelayTime : rightDelayTime,
+                                                          linkState ? ParamIDs::lfoLeftDelayTime : ParamIDs::lfoRightDelayTime,
+                                                          rightDelayOffset,
+                                                          ParamIDs::lfoRightDelayOffset);
+    
+    const float tapReachable = delayMode.load() == ParameterHelper::multiTap ? getLongestTapInSeconds() : 0.0f;
+    
+    return juce::jmax(leftReachable, rightReachable, tapReachable);
+}
+
+float DelayProcessor::getReachableChannelDelay (bool syncState,
+                                                juce::AudioParameterChoice* syncParam,
+                                                const juce::Identifier& syncLFO,
+                                                juce::AudioParameterFloat* timeParam,
+                                                const juce::Identifier& timeLFO,
+                                                juce::AudioParameterFloat* offsetParam,
+                                                const juce::Identifier& offsetLFO)
+{
+    float delay;
+    
+    if (syncState)
+    {
+        // sync options are in ascending order, so the highest reachable index is the longest delay
+        const int syncIndex = (int) getModulationCeiling(syncParam, syncLFO, syncParam->convertTo0to1(syncParam->getIndex()));
+        delay = ParameterHelper::getSyncTimeInSeconds(syncIndex, bpm.load());
+    }
+    else
+    {
+        delay = getModulationCeiling(timeParam, timeLFO, timeParam->convertTo0to1(timeParam->get()));
+    }
+    
+    const float offset = getModulationCeiling(offsetParam, offsetLFO, offsetParam->convertTo0to1(offsetParam->get()));
+    
+    return juce::jmin(delay * (1.0f + offset / 100.0f), maxDelayInSeconds);
+}
+
+StereoDelayLine::StorageFormat DelayProcessor::getStorageFormat() const
+{
+    return compactStorage.load() ? StereoDelayLine::StorageFormat::int16
+                                 : StereoDelayLine::StorageFormat::float32;
+}
+
+void DelayProcessor::timerCallback()
+{
+    const double sampleRate = getSampleRate();
+    
+    if (sampleRate <= 0.0)
+        return;
+    
+    delayLine.reserveDelay((int) (getReachableDelayInSeconds() * sampleRate) + delayHeadroomInSamples,
+                           (int) (maxDelayInSeconds * sampleRate) + delayHeadroomInSamples,
+                           getStorageFormat());
+}
+
+void DelayProcessor::updateTaps()
+{
+    std::array<StereoDelayLine::Tap, ParameterHelper::numDelayTaps> taps;
+    const float bpmToUse = bpm.load();
+    const float sampleRate = (float) getSampleRate();
+    
+    {
+        TapSettingsObject::ScopedAccess<farbot::ThreadType::realtime> settings (tapSettings);
+        
+        for (size_t i = 0; i < taps.size(); i++)
+        {
+            const TapSetting& setting = (*settings)[i];
+            const float delay = setting.sync ? setting.numSixteenths / (bpmToUse / 60.f * 4.0f) : setting.timeInSeconds;
+            
+            taps[i].delayInSamples = juce::jmin(delay, maxDelayInSeconds) * sampleRate;
+            taps[i].leftGain = setting.enabled ? setting.leftGain : 0.0f;
+            taps[i].rightGain = setting.enabled ? setting.rightGain : 0.0f;
+        }
+    }
+    
+    delayLine.setTapTargets(taps.data(), (int) taps.size());
+}
+
+void DelayProcessor::rebuildTapSettings()
+{
+    TapSettings newSettings;
+    
+    for (int i = 0; i < juce::jmin(tapTree.getNumChildren(), ParameterHelper::numDelayTaps); i++)
+    {
+        const juce::ValueTree tap = tapTree.getChild(i);
+        TapSetting& setting = newSettings[(size_t) i];
+        
+        const float gain = tap[ParamIDs::tapGain];
+        const float pan = tap[ParamIDs::tapPan];
+        const int syncIndex = juce::jlimit(0, (int) std::size(ParameterHelper::syncSixteenths) - 1, (int) tap[ParamIDs::tapSyncIndex]);
+        
+        setting.enabled = tap[ParamIDs::tapEnabled];
+        setting.sync = tap[ParamIDs::tapSync];
+        setting.numSixteenths = ParameterHelper::syncSixteenths[syncIndex];
+        setting.timeInSeconds = tap[ParamIDs::tapTime];
+        setting.leftGain = gain * juce::jmin(1.0f, 1.0f - pan);
+        setting.rightGain = gain * juce::jmin(1.0f, 1.0f + pan);
+    }
+    
+    messageThreadTapSettings = newSettings;
+    tapSettings.nonRealtimeReplace(newSettings);
+}
+
+float DelayProcessor::getLongestTapInSeconds() const
+{
+    float longest = 0.0f;
+    
+    for (const TapSetting& setting : messageThreadTapSettings)
+        if (setting.enabled)
+            longest = juce::jmax(longest, setting.sync ? setting.numSixteenths / (bpm.load() / 60.f * 4.0f)
+                                                       : setting.timeInSeconds);
+    
+    return juce::jmin(longest, maxDelayInSeconds);
 }
 
 void DelayProcessor::updateDelayFilter()
@@ -240,5 +391,14 @@ void DelayProcessor::valueTreePropertyChanged(juce::ValueTree& treeWhoseProperty
     
     else if (property == ParamIDs::delayFilterIO)
         filterOn.store(delayTree[property]);
+    
+    else if (property == ParamIDs::delayCompactStorage)
+        compactStorage.store(delayTree[property]);
+    
+    else if (property == ParamIDs::delayMode)
+        delayMode.store(delayTree[property]);
+    
+    else if (treeWhosePropertyHasChanged.getParent() == tapTree)
+        rebuildTapSettings();
 
 }
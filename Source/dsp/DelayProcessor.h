@@ -12,11 +12,14 @@
 
 #include "ProcessorBase.h"
 #include "LFO.h"
+#include "StereoDelayLine.h"
 #include "../service/ParameterHelper.h"
 #include "../service/ParamIDs.h"
+#include "../service/farbot/RealtimeObject.hpp"
 
 class DelayProcessor  : public ProcessorBase
                       , public juce::ValueTree::Listener
+                      , private juce::Timer
 {
 public:
     DelayProcessor(juce::AudioProcessorValueTreeState& apvts,
@@ -30,14 +33,63 @@ public:
     
     void updateDelay();
     void updateDelayFilter();
+    void updateTaps();
+    
+    /* longest delay the current time, sync, offset and LFO settings can reach */
+    float getReachableDelayInSeconds();
     
     void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property) override;
     
     const juce::String getName() const override { return "Delay Processor"; }
     
 private:
+    void timerCallback() override;
+    
+    float getReachableChannelDelay (bool syncState,
+                                    juce::AudioParameterChoice* syncParam,
+                                    const juce::Identifier& syncLFO,
+                                    juce::AudioParameterFloat* timeParam,
+                                    const juce::Identifier& timeLFO,
+                                    juce::AudioParameterFloat* offsetParam,
+                                    const juce::Identifier& offsetLFO);
+    
+    template <typename ParameterType>
+    float getModulationCeiling (ParameterType* parameter, const juce::Identifier& lfoID, float parameterValueNorm)
+    {
+        const juce::ValueTree lfoModTree = lfoTree.getChildWithName(lfoID);
+        float ceiling = parameter->convertFrom0to1(parameterValueNorm);
+        
+        for (const float lfo1Val : { -1.0f, 1.0f })
+            for (const float lfo2Val : { -1.0f, 1.0f })
+                ceiling = juce::jmax(ceiling, LFO::processLFOSample(parameter, lfoModTree, parameterValueNorm, lfo1Val, lfo2Val));
+        
+        return ceiling;
+    }
+    
+    StereoDelayLine::StorageFormat getStorageFormat() const;
+    
+    /* ----- MULTI-TAP ----- */
+    
+    struct TapSetting
+    {
+        bool enabled { false };
+        bool sync { false };
+        int numSixteenths { 1 };
+        float timeInSeconds { 0.0f };
+        float leftGain { 0.0f };
+        float rightGain { 0.0f };
+    };
+    
+    using TapSettings = std::array<TapSetting, ParameterHelper::numDelayTaps>;
+    using TapSettingsObject = farbot::RealtimeObject<TapSettings, farbot::RealtimeObjectOptions::nonRealtimeMutatable>;
+    
+    void rebuildTapSettings();
+    float getLongestTapInSeconds() const;
+    
+    
     juce::AudioProcessorValueTreeState& apvts;
     juce::ValueTree delayTree;
+    juce::ValueTree tapTree;
     juce::ValueTree lfoTree;
     LFO& lfo1;
     LFO& lfo2;
@@ -55,15 +107,14 @@ private:
     
     std::atomic<float>& bpm;
     
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayL;
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Lagrange3rd> delayR;
+    StereoDelayLine delayLine;
     const float maxDelayInSeconds { 3.0f };
+    const int delayHeadroomInSamples { 100 };
+    const int storageCheckRateHz { 20 };
     
     juce::dsp::DryWetMixer<float> delayMixer;
     juce::AudioBuffer<float> delayBuffer;
     
-    juce::SmoothedValue<float> leftDelaySmoothed;
-    juce::SmoothedValue<float> rightDelaySmoothed;
     const float smoothingTimeInSeconds { 0.1f };
     
     std::atomic<bool> linkState;
@@ -73,6 +124,13 @@ private:
     juce::dsp::StateVariableTPTFilter<float> lowpassDelayFilter;
     juce::dsp::StateVariableTPTFilter<float> highpassDelayFilter;
     std::atomic<bool> filterOn;
+    std::atomic<bool> compactStorage;
+    std::atomic<int> delayMode;
+    
+    // message thread builds the settings, the audio thread only reads them
+    TapSettingsObject tapSettings;
+    TapSettings messageThreadTapSettings;
+    juce::AudioBuffer<float> tapBuffer;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayProcessor);
 };
@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+    FDNReverb.cpp
+    Created: 19 Oct 2026 2:41:07pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "FDNReverb.h"
+
+namespace
+{
+    // in-place fast Walsh-Hadamard transform, normalised so the mix is lossless
+    template <int size>
+    inline void hadamard (float* values) noexcept
+    {
+        for (int half = 1; half < size; half *= 2)
+        {
+            for (int start = 0; start < size; start += half * 2)
+            {
+                for (int i = start; i < start + half; i++)
+                {
+                    const float a = values[i], b = values[i + half];
+                    values[i] = a + b;
+                    values[i + half] = a - b;
+                }
+            }
+        }
+
+        const float scale = 1.0f / std::sqrt((float) size);
+
+        for (int i = 0; i < size; i++)
+            values[i] *= scale;
+    }
+}
+
+void FDNReverb::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    jassert (spec.numChannels <= 2);
+
+    sampleRate = spec.sampleRate;
+
+    int longest = 0;
+
+    for (int line = 0; line < numLines; line++)
+    {
+        lineLengths[(size_t) line] = juce::jmax(1, juce::roundToInt(lineLengthsInMs[line] * 0.001 * sampleRate));
+        longest = juce::jmax(longest, lineLengths[(size_t) line]);
+    }
+
+    numFrames = longest + 1;
+    frames.assign((size_t) numFrames * numLines, 0.0f);
+
+    wetGain1.reset(sampleRate, smoothingTimeInSeconds);
+    wetGain2.reset(sampleRate, smoothingTimeInSeconds);
+    dryGain.reset(sampleRate, smoothingTimeInSeconds);
+
+    reset();
+    updateCoefficients();
+    updateGains();
+}
+
+void FDNReverb::reset()
+{
+    std::fill(frames.begin(), frames.end(), 0.0f);
+    dampingStates.fill(0.0f);
+    writeFrame = 0;
+}
+
+void FDNReverb::setParameters (const juce::Reverb::Parameters& newParameters)
+{
+    // this comes every block, and the pow and exp per line are only worth redoing when the decay or damping moved
+    const bool decayChanged = newParameters.roomSize != parameters.roomSize
+                           || newParameters.damping != parameters.damping
+                           || newParameters.freezeMode != parameters.freezeMode;
+
+    parameters = newParameters;
+
+    if (decayChanged)
+        updateCoefficients();
+
+    updateGains();
+}
+
+void FDNReverb::updateCoefficients()
+{
+    const bool frozen = parameters.freezeMode >= 0.5f;
+
+    // size sets the 60 dB decay time, squared so the lower half of the knob stays roomy
+    const float decayInSeconds = juce::jmap(parameters.roomSize * parameters.roomSize, minimumDecayInSeconds, maximumDecayInSeconds);
+
+    for (int line = 0; line < numLines; line++)
+        decayGains[(size_t) line] = frozen ? 1.0f : std::pow(10.0f, -3.0f * (float) lineLengths[(size_t) line] / (decayInSeconds * (float) sampleRate));
+
+    const float dampingFrequency = juce::mapToLog10(1.0f - parameters.damping, minimumDampingFrequency, maximumDampingFrequency);
+    dampingCoefficient = frozen ? 0.0f : std::exp(-juce::MathConstants<float>::twoPi * dampingFrequency / (float) sampleRate);
+
+    inputGain = frozen ? 0.0f : 0.5f;
+}
+
+void FDNReverb::updateGains()
+{
+    // the same scaling and width law as juce::Reverb, so switching engines doesn't jump in level
+    const float wet = parameters.wetLevel * wetScaleFactor;
+
+    wetGain1.setTargetValue(wet * (parameters.width * 0.5f + 0.5f));
+    wetGain2.setTargetValue(wet * ((1.0f - parameters.width) * 0.5f));
+    dryGain.setTargetValue(parameters.dryLevel * dryScaleFactor);
+}
+
+void FDNReverb::process (const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    auto& block = context.getOutputBlock();
+    const int numSamples = (int) block.getNumSamples();
+    const bool isStereo = block.getNumChannels() > 1;
+
+    float* left = block.getChannelPointer(0);
+    float* right = isStereo ? block.getChannelPointer(1) : left;
+
+    float* data = frames.data();
+    alignas (16) float lines[numLines];
+
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        for (int line = 0; line < numLines; line++)
+        {
+            int readFrame = writeFrame - lineLengths[(size_t) line];
+            if (readFrame < 0)
+                readFrame += numFrames;
+
+            lines[line] = data[readFrame * numLines + line];
+        }
+
+        // even lines feed the left output and odd lines the right, before they are mixed
+        float wetL = 0.0f, wetR = 0.0f;
+
+        for (int line = 0; line < numLines; line += 2)
+        {
+            wetL += lines[line];
+            wetR += lines[line + 1];
+        }
+
+        for (int line = 0; line < numLines; line++)
+        {
+            dampingStates[(size_t) line] = lines[line] + dampingCoefficient * (dampingStates[(size_t) line] - lines[line]);
+            lines[line] = dampingStates[(size_t) line] * decayGains[(size_t) line];
+        }
+
+        hadamard<numLines>(lines);
+
+        const float inL = left[sample] * inputGain, inR = right[sample] * inputGain;
+        float* frame = data + writeFrame * numLines;
+
+        for (int line = 0; line < numLines; line += 2)
+        {
+            frame[line] = lines[line] + inL;
+            frame[line + 1] = lines[line + 1] + inR;
+        }
+
+        if (++writeFrame == numFrames)
+            writeFrame = 0;
+
+        wetL *= 0.5f;
+        wetR *= 0.5f;
+
+        const float wet1 = wetGain1.getNextValue(), wet2 = wetGain2.getNextValue(), dry = dryGain.getNextValue();
+        const float outL = wetL * wet1 + wetR * wet2 + left[sample] * dry;
+        const float outR = wetR * wet1 + wetL * wet2 + right[sample] * dry;
+
+        left[sample] = outL;
+
+        if (isStereo)
+            right[sample] = outR;
+    }
+}
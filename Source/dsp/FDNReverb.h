@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    FDNReverb.h
+    Created: 19 Oct 2026 2:41:07pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    Eight line feedback delay network. All lines share one ring of frames
+    (one float per line per frame) so the write, damping, decay and Hadamard
+    mix are straight runs over numLines values the compiler can keep in
+    vector registers. Takes the same juce::Reverb::Parameters as
+    juce::dsp::Reverb so the two can be swapped.
+*/
+class FDNReverb
+{
+public:
+    static constexpr int numLines { 8 };
+
+    FDNReverb() = default;
+
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    void setParameters (const juce::Reverb::Parameters& newParameters);
+
+    void process (const juce::dsp::ProcessContextReplacing<float>& context);
+
+private:
+    /* decay and damping, for the current sample rate */
+    void updateCoefficients();
+    void updateGains();
+
+    double sampleRate { 44100.0 };
+
+    std::vector<float> frames;
+    int numFrames { 0 };
+    int writeFrame { 0 };
+
+    std::array<int, numLines> lineLengths {};
+    alignas (16) std::array<float, numLines> decayGains {};
+    alignas (16) std::array<float, numLines> dampingStates {};
+    float dampingCoefficient { 0.0f };
+    float inputGain { 0.0f };
+
+    juce::Reverb::Parameters parameters;
+    juce::SmoothedValue<float> wetGain1, wetGain2, dryGain;
+
+    // mutually prime-ish lengths so the modes don't pile up on each other
+    static constexpr float lineLengthsInMs[numLines] { 29.7f, 37.1f, 41.1f, 43.7f, 53.0f, 59.9f, 67.1f, 73.3f };
+    static constexpr float minimumDecayInSeconds { 0.25f }, maximumDecayInSeconds { 12.0f };
+    static constexpr float minimumDampingFrequency { 1500.0f }, maximumDampingFrequency { 18000.0f };
+    static constexpr float smoothingTimeInSeconds { 0.01f };
+    static constexpr float wetScaleFactor { 3.0f }, dryScaleFactor { 2.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FDNReverb);
+};
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    FilterCoefficientCache.cpp
+    Created: 19 Oct 2026 4:05:52pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "FilterCoefficientCache.h"
+
+void FilterCoefficientCache::prepare (double sampleRate)
+{
+    // one extra entry so interpolation at exactly 1.0 stays in bounds
+    warpedTangents.resize(cutoffResolution + 1);
+    warpedTangentReciprocals.resize(cutoffResolution + 1);
+    omegaSines.resize(cutoffResolution + 1);
+    omegaCosines.resize(cutoffResolution + 1);
+
+    const double nyquistLimit = sampleRate * 0.49;
+
+    for (int i = 0; i <= cutoffResolution; i++)
+    {
+        const double frequency = juce::jmin((double) DSPHelper::mapNormalizedToFrequency((float) i / cutoffResolution), nyquistLimit);
+        const double tangent = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+        const double omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+        warpedTangents[(size_t) i] = (float) tangent;
+        warpedTangentReciprocals[(size_t) i] = (float) (1.0 / tangent);
+        omegaSines[(size_t) i] = (float) std::sin(omega);
+        omegaCosines[(size_t) i] = (float) std::cos(omega);
+    }
+
+    shelfAmplitudes.resize(gainResolution + 1);
+    shelfAmplitudeRoots.resize(gainResolution + 1);
+
+    for (int i = 0; i <= gainResolution; i++)
+    {
+        const double decibels = juce::jmap((double) i / gainResolution, (double) DSPHelper::minimumFilterDecibels, (double) DSPHelper::maximumFilterDecibels);
+        const double amplitude = std::sqrt(juce::Decibels::decibelsToGain(decibels));
+
+        shelfAmplitudes[(size_t) i] = (float) amplitude;
+        shelfAmplitudeRoots[(size_t) i] = (float) std::sqrt(amplitude);
+    }
+}
+
+std::array<float, 6> FilterCoefficientCache::makeCoefficients (Shape shape, float cutoffNorm, float q, float gainDecibels) const noexcept
+{
+    jassert (! warpedTangents.empty());
+
+    const float cutoffPosition = juce::jlimit(0.0f, 1.0f, cutoffNorm) * cutoffResolution;
+    const float invQ = 1.0f / q;
+
+    if (shape == Shape::lowPass || shape == Shape::highPass)
+    {
+        const float n = lookup(shape == Shape::lowPass ? warpedTangentReciprocals : warpedTangents, cutoffPosition);
+        const float nSquared = n * n;
+        const float c1 = 1.0f / (1.0f + invQ * n + nSquared);
+
+        if (shape == Shape::lowPass)
+            return { c1, c1 * 2.0f, c1, 1.0f, c1 * 2.0f * (1.0f - nSquared), c1 * (1.0f - invQ * n + nSquared) };
+
+        return { c1, c1 * -2.0f, c1, 1.0f, c1 * 2.0f * (nSquared - 1.0f), c1 * (1.0f - invQ * n + nSquared) };
+    }
+
+    const float gainPosition = juce::jmap(juce::jlimit(DSPHelper::minimumFilterDecibels, DSPHelper::maximumFilterDecibels, gainDecibels),
+                                          DSPHelper::minimumFilterDecibels, DSPHelper::maximumFilterDecibels,
+                                          0.0f, (float) gainResolution);
+
+    const float A = lookup(shelfAmplitudes, gainPosition);
+    const float aminus1 = A - 1.0f;
+    const float aplus1 = A + 1.0f;
+    const float coso = lookup(omegaCosines, cutoffPosition);
+    const float beta = lookup(omegaSines, cutoffPosition) * lookup(shelfAmplitudeRoots, gainPosition) * invQ;
+    const float aminus1TimesCoso = aminus1 * coso;
+
+    if (shape == Shape::lowShelf)
+        return { A * (aplus1 - aminus1TimesCoso + beta),
+                 A * 2.0f * (aminus1 - aplus1 * coso),
+                 A * (aplus1 - aminus1TimesCoso - beta),
+                 aplus1 + aminus1TimesCoso + beta,
+                 -2.0f * (aminus1 + aplus1 * coso),
+                 aplus1 + aminus1TimesCoso - beta };
+
+    return { A * (aplus1 + aminus1TimesCoso + beta),
+             A * -2.0f * (aminus1 + aplus1 * coso),
+             A * (aplus1 + aminus1TimesCoso - beta),
+             aplus1 - aminus1TimesCoso + beta,
+             2.0f * (aminus1 - aplus1 * coso),
+             aplus1 - aminus1TimesCoso - beta };
+}
+
+float FilterCoefficientCache::lookup (const std::vector<float>& table, float position) noexcept
+{
+    const int index = juce::jmin((int) position, (int) table.size() - 2);
+    const float fraction = position - (float) index;
+
+    return table[(size_t) index] + fraction * (table[(size_t) index + 1] - table[(size_t) index]);
+}
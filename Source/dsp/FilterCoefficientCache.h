@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    FilterCoefficientCache.h
+    Created: 19 Oct 2026 4:05:52pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPHelper.h"
+
+/*
+    Precomputed building blocks for the filter module's biquads. Everything
+    transcendental in the RBJ/JUCE formulas depends on the cutoff alone (tan,
+    sin and cos of the warped frequency) or on the shelf gain alone (its
+    square root in amplitude), so those are tabulated once per sample rate
+    over the normalised cutoff and the dB range, and read back with linear
+    interpolation. Assembling the six coefficients from them is a handful of
+    multiplies, with Q only entering as a reciprocal.
+
+    The results match ArrayCoefficients::makeLowPass/makeHighPass/
+    makeLowShelf/makeHighShelf and are returned in the same unnormalised form.
+*/
+class FilterCoefficientCache
+{
+public:
+    enum class Shape { lowPass, highPass, lowShelf, highShelf };
+
+    FilterCoefficientCache() = default;
+
+    void prepare (double sampleRate);
+
+    std::array<float, 6> makeCoefficients (Shape shape, float cutoffNorm, float q, float gainDecibels) const noexcept;
+
+private:
+    static float lookup (const std::vector<float>& table, float position) noexcept;
+
+    static constexpr int cutoffResolution { 1024 };
+    static constexpr int gainResolution { 512 };
+
+    std::vector<float> warpedTangents;
+    std::vector<float> warpedTangentReciprocals;
+    std::vector<float> omegaSines;
+    std::vector<float> omegaCosines;
+    std::vector<float> shelfAmplitudes;
+    std::vector<float> shelfAmplitudeRoots;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FilterCoefficientCache);
+};
@@ -31,6 +31,8 @@ FilterProcessor::FilterProcessor(juce::AudioProcessorValueTreeState& t_apvts,
     filterTree.addListener(this);
     lowFilterType.store(filterTree.getProperty(ParamIDs::filterLowpassMode));
     highFilterType.store(filterTree.getProperty(ParamIDs::filterHighpassMode));
+    lowFilterSlope.store(filterTree.getProperty(ParamIDs::filterLowpassSlope));
+    highFilterSlope.store(filterTree.getProperty(ParamIDs::filterHighpassSlope));
 }
 
 void FilterProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
@@ -44,6 +46,22 @@ void FilterProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     lowpassFilter.prepare(spec);
     highpassFilter.prepare(spec);
     
+    coefficientCache.prepare(sampleRate);
+    
+    for (auto* smoother : { &lowpassCutoffSmoothed, &lowpassQSmoothed, &lowpassGainSmoothed,
+                            &highpassCutoffSmoothed, &highpassQSmoothed, &highpassGainSmoothed })
+        smoother->reset(sampleRate, smoothingTimeInSeconds);
+    
+    // start settled on the current settings rather than sweeping in from zero
+    updateFilters();
+    
+    for (auto* smoother : { &lowpassCutoffSmoothed, &lowpassQSmoothed, &lowpassGainSmoothed,
+                            &highpassCutoffSmoothed, &highpassQSmoothed, &highpassGainSmoothed })
+        smoother->setCurrentAndTargetValue(smoother->getTargetValue());
+    
+    lastLowpassControls = {};
+    lastHighpassControls = {};
+    
     mixer.prepare(spec);
     mixer.setWetLatency(0.0f);
     mixer.setMixingRule(juce::dsp::DryWetMixingRule::squareRoot4p5dB);
@@ -55,12 +73,23 @@ void FilterProcessor::processBlock (juce::AudioSampleBuffer& buffer, juce::MidiB
     
     mixer.pushDrySamples(block);
     
-    updateFilters(*lowpassFilter.state, *highpassFilter.state, lowFilterType.load(), highFilterType.load());
+    updateFilters();
+    
+    const int lowpassMode = lowFilterType.load(), highpassMode = highFilterType.load();
+    const int lowpassSlope = lowFilterSlope.load(), highpassSlope = highFilterSlope.load();
     
-    if (lowFilterType.load() != ParameterHelper::off)
-        lowpassFilter.process(juce::dsp::ProcessContextReplacing<float> (block));
-    if (highFilterType.load() != ParameterHelper::off)
-        highpassFilter.process(juce::dsp::ProcessContextReplacing<float> (block));
+    for (int start = 0; start < buffer.getNumSamples(); start += controlTickSize)
+    {
+        const int tickLength = juce::jmin(controlTickSize, buffer.getNumSamples() - start);
+        juce::dsp::AudioBlock<float> tick = block.getSubBlock((size_t) start, (size_t) tickLength);
+        
+        updateCoefficients(tickLength, lowpassMode, highpassMode, lowpassSlope, highpassSlope);
+        
+        if (lowpassMode != ParameterHelper::off)
+            lowpassFilter.process(juce::dsp::ProcessContextReplacing<float> (tick));
+        if (highpassMode != ParameterHelper::off)
+            highpassFilter.process(juce::dsp::ProcessContextReplacing<float> (tick));
+    }
     
     const float mixVal = LFO::processLFOSample(mix,
                                                lfoTree.getChildWithName(ParamIDs::lfoFilterMix),
@@ -71,10 +100,8 @@ void FilterProcessor::processBlock (juce::AudioSampleBuffer& buffer, juce::MidiB
     mixer.mixWetSamples(buffer);
 }
 
-void FilterProcessor::updateFilters(juce::dsp::IIR::Coefficients<float>& lowpassCoeffs, juce::dsp::IIR::Coefficients<float>& highpassCoeffs, const int lowpassMode, const int highpassMode)
+void FilterProcessor::updateFilters()
 {
-    using CoeffArray = juce::dsp::IIR::ArrayCoefficients<float>;
-    
     const float lfo1Val = lfo1.buffer.getSample(0, 0), lfo2Val = lfo2.buffer.getSample(0, 0);
     
     const float lowpassCutoffVal = LFO::processLFOSample(lowpassCutoff,
@@ -108,25 +135,59 @@ void FilterProcessor::updateFilters(juce::dsp::IIR::Coefficients<float>& lowpass
                                                         lfo1Val,
                                                         lfo2Val);
     
-    if (lowpassMode == ParameterHelper::pass)
-       lowpassCoeffs = CoeffArray::makeLowPass(getSampleRate(),
-                                               DSPHelper::mapNormalizedToFrequency(lowpassCutoffVal),
-                                               lowpassQVal);
-    else if (lowpassMode == ParameterHelper::shelf)
-        lowpassCoeffs = CoeffArray::makeHighShelf(getSampleRate(),
-                                                  DSPHelper::mapNormalizedToFrequency(lowpassCutoffVal),
-                                                  lowpassQVal,
-                                                  juce::Decibels::decibelsToGain(lowpassGainVal));
-    
-    if (highpassMode == ParameterHelper::pass)
-        highpassCoeffs = CoeffArray::makeHighPass(getSampleRate(),
-                                                  DSPHelper::mapNormalizedToFrequency(highpassCutoffVal),
-                                                  highpassQVal);
-    else if (highpassMode == ParameterHelper::shelf)
-        highpassCoeffs = CoeffArray::makeLowShelf(getSampleRate(),
-                                                  DSPHelper::mapNormalizedToFrequency(highpassCutoffVal),
-                                                  highpassQVal,
-                                                  juce::Decibels::decibelsToGain(highpassGainVal));
+    lowpassCutoffSmoothed.setTargetValue(lowpassCutoffVal);
+    lowpassQSmoothed.setTargetValue(lowpassQVal);
+    lowpassGainSmoothed.setTargetValue(lowpassGainVal);
+    highpassCutoffSmoothed.setTargetValue(highpassCutoffVal);
+    highpassQSmoothed.setTargetValue(highpassQVal);
+    highpassGainSmoothed.setTargetValue(highpassGainVal);
+}
+
+void FilterProcessor::updateCoefficients(const int numSamples, const int lowpassMode, const int highpassMode, const int lowpassSlope, const int highpassSlope)
+{
+    FilterControls lowpassControls, highpassControls;
+    
+    lowpassControls.mode = lowpassMode;
+    lowpassControls.slope = lowpassSlope;
+    lowpassControls.cutoffNorm = lowpassCutoffSmoothed.skip(numSamples);
+    lowpassControls.q = lowpassQSmoothed.skip(numSamples);
+    lowpassControls.gainDecibels = lowpassGainSmoothed.skip(numSamples);
+    
+    highpassControls.mode = highpassMode;
+    highpassControls.slope = highpassSlope;
+    highpassControls.cutoffNorm = highpassCutoffSmoothed.skip(numSamples);
+    highpassControls.q = highpassQSmoothed.skip(numSamples);
+    highpassControls.gainDecibels = highpassGainSmoothed.skip(numSamples);
+    
+    applyControls(lowpassFilter, lastLowpassControls, lowpassControls,
+                  FilterCoefficientCache::Shape::lowPass, FilterCoefficientCache::Shape::highShelf);
+    applyControls(highpassFilter, lastHighpassControls, highpassControls,
+                  FilterCoefficientCache::Shape::highPass, FilterCoefficientCache::Shape::lowShelf);
+}
+
+void FilterProcessor::applyControls (CascadedBiquad& filter,
+                                     FilterControls& lastControls,
+                                     const FilterControls& controls,
+                                     const FilterCoefficientCache::Shape passShape,
+                                     const FilterCoefficientCache::Shape shelfShape)
+{
+    // nothing moved, so the filter keeps its coefficients and no maths runs at all
+    if (controls == lastControls || controls.mode == ParameterHelper::off)
+        return;
+    
+    lastControls = controls;
+    
+    const int numStages = juce::jlimit(1, CascadedBiquad::maxStages, controls.slope + 1);
+    const auto shape = controls.mode == ParameterHelper::pass ? passShape : shelfShape;
+    
+    filter.setNumStages(numStages);
+    
+    // a steeper shelf spreads its gain across the stages so the plateau stays where the knob says
+    for (int stage = 0; stage < numStages; stage++)
+        filter.setStageCoefficients(stage, coefficientCache.makeCoefficients(shape,
+                                                                             controls.cutoffNorm,
+                                                                             DSPHelper::getCascadeStageQ(stage, numStages, controls.q),
+                                                                             controls.gainDecibels / numStages));
 }
 
 void FilterProcessor::valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property)
@@ -136,4 +197,10 @@ void FilterProcessor::valueTreePropertyChanged(juce::ValueTree& treeWhosePropert
     
     else if (property == ParamIDs::filterHighpassMode)
         highFilterType.store(treeWhosePropertyHasChanged[property]);
+    
+    else if (property == ParamIDs::filterLowpassSlope)
+        lowFilterSlope.store(treeWhosePropertyHasChanged[property]);
+    
+    else if (property == ParamIDs::filterHighpassSlope)
+        highFilterSlope.store(treeWhosePropertyHasChanged[property]);
 }
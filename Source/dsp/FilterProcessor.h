@@ -12,6 +12,8 @@
 
 #include "ProcessorBase.h"
 #include "LFO.h"
+#include "FilterCoefficientCache.h"
+#include "CascadedBiquad.h"
 #include "../service/ParameterHelper.h"
 #include "../service/ParamIDs.h"
 
@@ -27,7 +29,8 @@ public:
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBuffer&) override;
     
-    void updateFilters(juce::dsp::IIR::Coefficients<float>& lowpassCoeffs, juce::dsp::IIR::Coefficients<float>& highpassCoeffs, const int lowpassMode, const int highpassMode);
+    void updateFilters();
+    void updateCoefficients(const int numSamples, const int lowpassMode, const int highpassMode, const int lowpassSlope, const int highpassSlope);
     
     void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property) override;
     
@@ -50,8 +53,40 @@ private:
     
     std::atomic<int> lowFilterType;
     std::atomic<int> highFilterType;
+    std::atomic<int> lowFilterSlope;
+    std::atomic<int> highFilterSlope;
     
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> lowpassFilter, highpassFilter;
+    CascadedBiquad lowpassFilter, highpassFilter;
+    
+    /* ----- COEFFICIENT UPDATES ----- */
+    
+    struct FilterControls
+    {
+        bool operator== (const FilterControls& other) const noexcept
+        {
+            return mode == other.mode && slope == other.slope && cutoffNorm == other.cutoffNorm && q == other.q && gainDecibels == other.gainDecibels;
+        }
+        
+        int mode { -1 };
+        int slope { ParameterHelper::slope12 };
+        float cutoffNorm { 0.0f }, q { 0.0f }, gainDecibels { 0.0f };
+    };
+    
+    void applyControls (CascadedBiquad& filter,
+                        FilterControls& lastControls,
+                        const FilterControls& controls,
+                        const FilterCoefficientCache::Shape passShape,
+                        const FilterCoefficientCache::Shape shelfShape);
+    
+    FilterCoefficientCache coefficientCache;
+    
+    // controls are smoothed and the coefficients refreshed every control tick
+    static constexpr int controlTickSize { 32 };
+    const float smoothingTimeInSeconds { 0.02f };
+    
+    juce::SmoothedValue<float> lowpassCutoffSmoothed, lowpassQSmoothed, lowpassGainSmoothed;
+    juce::SmoothedValue<float> highpassCutoffSmoothed, highpassQSmoothed, highpassGainSmoothed;
+    FilterControls lastLowpassControls, lastHighpassControls;
     
     juce::dsp::DryWetMixer<float> mixer;
 
@@ -116,7 +116,7 @@ void LFO::frequencyTimeChanged (float newFreqTime)
 
 void LFO::frequencySyncChanged (float newFreqSync)
 {
-    const float newSixteenths = ParameterHelper::syncOptions[static_cast<int> (newFreqSync)].getIntValue();
+    const float newSixteenths = ParameterHelper::syncSixteenths[static_cast<int> (newFreqSync)];
     const float newFreq = (bpm.load() / 60.f * 4.0f) / static_cast<float> (newSixteenths);
     
     freqSync.store(newFreq);
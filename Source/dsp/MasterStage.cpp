@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    MasterStage.cpp
+    Created: 19 Oct 2026 10:02:47pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "MasterStage.h"
+
+void MasterStage::prepare (double sampleRate)
+{
+    rampLength = juce::roundToInt(sampleRate * rampDurationSeconds);
+    reset();
+}
+
+void MasterStage::reset()
+{
+    currentGain = targetGain;
+    gainStep = 0.0f;
+    rampSamplesLeft = 0;
+}
+
+void MasterStage::setTargetGain (float newGain) noexcept
+{
+    setTargetGain(newGain, rampLength);
+}
+
+void MasterStage::setTargetGain (float newGain, int rampSamples) noexcept
+{
+    if (newGain == targetGain)
+        return;
+    
+    targetGain = newGain;
+    
+    if (rampSamples <= 0)
+    {
+        reset();
+        return;
+    }
+    
+    gainStep = (targetGain - currentGain) / rampSamples;
+    rampSamplesLeft = rampSamples;
+}
+
+void MasterStage::process (juce::AudioBuffer<float>& buffer, OutputAnalyzer& analyzer) noexcept
+{
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+    
+    if (numChannels == 0)
+        return;
+    
+    const OutputAnalyzer::WriteSpans spans = analyzer.prepareToWrite(numSamples);
+    const bool isCopying = spans.firstSize + spans.secondSize == numSamples;
+    
+    int position = 0;
+    
+    // runs end wherever the gain ramp finishes or the ring wraps round
+    while (position < numSamples)
+    {
+        int length = numSamples - position;
+        
+        if (rampSamplesLeft > 0)
+            length = juce::jmin(length, rampSamplesLeft);
+        if (isCopying && position < spans.firstSize)
+            length = juce::jmin(length, spans.firstSize - position);
+        
+        const float startGain = rampSamplesLeft > 0 ? currentGain + gainStep : currentGain;
+        const float step = rampSamplesLeft > 0 ? gainStep : 0.0f;
+        
+        for (int channel = 0; channel < numChannels; channel++)
+        {
+            float* samples = buffer.getWritePointer(channel, position);
+            
+            if (isCopying && channel < OutputAnalyzer::numChannels)
+            {
+                float* copy = position < spans.firstSize ? spans.first[(size_t) channel] + position
+                                                         : spans.second[(size_t) channel] + position - spans.firstSize;
+                processSpan<true>(samples, copy, length, startGain, step);
+            }
+            else
+            {
+                processSpan<false>(samples, nullptr, length, startGain, step);
+            }
+        }
+        
+        if (rampSamplesLeft > 0)
+        {
+            rampSamplesLeft -= length;
+            currentGain = rampSamplesLeft > 0 ? currentGain + gainStep * length : targetGain;
+        }
+        
+        position += length;
+    }
+    
+    // a mono output still feeds both analyzer channels
+    if (isCopying)
+    {
+        for (int channel = numChannels; channel < OutputAnalyzer::numChannels; channel++)
+        {
+            juce::FloatVectorOperations::copy(spans.first[(size_t) channel], spans.first[(size_t) numChannels - 1], spans.firstSize);
+            juce::FloatVectorOperations::copy(spans.second[(size_t) channel], spans.second[(size_t) numChannels - 1], spans.secondSize);
+        }
+    }
+    
+    analyzer.finishedWrite(spans);
+}
+
+template <bool isCopying>
+void MasterStage::processSpan (float* samples, float* copy, int numSamples, float gain, float gainStep) noexcept
+{
+    constexpr float smallestNormal = std::numeric_limits<float>::min();
+    constexpr float largestFinite = std::numeric_limits<float>::max();
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        const float sample = samples[i] * (gain + gainStep * (float) i);
+        const float magnitude = std::abs(sample);
+        
+        // NaN fails both comparisons, so it's flushed along with inf and denormals
+        const float guarded = (magnitude >= smallestNormal && magnitude <= largestFinite) ? sample : 0.0f;
+        
+        samples[i] = guarded;
+        
+        if constexpr (isCopying)
+            copy[i] = guarded;
+    }
+}
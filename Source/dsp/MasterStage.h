@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    MasterStage.h
+    Created: 19 Oct 2026 10:02:47pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "OutputAnalyzer.h"
+
+/*
+    The last stage of processBlock, fused into a single pass over the output:
+    ramps the master gain, flushes anything that isn't a finite, normal float
+    (NaN, inf and denormals all become silence), and copies the result into
+    the output analyzer's ring as it goes, so the metering hand-off costs no
+    extra trip through memory.
+    
+    The inner loop is kept free of branches so it vectorises.
+*/
+class MasterStage
+{
+public:
+    MasterStage() = default;
+    
+    void prepare (double sampleRate);
+    void reset();
+    
+    /* ramps from wherever the gain is now over rampDurationSeconds, or over rampSamples */
+    void setTargetGain (float newGain) noexcept;
+    void setTargetGain (float newGain, int rampSamples) noexcept;
+    
+    void process (juce::AudioBuffer<float>& buffer, OutputAnalyzer& analyzer) noexcept;
+    
+    static constexpr float rampDurationSeconds { 0.0005f };
+
+private:
+    template <bool isCopying>
+    static void processSpan (float* samples, float* copy, int numSamples, float gain, float gainStep) noexcept;
+    
+    float currentGain { 1.0f }, targetGain { 1.0f };
+    float gainStep { 0.0f };
+    int rampLength { 0 };
+    int rampSamplesLeft { 0 };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MasterStage);
+};
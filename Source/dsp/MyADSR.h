@@ -11,11 +11,12 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../service/SwappableTable.h"
 
 class MyADSR : public juce::ValueTree::Listener
 {
 public:
-    MyADSR(juce::ValueTree t_synthTree, const juce::Identifier& t_propertyName, juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& tables)
+    MyADSR(juce::ValueTree t_synthTree, const juce::Identifier& t_propertyName, juce::OwnedArray<SwappableTable>& tables)
     : synthTree(t_synthTree)
     , propertyName(t_propertyName)
     , envTables(tables)
@@ -325,7 +326,7 @@ private:
     
     juce::ValueTree synthTree;
     const juce::Identifier& propertyName;
-    juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& envTables;
+    juce::OwnedArray<SwappableTable>& envTables;
     Parameters parameters;
 
     double sampleRate = 44100.0;
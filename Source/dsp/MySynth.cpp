@@ -14,10 +14,10 @@ MyVoice::MyVoice(juce::AudioProcessorValueTreeState& t_apvts,
                    juce::ValueTree nonParamTree,
                    LFO& t_lfo1,
                    LFO& t_lfo2,
-                   juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& oscAmpTables,
-                   juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& oscPitchTables,
-                   juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& noiseAmpTables,
-                   juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& noiseFilterTables)
+                   juce::OwnedArray<SwappableTable>& oscAmpTables,
+                   juce::OwnedArray<SwappableTable>& oscPitchTables,
+                   juce::OwnedArray<SwappableTable>& noiseAmpTables,
+                   juce::OwnedArray<SwappableTable>& noiseFilterTables)
 : apvts(t_apvts)
 , synthTree(nonParamTree.getChildWithName(ParamIDs::synthTree))
 , lfoTree(nonParamTree.getChildWithName(ParamIDs::lfoTree))
@@ -34,10 +34,10 @@ struct MyVoice : public juce::SynthesiserVoice
              juce::ValueTree nonParamTree,
              LFO& lfo1,
              LFO& lfo2,
-             juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& oscAmpTables,
-             juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& oscPitchTables,
-             juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& noiseAmpTables,
-             juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& noisePitchTables);
+             juce::OwnedArray<SwappableTable>& oscAmpTables,
+             juce::OwnedArray<SwappableTable>& oscPitchTables,
+             juce::OwnedArray<SwappableTable>& noiseAmpTables,
+             juce::OwnedArray<SwappableTable>& noisePitchTables);
     
     ~MyVoice();
 
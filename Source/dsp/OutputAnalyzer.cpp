@@ -0,0 +1,365 @@
+/*
+  ==============================================================================
+
+    OutputAnalyzer.cpp
+    Created: 19 Oct 2026 9:14:20pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "OutputAnalyzer.h"
+
+OutputAnalyzer::AnalysisThread::AnalysisThread()
+: juce::Thread("Output Analyzer")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+OutputAnalyzer::AnalysisThread::~AnalysisThread()
+{
+    stopThread(1000);
+}
+
+void OutputAnalyzer::AnalysisThread::add (OutputAnalyzer& analyzer)
+{
+    {
+        const juce::ScopedLock sl (lock);
+        analyzers.addIfNotAlreadyThere(&analyzer);
+    }
+    
+    notify();
+}
+
+void OutputAnalyzer::AnalysisThread::remove (OutputAnalyzer& analyzer)
+{
+    // the thread drains under this lock, so once it's held the analyzer is left alone
+    const juce::ScopedLock sl (lock);
+    analyzers.removeFirstMatchingValue(&analyzer);
+}
+
+void OutputAnalyzer::AnalysisThread::run()
+{
+    while (! threadShouldExit())
+    {
+        bool anyPrepared = false;
+        
+        {
+            const juce::ScopedLock sl (lock);
+            
+            for (auto* analyzer : analyzers)
+                analyzer->drain();
+            
+            anyPrepared = ! analyzers.isEmpty();
+        }
+        
+        // with nothing prepared there's nothing to poll for until add() wakes the thread
+        wait(anyPrepared ? pollIntervalMs : -1);
+    }
+}
+
+OutputAnalyzer::OutputAnalyzer()
+{
+    for (auto& peak : truePeaks)
+        peak.store(0.0f);
+    for (auto& level : rmsLevels)
+        level.store(silenceDecibels);
+}
+
+OutputAnalyzer::~OutputAnalyzer()
+{
+    release();
+}
+
+void OutputAnalyzer::prepare (double sampleRate, int maximumBlockSize)
+{
+    release();
+    
+    // a second of audio, or a few blocks if the host's blocks are huge
+    const int ringSize = juce::jmax((int) sampleRate, maximumBlockSize * 4) + 1;
+    ring.setSize(numChannels, ringSize);
+    fifo.setTotalSize(ringSize);
+    
+    chunk.setSize(numChannels, analysisChunkSize);
+    
+    oversampling = std::make_unique<juce::dsp::Oversampling<float>>(numChannels,
+                                                                    oversamplingOrder,
+                                                                    juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple,
+                                                                    true,
+                                                                    false);
+    oversampling->initProcessing(analysisChunkSize);
+    
+    // BS.1770 K-weighting: a high shelf for the head, then a high pass; these are the corner
+    // and Q that closely match the spec's 48 kHz coefficients with JUCE's filter designs
+    auto preFilter = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sampleRate, 1500.0f, juce::MathConstants<float>::sqrt2 * 0.5f,
+                                                                         juce::Decibels::decibelsToGain(4.0f));
+    auto highpassFilter = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 38.0f, 0.5f);
+    
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        preFilters[(size_t) channel].coefficients = preFilter;
+        highpassFilters[(size_t) channel].coefficients = highpassFilter;
+    }
+    
+    samplesPerStep = juce::roundToInt(sampleRate * 0.1);
+    clearLoudness();
+    
+    analysisThread->add(*this);
+}
+
+void OutputAnalyzer::release()
+{
+    analysisThread->remove(*this);
+}
+
+void OutputAnalyzer::pushBlock (const juce::AudioBuffer<float>& buffer) noexcept
+{
+    const WriteSpans spans = prepareToWrite(buffer.getNumSamples());
+    
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        const float* source = buffer.getReadPointer(juce::jmin(channel, buffer.getNumChannels() - 1));
+        
+        if (spans.firstSize > 0)
+            juce::FloatVectorOperations::copy(spans.first[(size_t) channel], source, spans.firstSize);
+        if (spans.secondSize > 0)
+            juce::FloatVectorOperations::copy(spans.second[(size_t) channel], source + spans.firstSize, spans.secondSize);
+    }
+    
+    finishedWrite(spans);
+}
+
+OutputAnalyzer::WriteSpans OutputAnalyzer::prepareToWrite (int numSamples) noexcept
+{
+    WriteSpans spans;
+    
+    if (numSamples > fifo.getFreeSpace())
+    {
+        droppedSamples.fetch_add(numSamples);
+        return spans;
+    }
+    
+    int start1, start2;
+    fifo.prepareToWrite(numSamples, start1, spans.firstSize, start2, spans.secondSize);
+    
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        spans.first[(size_t) channel] = ring.getWritePointer(channel, start1);
+        spans.second[(size_t) channel] = ring.getWritePointer(channel, start2);
+    }
+    
+    return spans;
+}
+
+void OutputAnalyzer::finishedWrite (const WriteSpans& spans) noexcept
+{
+    fifo.finishedWrite(spans.firstSize + spans.secondSize);
+}
+
+float OutputAnalyzer::getTruePeakAndReset (int channel) noexcept
+{
+    jassert (juce::isPositiveAndBelow(channel, numChannels));
+    return juce::Decibels::gainToDecibels(truePeaks[(size_t) channel].exchange(0.0f), silenceDecibels);
+}
+
+float OutputAnalyzer::getRMSLevel (int channel) const noexcept
+{
+    jassert (juce::isPositiveAndBelow(channel, numChannels));
+    return rmsLevels[(size_t) channel].load();
+}
+
+void OutputAnalyzer::drain()
+{
+    while (fifo.getNumReady() >= analysisChunkSize && ! juce::Thread::currentThreadShouldExit())
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(analysisChunkSize, start1, size1, start2, size2);
+        
+        for (int channel = 0; channel < numChannels; channel++)
+        {
+            if (size1 > 0)
+                chunk.copyFrom(channel, 0, ring, channel, start1, size1);
+            if (size2 > 0)
+                chunk.copyFrom(channel, size1, ring, channel, start2, size2);
+        }
+        
+        fifo.finishedRead(size1 + size2);
+        analyseChunk(analysisChunkSize);
+    }
+}
+
+void OutputAnalyzer::analyseChunk (int numSamples)
+{
+    if (integratedResetPending.exchange(false))
+    {
+        histogramCounts.fill(0);
+        histogramEnergies.fill(0.0);
+        integratedLoudness.store(silenceDecibels);
+    }
+    
+    /* ----- TRUE PEAK ----- */
+    
+    juce::dsp::AudioBlock<float> block (chunk);
+    auto oversampled = oversampling->processSamplesUp(block.getSubBlock(0, (size_t) numSamples));
+    
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        // the sample peak too, so the filters' ripple can never report less than the samples themselves
+        const auto samplePeak = chunk.findMinMax(channel, 0, numSamples);
+        const auto interpolatedPeak = juce::FloatVectorOperations::findMinAndMax(oversampled.getChannelPointer((size_t) channel),
+                                                                                 (int) oversampled.getNumSamples());
+        const float peak = juce::jmax(std::abs(samplePeak.getStart()), std::abs(samplePeak.getEnd()),
+                                      std::abs(interpolatedPeak.getStart()), std::abs(interpolatedPeak.getEnd()));
+        
+        auto& truePeak = truePeaks[(size_t) channel];
+        float previous = truePeak.load();
+        
+        while (peak > previous && ! truePeak.compare_exchange_weak(previous, peak)) {}
+    }
+    
+    /* ----- LOUDNESS AND RMS ----- */
+    
+    int start = 0;
+    
+    while (start < numSamples)
+    {
+        const int length = juce::jmin(numSamples - start, samplesPerStep - samplesInStep);
+        
+        for (int channel = 0; channel < numChannels; channel++)
+        {
+            const float* data = chunk.getReadPointer(channel, start);
+            auto& preFilter = preFilters[(size_t) channel];
+            auto& highpassFilter = highpassFilters[(size_t) channel];
+            double plain = 0.0, weighted = 0.0;
+            
+            for (int i = 0; i < length; i++)
+            {
+                const float weightedSample = highpassFilter.processSample(preFilter.processSample(data[i]));
+                plain += data[i] * data[i];
+                weighted += weightedSample * weightedSample;
+            }
+            
+            plainSum[(size_t) channel] += plain;
+            weightedSum[(size_t) channel] += weighted;
+        }
+        
+        samplesInStep += length;
+        start += length;
+        
+        if (samplesInStep == samplesPerStep)
+            finishStep();
+    }
+}
+
+void OutputAnalyzer::finishStep()
+{
+    double energy = 0.0;
+    
+    // left and right both carry a channel weight of 1
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        energy += weightedSum[(size_t) channel] / samplesPerStep;
+        stepMeanSquares[(size_t) channel][(size_t) stepIndex] = plainSum[(size_t) channel] / samplesPerStep;
+        weightedSum[(size_t) channel] = plainSum[(size_t) channel] = 0.0;
+    }
+    
+    stepEnergies[(size_t) stepIndex] = energy;
+    stepIndex = (stepIndex + 1) % stepsPerShortTerm;
+    stepsSeen = juce::jmin(stepsSeen + 1, stepsPerShortTerm);
+    samplesInStep = 0;
+    
+    auto meanOfLastSteps = [this] (const auto& steps, int count)
+    {
+        count = juce::jmin(count, stepsSeen);
+        double sum = 0.0;
+        
+        for (int i = 1; i <= count; i++)
+            sum += steps[(size_t) ((stepIndex - i + stepsPerShortTerm) % stepsPerShortTerm)];
+        
+        return sum / juce::jmax(count, 1);
+    };
+    
+    const double momentaryEnergy = meanOfLastSteps(stepEnergies, stepsPerMomentary);
+    const float momentary = energyToLoudness(momentaryEnergy);
+    momentaryLoudness.store(momentary);
+    shortTermLoudness.store(energyToLoudness(meanOfLastSteps(stepEnergies, stepsPerShortTerm)));
+    
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        const double meanSquare = meanOfLastSteps(stepMeanSquares[(size_t) channel], stepsPerRMS);
+        rmsLevels[(size_t) channel].store(juce::Decibels::gainToDecibels((float) std::sqrt(meanSquare), silenceDecibels));
+    }
+    
+    // every full momentary window is one gating block, overlapping the last by 75%
+    if (stepsSeen < stepsPerMomentary)
+        return;
+    
+    if (momentary <= absoluteGate)
+        return;
+    
+    const int bin = juce::jlimit(0, histogramSize - 1, (int) ((momentary - absoluteGate) / histogramStep));
+    histogramCounts[(size_t) bin]++;
+    histogramEnergies[(size_t) bin] += momentaryEnergy;
+    
+    updateIntegratedLoudness();
+}
+
+void OutputAnalyzer::updateIntegratedLoudness()
+{
+    auto gatedLoudness = [this] (int firstBin)
+    {
+        int64_t count = 0;
+        double energy = 0.0;
+        
+        for (int bin = juce::jmax(firstBin, 0); bin < histogramSize; bin++)
+        {
+            count += histogramCounts[(size_t) bin];
+            energy += histogramEnergies[(size_t) bin];
+        }
+        
+        return count > 0 ? energyToLoudness(energy / (double) count) : silenceDecibels;
+    };
+    
+    const float ungated = gatedLoudness(0);
+    const int relativeBin = (int) std::ceil((ungated + relativeGate - absoluteGate) / histogramStep);
+    
+    integratedLoudness.store(gatedLoudness(relativeBin));
+}
+
+void OutputAnalyzer::clearLoudness()
+{
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        preFilters[(size_t) channel].reset();
+        highpassFilters[(size_t) channel].reset();
+        truePeaks[(size_t) channel].store(0.0f);
+        rmsLevels[(size_t) channel].store(silenceDecibels);
+    }
+    
+    oversampling->reset();
+    
+    weightedSum.fill(0.0);
+    plainSum.fill(0.0);
+    stepEnergies.fill(0.0);
+    for (auto& steps : stepMeanSquares)
+        steps.fill(0.0);
+    
+    samplesInStep = 0;
+    stepIndex = 0;
+    stepsSeen = 0;
+    
+    histogramCounts.fill(0);
+    histogramEnergies.fill(0.0);
+    
+    momentaryLoudness.store(silenceDecibels);
+    shortTermLoudness.store(silenceDecibels);
+    integratedLoudness.store(silenceDecibels);
+}
+
+float OutputAnalyzer::energyToLoudness (double energy) noexcept
+{
+    if (energy <= 0.0)
+        return silenceDecibels;
+    
+    return juce::jmax(silenceDecibels, (float) (-0.691 + 10.0 * std::log10(energy)));
+}
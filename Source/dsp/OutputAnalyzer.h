@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    OutputAnalyzer.h
+    Created: 19 Oct 2026 9:14:20pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    Output metering off the audio thread. The audio thread only copies each
+    output block into a lock-free ring; a low priority thread drains it and
+    works out
+    
+        - true peak per channel, from 4x oversampled audio (BS.1770 style)
+        - momentary (400 ms), short-term (3 s) and gated integrated loudness
+          from K-weighted audio, per BS.1770
+        - momentary RMS per channel over the last 300 ms
+    
+    Results are published through atomics, so the editor can poll them from
+    its timer. If the analysis thread falls behind, the ring drops whole
+    blocks rather than blocking the audio thread; getNumDroppedSamples()
+    reports how many.
+    
+    The thread is shared, through a SharedResourcePointer, by every prepared
+    analyzer in the process, so however many instances are open there is one
+    thread waking to drain them all.
+*/
+class OutputAnalyzer
+{
+public:
+    static constexpr int numChannels { 2 };
+    
+    /* ring space for one block, split where the ring wraps round */
+    struct WriteSpans
+    {
+        std::array<float*, numChannels> first {}, second {};
+        int firstSize { 0 }, secondSize { 0 };
+    };
+    
+    OutputAnalyzer();
+    ~OutputAnalyzer() override;
+    
+    /* leaves the analysis thread while the ring and filters are rebuilt */
+    void prepare (double sampleRate, int maximumBlockSize);
+    void release();
+    
+    /* audio thread; never blocks or allocates */
+    void pushBlock (const juce::AudioBuffer<float>& buffer) noexcept;
+    
+    /* audio thread; for callers that fill the ring while they process the block anyway.
+       Both spans come back empty, and the block is counted as dropped, if it doesn't fit */
+    WriteSpans prepareToWrite (int numSamples) noexcept;
+    void finishedWrite (const WriteSpans& spans) noexcept;
+    
+    /* highest true peak since the last call, in decibels */
+    float getTruePeakAndReset (int channel) noexcept;
+    float getRMSLevel (int channel) const noexcept;
+    
+    float getMomentaryLoudness() const noexcept { return momentaryLoudness.load(); }
+    float getShortTermLoudness() const noexcept { return shortTermLoudness.load(); }
+    float getIntegratedLoudness() const noexcept { return integratedLoudness.load(); }
+    
+    /* message thread; the next analysed block starts a fresh measurement */
+    void resetIntegratedLoudness() noexcept { integratedResetPending.store(true); }
+    
+    int64_t getNumDroppedSamples() const noexcept { return droppedSamples.load(); }
+    
+    static constexpr float silenceDecibels { -100.0f };
+
+private:
+    static constexpr int analysisChunkSize { 256 };
+    static constexpr int oversamplingOrder { 2 };
+    
+    // loudness is built from 100 ms steps: 4 for momentary, 30 for short-term
+    static constexpr int stepsPerMomentary { 4 };
+    static constexpr int stepsPerShortTerm { 30 };
+    static constexpr int stepsPerRMS { 3 };
+    
+    // gating histogram with 0.1 LU bins, from the absolute gate up to +5 LUFS
+    static constexpr float absoluteGate { -70.0f };
+    static constexpr float relativeGate { -10.0f };
+    static constexpr float histogramStep { 0.1f };
+    static constexpr int histogramSize { 750 };
+    
+    class AnalysisThread  : private juce::Thread
+    {
+    public:
+        AnalysisThread();
+        ~AnalysisThread() override;
+        
+        void add (OutputAnalyzer& analyzer);
+        /* returns once the thread is no longer draining the analyzer */
+        void remove (OutputAnalyzer& analyzer);
+        
+    private:
+        static constexpr int pollIntervalMs { 10 };
+        
+        void run() override;
+        
+        juce::CriticalSection lock;
+        juce::Array<OutputAnalyzer*> analyzers;
+        
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalysisThread);
+    };
+    
+    /* analysis thread; analyses every whole chunk waiting in the ring */
+    void drain();
+    
+    void analyseChunk (int numSamples);
+    void finishStep();
+    void updateIntegratedLoudness();
+    void clearLoudness();
+    
+    static float energyToLoudness (double energy) noexcept;
+    
+    juce::AbstractFifo fifo { 1 };
+    juce::AudioBuffer<float> ring;
+    juce::AudioBuffer<float> chunk;
+    
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
+    std::array<juce::dsp::IIR::Filter<float>, numChannels> preFilters, highpassFilters;
+    
+    int samplesPerStep { 4800 };
+    int samplesInStep { 0 };
+    std::array<double, numChannels> weightedSum {}, plainSum {};
+    
+    // the last stepsPerShortTerm steps, oldest overwritten first
+    std::array<double, stepsPerShortTerm> stepEnergies {};
+    std::array<std::array<double, stepsPerShortTerm>, numChannels> stepMeanSquares {};
+    int stepIndex { 0 };
+    int stepsSeen { 0 };
+    
+    std::array<int64_t, histogramSize> histogramCounts {};
+    std::array<double, histogramSize> histogramEnergies {};
+    
+    std::array<std::atomic<float>, numChannels> truePeaks;
+    std::array<std::atomic<float>, numChannels> rmsLevels;
+    std::atomic<float> momentaryLoudness { silenceDecibels };
+    std::atomic<float> shortTermLoudness { silenceDecibels };
+    std::atomic<float> integratedLoudness { silenceDecibels };
+    std::atomic<bool> integratedResetPending { false };
+    std::atomic<int64_t> droppedSamples { 0 };
+    
+    juce::SharedResourcePointer<AnalysisThread> analysisThread;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutputAnalyzer);
+};
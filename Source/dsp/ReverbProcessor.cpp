@@ -15,6 +15,7 @@ ReverbProcessor::ReverbProcessor(juce::AudioProcessorValueTreeState& t_apvts,
                                  LFO& t_lfo1,
                                  LFO& t_lfo2)
 : apvts(t_apvts)
+, reverbTree(paramTree.getChildWithName(ParamIDs::reverbTree))
 , lfoTree(paramTree.getChildWithName(ParamIDs::lfoTree))
 , lfo1(t_lfo1)
 , lfo2(t_lfo2)
@@ -23,6 +24,10 @@ ReverbProcessor::ReverbProcessor(juce::AudioProcessorValueTreeState& t_apvts,
     ParameterHelper::castParameter (apvts, ParamIDs::reverbDamping, reverbDamping);
     ParameterHelper::castParameter (apvts, ParamIDs::reverbWidth, reverbWidth);
     ParameterHelper::castParameter (apvts, ParamIDs::reverbMix, reverbMix);
+    
+    reverbTree.addListener(this);
+    engine.store(reverbTree[ParamIDs::reverbEngine]);
+    loadImpulseResponse(reverbTree[ParamIDs::reverbImpulseFile]);
 }
 
 void ReverbProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
@@ -33,15 +38,114 @@ void ReverbProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = getTotalNumOutputChannels();
     
+    preparedSpec = spec;
+    
     reverb.prepare(spec);
+    fdnReverb.prepare(spec);
+    convolution.prepare(spec);
+    
+    convolutionMixer.prepare(spec);
+    convolutionMixer.setWetLatency(0.0f);
+    convolutionMixer.setMixingRule(juce::dsp::DryWetMixingRule::linear);
+    
+    fadeBuffer.setSize((int) spec.numChannels, samplesPerBlock);
+    engineFade.reset(sampleRate, engineFadeSeconds);
+    engineFade.setCurrentAndTargetValue(1.0f);
 }
 
 void ReverbProcessor::processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBuffer&)
 {
+    juce::dsp::AudioBlock<float> block (buffer);
+    juce::dsp::ProcessContextReplacing<float> context (block);
+    
+    // the engine being switched to starts from silence rather than a stale tail and fades in over the old one,
+    // and a switch made mid fade waits for it to finish
+    const int newEngine = engine.load();
+    
+    if (newEngine != activeEngine && ! engineFade.isSmoothing())
+    {
+        resetEngine(newEngine);
+        fadingEngine = activeEngine;
+        activeEngine = newEngine;
+        
+        engineFade.setCurrentAndTargetValue(0.0f);
+        engineFade.setTargetValue(1.0f);
+    }
+    
     updateReverb();
     
-    juce::dsp::AudioBlock<float> block (buffer);
-    reverb.process(juce::dsp::ProcessContextReplacing<float> (block));
+    if (! engineFade.isSmoothing())
+    {
+        processEngine(activeEngine, context);
+        return;
+    }
+    
+    jassert (buffer.getNumChannels() <= fadeBuffer.getNumChannels() && buffer.getNumSamples() <= fadeBuffer.getNumSamples());
+    
+    auto fadeBlock = juce::dsp::AudioBlock<float> (fadeBuffer).getSubsetChannelBlock(0, block.getNumChannels())
+                                                              .getSubBlock(0, block.getNumSamples());
+    fadeBlock.copyFrom(block);
+    
+    processEngine(fadingEngine, juce::dsp::ProcessContextReplacing<float> (fadeBlock));
+    processEngine(activeEngine, context);
+    
+    for (size_t sample = 0; sample < block.getNumSamples(); sample++)
+    {
+        const float gain = engineFade.getNextValue();
+        
+        for (size_t channel = 0; channel < block.getNumChannels(); channel++)
+        {
+            float* output = block.getChannelPointer(channel);
+            output[sample] = output[sample] * gain + fadeBlock.getSample((int) channel, (int) sample) * (1.0f - gain);
+        }
+    }
+}
+
+void ReverbProcessor::resetEngine (int engineIndex)
+{
+    if (engineIndex == ParameterHelper::feedbackDelayNetwork)
+        fdnReverb.reset();
+    else if (engineIndex == ParameterHelper::convolution)
+        convolution.reset();
+    else
+        reverb.reset();
+}
+
+void ReverbProcessor::processEngine (int engineIndex, const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    if (engineIndex == ParameterHelper::feedbackDelayNetwork)
+        fdnReverb.process(context);
+    else if (engineIndex == ParameterHelper::convolution)
+        processConvolution(context);
+    else
+        reverb.process(context);
+}
+
+void ReverbProcessor::processConvolution (const juce::dsp::ProcessContextReplacing<float>& context)
+{
+    auto& block = context.getOutputBlock();
+    
+    convolutionMixer.pushDrySamples(block);
+    convolution.process(context);
+    
+    // size and damping are baked into the impulse, width uses the same law as juce::Reverb
+    if (block.getNumChannels() > 1)
+    {
+        const float wet1 = reverbParameters.width * 0.5f + 0.5f;
+        const float wet2 = (1.0f - reverbParameters.width) * 0.5f;
+        float* left = block.getChannelPointer(0);
+        float* right = block.getChannelPointer(1);
+        
+        for (size_t sample = 0; sample < block.getNumSamples(); sample++)
+        {
+            const float l = left[sample], r = right[sample];
+            left[sample] = l * wet1 + r * wet2;
+            right[sample] = r * wet1 + l * wet2;
+        }
+    }
+    
+    convolutionMixer.setWetMixProportion(reverbParameters.wetLevel);
+    convolutionMixer.mixWetSamples(block);
 }
 
 void ReverbProcessor::updateReverb()
@@ -71,5 +175,58 @@ void ReverbProcessor::updateReverb()
                                                lfo2Val);
     reverbParameters.wetLevel = mixVal;
     reverbParameters.dryLevel = 1.0f - mixVal;
-    reverb.setParameters(reverbParameters);
+    
+    // the engine fading out still takes parameter changes until it's silent
+    auto isRunning = [this] (int engineIndex)
+    {
+        return activeEngine == engineIndex || (engineFade.isSmoothing() && fadingEngine == engineIndex);
+    };
+    
+    if (isRunning(ParameterHelper::feedbackDelayNetwork))
+        fdnReverb.setParameters(reverbParameters);
+    
+    if (isRunning(ParameterHelper::freeverb))
+        reverb.setParameters(reverbParameters);
+}
+
+void ReverbProcessor::loadImpulseResponse (const juce::String& filePath)
+{
+    if (filePath.isEmpty())
+        return;
+    
+    const juce::File file (filePath);
+    
+    if (! file.existsAsFile())
+    {
+        DBG("Impulse response not found: " + filePath);
+        return;
+    }
+    
+    // reading, resampling and partitioning all happen off the audio thread, then swap in
+    convolution.loadImpulseResponse(file,
+                                    juce::dsp::Convolution::Stereo::yes,
+                                    juce::dsp::Convolution::Trim::yes,
+                                    0,
+                                    juce::dsp::Convolution::Normalise::yes);
+}
+
+void ReverbProcessor::finishImpulseResponseLoad()
+{
+    // unprepared, there's nothing to finish: the first prepare() does the same
+    if (preparedSpec.sampleRate <= 0.0)
+        return;
+    
+    // Convolution::prepare() fully initialises the impulse from the most recent loadImpulseResponse() before it returns,
+    // so asking again here makes that this patch's file, whatever was still queued, and it's in use from the next process()
+    loadImpulseResponse(reverbTree[ParamIDs::reverbImpulseFile]);
+    convolution.prepare(preparedSpec);
+}
+
+void ReverbProcessor::valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier& property)
+{
+    if (property == ParamIDs::reverbEngine)
+        engine.store(reverbTree[property]);
+    
+    else if (property == ParamIDs::reverbImpulseFile)
+        loadImpulseResponse(reverbTree[property]);
 }
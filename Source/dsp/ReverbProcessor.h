@@ -12,10 +12,12 @@
 
 #include "ProcessorBase.h"
 #include "LFO.h"
+#include "FDNReverb.h"
 #include "../service/ParameterHelper.h"
 #include "../service/ParamIDs.h"
 
 class ReverbProcessor  : public ProcessorBase
+                       , public juce::ValueTree::Listener
 {
 public:
     ReverbProcessor(juce::AudioProcessorValueTreeState& apvts,
@@ -28,10 +30,19 @@ public:
     
     void updateReverb();
     
+    /* queues the file for loading on the convolution's background thread */
+    void loadImpulseResponse (const juce::String& filePath);
+    /* non-realtime, and never while the audio thread is processing: loads the last impulse asked for synchronously,
+       for renders that can't let one land part way through */
+    void finishImpulseResponseLoad();
+    
+    void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property) override;
+    
     const juce::String getName() const override { return "Reverb Processor"; }
     
 private:
     juce::AudioProcessorValueTreeState& apvts;
+    juce::ValueTree reverbTree;
     juce::ValueTree lfoTree;
     LFO& lfo1;
     LFO& lfo2;
@@ -41,8 +52,32 @@ private:
     juce::AudioParameterFloat* reverbWidth { nullptr };
     juce::AudioParameterFloat* reverbMix { nullptr };
     
+    void resetEngine (int engineIndex);
+    void processEngine (int engineIndex, const juce::dsp::ProcessContextReplacing<float>& context);
+    void processConvolution (const juce::dsp::ProcessContextReplacing<float>& context);
+    
     juce::dsp::Reverb reverb;
+    FDNReverb fdnReverb;
     juce::Reverb::Parameters reverbParameters;
+    
+    // every instance loads impulses on the one background thread, rather than starting its own
+    juce::SharedResourcePointer<juce::dsp::ConvolutionMessageQueue> convolutionQueue;
+    
+    juce::dsp::ProcessSpec preparedSpec {};
+    
+    // the head partition keeps the convolution at zero latency, the rest use larger FFTs
+    static constexpr int convolutionHeadSize { 512 };
+    juce::dsp::Convolution convolution { juce::dsp::Convolution::NonUniform { convolutionHeadSize }, *convolutionQueue };
+    juce::dsp::DryWetMixer<float> convolutionMixer;
+    
+    std::atomic<int> engine;
+    int activeEngine { ParameterHelper::freeverb };
+    
+    // on a switch the old engine keeps running on a copy of the input while the new one fades in over it
+    static constexpr double engineFadeSeconds { 0.02 };
+    int fadingEngine { ParameterHelper::freeverb };
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> engineFade;
+    juce::AudioBuffer<float> fadeBuffer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReverbProcessor);
 };
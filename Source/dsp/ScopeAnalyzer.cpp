@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+    ScopeAnalyzer.cpp
+    Created: 20 Oct 2026 6:12:08am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "ScopeAnalyzer.h"
+
+ScopeAnalyzer::ScopeAnalyzer()
+: juce::Thread("Scope Analyzer")
+{
+    history.assign((size_t) historySize, 0.0f);
+    fftData.assign((size_t) fftSize * 2, 0.0f);
+    clearFrame();
+}
+
+ScopeAnalyzer::~ScopeAnalyzer()
+{
+    stopThread(1000);
+}
+
+void ScopeAnalyzer::prepare (double sampleRate, int maximumBlockSize)
+{
+    const juce::ScopedLock sl (stateLock);
+    
+    stopThread(1000);
+    
+    // a few frames of audio, so the ring only overflows if the analysis thread stalls
+    const int ringSize = juce::jmax(juce::roundToInt(sampleRate / framesPerSecond) * 4, maximumBlockSize * 4) + 1;
+    ring.assign((size_t) ringSize, 0.0f);
+    fifo.setTotalSize(ringSize);
+    
+    const float maximumFrequency = juce::jmin(20000.0f, (float) sampleRate * 0.5f);
+    const float binsPerHertz = (float) fftSize / (float) sampleRate;
+    
+    auto bandFrequency = [maximumFrequency] (float band)
+    {
+        return minimumFrequency * std::pow(maximumFrequency / minimumFrequency, band / numSpectrumBands);
+    };
+    
+    for (int band = 0; band <= numSpectrumBands; band++)
+        bandEdges[(size_t) band] = juce::jlimit(1, fftSize / 2, (int) std::ceil(bandFrequency((float) band) * binsPerHertz));
+    
+    for (int band = 0; band < numSpectrumBands; band++)
+        bandCentres[(size_t) band] = juce::jlimit(0.0f, (float) (fftSize / 2 - 1), bandFrequency(band + 0.5f) * binsPerHertz);
+    
+    working.maximumFrequency = maximumFrequency;
+    prepared = true;
+    
+    startIfReady();
+}
+
+void ScopeAnalyzer::release()
+{
+    const juce::ScopedLock sl (stateLock);
+    
+    stopThread(1000);
+    prepared = false;
+}
+
+void ScopeAnalyzer::setActive (bool shouldBeActive)
+{
+    const juce::ScopedLock sl (stateLock);
+    
+    if (shouldBeActive == active.load())
+        return;
+    
+    if (shouldBeActive)
+    {
+        // whatever is left from the last time the panel was open is stale; the reader is stopped, so this is safe
+        fifo.finishedRead(fifo.getNumReady());
+        active.store(true);
+        startIfReady();
+    }
+    else
+    {
+        active.store(false);
+        stopThread(1000);
+    }
+}
+
+void ScopeAnalyzer::startIfReady()
+{
+    if (! prepared || ! active.load())
+        return;
+    
+    clearFrame();
+    startThread(juce::Thread::Priority::low);
+}
+
+void ScopeAnalyzer::pushBlock (const juce::AudioBuffer<float>& buffer) noexcept
+{
+    if (! active.load(std::memory_order_relaxed))
+        return;
+    
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
+    
+    // a full ring drops the block; the scope just misses a few milliseconds
+    if (numChannels == 0 || numSamples > fifo.getFreeSpace())
+        return;
+    
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+    
+    const float gain = 1.0f / numChannels;
+    
+    auto mixInto = [&buffer, numChannels, gain] (float* destination, int offset, int size)
+    {
+        if (size <= 0)
+            return;
+        
+        juce::FloatVectorOperations::copyWithMultiply(destination, buffer.getReadPointer(0, offset), gain, size);
+        
+        for (int channel = 1; channel < numChannels; channel++)
+            juce::FloatVectorOperations::addWithMultiply(destination, buffer.getReadPointer(channel, offset), gain, size);
+    };
+    
+    mixInto(ring.data() + start1, 0, size1);
+    mixInto(ring.data() + start2, size1, size2);
+    
+    fifo.finishedWrite(size1 + size2);
+}
+
+bool ScopeAnalyzer::getLatestFrame (Frame& destination) const
+{
+    const juce::ScopedLock sl (frameLock);
+    
+    if (destination.serial == latest.serial)
+        return false;
+    
+    destination = latest;
+    return true;
+}
+
+void ScopeAnalyzer::run()
+{
+    double lastFrameTime = juce::Time::getMillisecondCounterHiRes();
+    
+    while (! threadShouldExit())
+    {
+        if (drainRing())
+        {
+            const double now = juce::Time::getMillisecondCounterHiRes();
+            
+            analyseScope();
+            analyseSpectrum((float) ((now - lastFrameTime) * 0.001));
+            lastFrameTime = now;
+            
+            working.serial++;
+            
+            const juce::ScopedLock sl (frameLock);
+            latest = working;
+        }
+        
+        wait(1000 / framesPerSecond);
+    }
+}
+
+bool ScopeAnalyzer::drainRing()
+{
+    const int numReady = fifo.getNumReady();
+    
+    if (numReady == 0)
+        return false;
+    
+    // only the newest historySize samples are ever looked at
+    const int numSkipped = juce::jmax(0, numReady - historySize);
+    fifo.finishedRead(numSkipped);
+    
+    const int numNew = numReady - numSkipped;
+    std::move(history.begin() + numNew, history.end(), history.begin());
+    
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(numNew, start1, size1, start2, size2);
+    
+    float* destination = history.data() + historySize - numNew;
+    std::copy(ring.data() + start1, ring.data() + start1 + size1, destination);
+    std::copy(ring.data() + start2, ring.data() + start2 + size2, destination + size1);
+    
+    fifo.finishedRead(size1 + size2);
+    return true;
+}
+
+void ScopeAnalyzer::analyseScope()
+{
+    // the latest rising zero crossing that still leaves a whole scope after it, so periodic sounds hold still;
+    // without one the scope free runs on the newest audio
+    int start = historySize - scopeLength;
+    
+    for (int i = historySize - scopeLength; i > 0; i--)
+    {
+        if (history[(size_t) i - 1] <= 0.0f && history[(size_t) i] > 0.0f)
+        {
+            start = i;
+            break;
+        }
+    }
+    
+    constexpr int samplesPerColumn = scopeLength / numScopeColumns;
+    
+    for (int column = 0; column < numScopeColumns; column++)
+    {
+        const auto range = juce::FloatVectorOperations::findMinAndMax(history.data() + start + column * samplesPerColumn, samplesPerColumn);
+        
+        working.scopeMinimums[(size_t) column] = juce::jlimit(-1.0f, 1.0f, range.getStart());
+        working.scopeMaximums[(size_t) column] = juce::jlimit(-1.0f, 1.0f, range.getEnd());
+    }
+}
+
+void ScopeAnalyzer::analyseSpectrum (float elapsedSeconds)
+{
+    std::copy(history.end() - fftSize, history.end(), fftData.begin());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+    
+    // the window is normalised to unit gain, so a full scale sine peaks at fftSize / 2
+    const float magnitudeScale = 2.0f / fftSize;
+    
+    for (int band = 0; band < numSpectrumBands; band++)
+    {
+        const int first = bandEdges[(size_t) band], last = bandEdges[(size_t) band + 1];
+        float magnitude;
+        
+        if (last - first > 1)
+        {
+            magnitude = juce::FloatVectorOperations::findMaximum(fftData.data() + first, last - first);
+        }
+        else
+        {
+            const float position = bandCentres[(size_t) band];
+            const int bin = (int) position;
+            magnitude = fftData[(size_t) bin] + (position - bin) * (fftData[(size_t) bin + 1] - fftData[(size_t) bin]);
+        }
+        
+        const float level = juce::Decibels::gainToDecibels(magnitude * magnitudeScale, minimumDecibels);
+        
+        // rises at once and falls back smoothly
+        float& smoothed = working.spectrum[(size_t) band];
+        smoothed = level > smoothed ? level : smoothed + (level - smoothed) * releasePerFrame;
+        
+        float& peak = working.spectrumPeaks[(size_t) band];
+        float& holdLeft = peakHoldLeft[(size_t) band];
+        
+        if (smoothed >= peak)
+        {
+            peak = smoothed;
+            holdLeft = peakHoldSeconds;
+        }
+        else if (holdLeft > 0.0f)
+        {
+            holdLeft -= elapsedSeconds;
+        }
+        else
+        {
+            peak = juce::jmax(smoothed, peak - peakFallDecibelsPerSecond * elapsedSeconds);
+        }
+    }
+}
+
+void ScopeAnalyzer::clearFrame()
+{
+    std::fill(history.begin(), history.end(), 0.0f);
+    
+    working.scopeMinimums.fill(0.0f);
+    working.scopeMaximums.fill(0.0f);
+    working.spectrum.fill(minimumDecibels);
+    working.spectrumPeaks.fill(minimumDecibels);
+    working.serial++;
+    peakHoldLeft.fill(0.0f);
+    
+    const juce::ScopedLock sl (frameLock);
+    latest = working;
+}
@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    ScopeAnalyzer.h
+    Created: 20 Oct 2026 6:12:08am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    The data behind the editor's analyzer panel: a triggered oscilloscope and
+    a spectrum with peak hold, both of the output summed to mono.
+    
+    The audio thread only mixes each block into a lock-free ring. A low
+    priority thread drains it at display rate and does the rest: finding a
+    rising zero crossing to trigger on, min/max decimating the scope to one
+    pair per column, and the windowed FFT, log-spaced bands, smoothing and
+    peak hold. Each finished frame is copied out under a lock the audio
+    thread never touches.
+    
+    Nothing runs until the panel calls setActive(true): the thread isn't
+    started and pushBlock() returns after one relaxed atomic load.
+*/
+class ScopeAnalyzer  : private juce::Thread
+{
+public:
+    static constexpr int numScopeColumns { 256 };
+    static constexpr int numSpectrumBands { 192 };
+    static constexpr int framesPerSecond { 30 };
+    
+    static constexpr float minimumFrequency { 20.0f };
+    static constexpr float minimumDecibels { -96.0f };
+    
+    struct Frame
+    {
+        // scope columns span [-1, 1]; spectrum bands are in decibels, log-spaced from minimumFrequency to maximumFrequency
+        std::array<float, numScopeColumns> scopeMinimums {}, scopeMaximums {};
+        std::array<float, numSpectrumBands> spectrum {}, spectrumPeaks {};
+        float maximumFrequency { 20000.0f };
+        uint32_t serial { 0 };
+    };
+    
+    ScopeAnalyzer();
+    ~ScopeAnalyzer() override;
+    
+    void prepare (double sampleRate, int maximumBlockSize);
+    void release();
+    
+    /* message thread; the panel turns analysis on while it's open */
+    void setActive (bool shouldBeActive);
+    
+    /* audio thread; never blocks or allocates */
+    void pushBlock (const juce::AudioBuffer<float>& buffer) noexcept;
+    
+    /* message thread; copies the newest frame into destination, unless destination already holds it */
+    bool getLatestFrame (Frame& destination) const;
+
+private:
+    static constexpr int fftOrder { 12 };
+    static constexpr int fftSize { 1 << fftOrder };
+    static constexpr int scopeLength { 2048 };
+    static constexpr int triggerSearchLength { 2048 };
+    static constexpr int historySize { scopeLength + triggerSearchLength };
+    
+    static constexpr float releasePerFrame { 0.35f };
+    static constexpr float peakHoldSeconds { 1.5f };
+    static constexpr float peakFallDecibelsPerSecond { 24.0f };
+    
+    void run() override;
+    
+    void startIfReady();
+    bool drainRing();
+    void analyseScope();
+    void analyseSpectrum (float elapsedSeconds);
+    void clearFrame();
+    
+    juce::CriticalSection stateLock;
+    std::atomic<bool> active { false };
+    bool prepared { false };
+    
+    juce::AbstractFifo fifo { 1 };
+    std::vector<float> ring;
+    
+    // the newest historySize samples, oldest first
+    std::vector<float> history;
+    
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann, true };
+    std::vector<float> fftData;
+    
+    // fft bins spanned by each band; bands narrower than a bin interpolate at bandCentres instead
+    std::array<int, numSpectrumBands + 1> bandEdges {};
+    std::array<float, numSpectrumBands> bandCentres {};
+    std::array<float, numSpectrumBands> peakHoldLeft {};
+    
+    Frame working;
+    Frame latest;
+    juce::CriticalSection frameLock;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScopeAnalyzer);
+};
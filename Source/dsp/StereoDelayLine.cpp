@@ -0,0 +1,591 @@
+/*
+  ==============================================================================
+
+    StereoDelayLine.cpp
+    Created: 19 Oct 2026 10:12:41am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "StereoDelayLine.h"
+
+namespace
+{
+    // 16 bit frames cover +-8.0 so feedback sums above full scale don't clip
+    constexpr float fixedHeadroom = 8.0f;
+
+    inline float load (float sample) noexcept    { return sample; }
+    inline float load (int16_t sample) noexcept  { return (float) sample * (fixedHeadroom / 32767.0f); }
+
+    inline void store (float& dest, float sample) noexcept    { dest = sample; }
+    inline void store (int16_t& dest, float sample) noexcept
+    {
+        dest = (int16_t) std::lrint(juce::jlimit(-32767.0f, 32767.0f, sample * (32767.0f / fixedHeadroom)));
+    }
+
+    inline int wrapFrame (int frame, int numFrames) noexcept
+    {
+        if (frame < 0)
+            return frame + numFrames;
+        if (frame >= numFrames)
+            return frame - numFrames;
+        return frame;
+    }
+
+    struct LagrangeTaps
+    {
+        LagrangeTaps (float delay) noexcept
+        {
+            // same split as juce::dsp::DelayLine so the fractional part sits in [1, 2)
+            delayInt = (int) std::floor(delay);
+            delayFrac = delay - (float) delayInt;
+
+            if (delayInt >= 1)
+            {
+                delayFrac += 1.0f;
+                delayInt -= 1;
+            }
+
+            const float d1 = delayFrac - 1.0f, d2 = delayFrac - 2.0f, d3 = delayFrac - 3.0f;
+
+            c1 = -d1 * d2 * d3 / 6.0f;
+            c2 = d2 * d3 * 0.5f * delayFrac;
+            c3 = -d1 * d3 * 0.5f * delayFrac;
+            c4 = d1 * d2 / 6.0f * delayFrac;
+        }
+
+        int delayInt;
+        float delayFrac, c1, c2, c3, c4;
+    };
+}
+
+StereoDelayLine::~StereoDelayLine()
+{
+    delete pendingStorage.exchange(nullptr);
+    delete retiredStorage.exchange(nullptr);
+}
+
+void StereoDelayLine::prepare (const juce::dsp::ProcessSpec& spec)
+{
+    jassert (spec.numChannels <= 2);
+
+    maximumBlockSize.store((int) spec.maximumBlockSize);
+    delayTimes.setSize(2, (int) spec.maximumBlockSize);
+    reset();
+}
+
+void StereoDelayLine::reset()
+{
+    if (storage != nullptr)
+    {
+        std::fill(storage->floatFrames.begin(), storage->floatFrames.end(), 0.0f);
+        std::fill(storage->fixedFrames.begin(), storage->fixedFrames.end(), (int16_t) 0);
+    }
+
+    // silence needs no carrying over, so a ring being filled is ready as soon as it's cleared
+    if (migration.ring != nullptr)
+    {
+        std::fill(migration.ring->floatFrames.begin(), migration.ring->floatFrames.end(), 0.0f);
+        std::fill(migration.ring->fixedFrames.begin(), migration.ring->fixedFrames.end(), (int16_t) 0);
+        migration.numCopied = migration.numToCopy;
+        migration.writeFrame = 0;
+    }
+
+    writeFrame = 0;
+}
+
+void StereoDelayLine::setMaximumDelayInSamples (int maxDelayInSamples, StorageFormat format)
+{
+    jassert (maxDelayInSamples >= 0);
+
+    // the owner's reserveDelay() timer keeps running through a re-prepare
+    const juce::ScopedLock sl (reserveLock);
+
+    migration = Migration();
+    delete pendingStorage.exchange(nullptr);
+    delete retiredStorage.exchange(nullptr);
+
+    storage = std::make_unique<RingStorage>(maxDelayInSamples, maximumBlockSize.load(), format);
+    maximumDelay.store(maxDelayInSamples);
+    storageFormat.store(format);
+    writeFrame = 0;
+
+    // a re-prepare can shrink the ring under a delay that was set for the old one
+    limitDelays();
+}
+
+void StereoDelayLine::reserveDelay (int delayInSamples, int delayLimitInSamples, StorageFormat format)
+{
+    const juce::ScopedLock sl (reserveLock);
+
+    // anything the audio thread has swapped out since last time is freed here
+    delete retiredStorage.exchange(nullptr);
+
+    if (pendingStorage.load() != nullptr)
+        return;
+
+    const int currentMaximum = maximumDelay.load();
+    const bool needsGrowth = delayInSamples > currentMaximum;
+
+    if (! needsGrowth && format == storageFormat.load())
+        return;
+
+    // grow by at least half again so a slowly turned knob doesn't reallocate every tick
+    const int newMaximum = needsGrowth ? juce::jmin(juce::jmax(delayInSamples, currentMaximum + currentMaximum / 2), delayLimitInSamples)
+                                       : currentMaximum;
+
+    pendingStorage.store(new RingStorage(newMaximum, maximumBlockSize.load(), format));
+}
+
+void StereoDelayLine::setSmoothingTime (double sampleRate, float smoothingTimeInSeconds)
+{
+    const int numSteps = (int) std::floor(sampleRate * smoothingTimeInSeconds);
+
+    leftRamp.reset(numSteps);
+    rightRamp.reset(numSteps);
+
+    for (auto& tap : tapStates)
+        tap.delay.reset(numSteps);
+}
+
+void StereoDelayLine::setTargetDelay (float leftDelayInSamples, float rightDelayInSamples)
+{
+    // until a larger ring arrives the delay is held at the longest one that fits
+    const float maxDelay = (float) juce::jmax(1, maximumDelay.load());
+
+    leftRamp.setTarget(std::round(juce::jlimit(1.0f, maxDelay, leftDelayInSamples)));
+    rightRamp.setTarget(std::round(juce::jlimit(1.0f, maxDelay, rightDelayInSamples)));
+}
+
+void StereoDelayLine::setTapTargets (const Tap* taps, int numTaps)
+{
+    const float maxDelay = (float) juce::jmax(1, maximumDelay.load());
+
+    for (int i = 0; i < maxTaps; i++)
+    {
+        TapState& state = tapStates[(size_t) i];
+
+        if (i < numTaps)
+        {
+            state.delay.setTarget(std::round(juce::jlimit(1.0f, maxDelay, taps[i].delayInSamples)));
+            state.leftGainTarget = taps[i].leftGain;
+            state.rightGainTarget = taps[i].rightGain;
+        }
+        else
+        {
+            state.leftGainTarget = 0.0f;
+            state.rightGainTarget = 0.0f;
+        }
+    }
+}
+
+void StereoDelayLine::readBlock (float* leftOut, float* rightOut, int numSamples)
+{
+    jassert (numSamples <= delayTimes.getNumSamples());
+
+    adoptPendingStorage();
+
+    if (storage == nullptr)
+    {
+        juce::FloatVectorOperations::clear(leftOut, numSamples);
+        juce::FloatVectorOperations::clear(rightOut, numSamples);
+        return;
+    }
+
+    const bool isFixed = storage->format == StorageFormat::int16;
+
+    if (isSettled())
+    {
+        if (isFixed)
+            readWhole(storage->fixedFrames.data(), leftOut, rightOut, numSamples);
+        else
+            readWhole(storage->floatFrames.data(), leftOut, rightOut, numSamples);
+        return;
+    }
+
+    const bool linked = leftRamp.current == rightRamp.current
+                     && leftRamp.target == rightRamp.target
+                     && leftRamp.countdown == rightRamp.countdown;
+
+    leftRamp.fill(delayTimes.getWritePointer(0), numSamples);
+    rightRamp.fill(delayTimes.getWritePointer(1), numSamples);
+
+    if (linked && isFixed)
+        readInterpolatedLinked(storage->fixedFrames.data(), leftOut, rightOut, numSamples);
+    else if (linked)
+        readInterpolatedLinked(storage->floatFrames.data(), leftOut, rightOut, numSamples);
+    else if (isFixed)
+        readInterpolated(storage->fixedFrames.data(), leftOut, rightOut, numSamples);
+    else
+        readInterpolated(storage->floatFrames.data(), leftOut, rightOut, numSamples);
+}
+
+void StereoDelayLine::readTaps (float* leftOut, float* rightOut, int numSamples)
+{
+    jassert (numSamples <= delayTimes.getNumSamples());
+
+    if (storage == nullptr)
+        return;
+
+    for (auto& tap : tapStates)
+    {
+        // silent taps cost nothing, but still have to follow their delay target
+        if (tap.leftGain == 0.0f && tap.rightGain == 0.0f
+            && tap.leftGainTarget == 0.0f && tap.rightGainTarget == 0.0f)
+        {
+            tap.delay.skip(numSamples);
+            continue;
+        }
+
+        if (storage->format == StorageFormat::int16)
+            readTap(storage->fixedFrames.data(), tap, leftOut, rightOut, numSamples);
+        else
+            readTap(storage->floatFrames.data(), tap, leftOut, rightOut, numSamples);
+    }
+}
+
+void StereoDelayLine::writeBlock (const float* leftIn, const float* rightIn, int numSamples)
+{
+    if (storage == nullptr)
+        return;
+
+    writeFrame = writeRing(*storage, writeFrame, leftIn, rightIn, numSamples);
+
+    // the new ring has to keep up with the old one until the swap
+    if (migration.ring != nullptr)
+    {
+        migration.writeFrame = writeRing(*migration.ring, migration.writeFrame, leftIn, rightIn, numSamples);
+        migration.numWritten += numSamples;
+    }
+}
+
+/* ----- STORAGE ----- */
+
+StereoDelayLine::RingStorage::RingStorage (int maxDelayInSamples, int minimumFrames, StorageFormat t_format)
+: format(t_format)
+, maxDelay(maxDelayInSamples)
+, numFrames(juce::jmax(maxDelayInSamples + 4, minimumFrames + 1))
+{
+    const size_t numValues = (size_t) (numFrames + guardFrames) * 2;
+
+    if (format == StorageFormat::int16)
+        fixedFrames.assign(numValues, 0);
+    else
+        floatFrames.assign(numValues, 0.0f);
+}
+
+void StereoDelayLine::adoptPendingStorage()
+{
+    if (migration.ring != nullptr)
+    {
+        continueMigration();
+        return;
+    }
+
+    // the previous ring has to be collected before another swap can happen
+    if (retiredStorage.load() != nullptr)
+        return;
+
+    RingStorage* incoming = pendingStorage.load();
+
+    if (incoming == nullptr)
+        return;
+
+    if (storage == nullptr)
+    {
+        storage.reset(pendingStorage.exchange(nullptr));
+        maximumDelay.store(storage->maxDelay);
+        storageFormat.store(storage->format);
+        writeFrame = 0;
+        return;
+    }
+
+    // keeps the most recent frames in order so echoes already in flight survive the swap;
+    // they go to [0, numToCopy) in the new ring and new writes carry on from numToCopy
+    migration.ring = incoming;
+    migration.numToCopy = juce::jmin(storage->numFrames, incoming->numFrames);
+    migration.sourceStart = wrapFrame(writeFrame - migration.numToCopy, storage->numFrames);
+    migration.writeFrame = migration.numToCopy % incoming->numFrames;
+    migration.numCopied = 0;
+    migration.numWritten = 0;
+
+    continueMigration();
+}
+
+void StereoDelayLine::continueMigration()
+{
+    const RingStorage& source = *storage;
+    RingStorage& dest = *migration.ring;
+
+    // frames older than what's been written since the start are already overwritten in one ring or the other
+    const int firstFrame = juce::jmin(juce::jmax(migration.numCopied, migration.numWritten), migration.numToCopy);
+    const int lastFrame = juce::jmin(firstFrame + framesCopiedPerBlock, migration.numToCopy);
+    int sourceFrame = wrapFrame(migration.sourceStart + firstFrame, source.numFrames);
+
+    for (int frame = firstFrame; frame < lastFrame; frame++)
+    {
+        for (int channel = 0; channel < 2; channel++)
+        {
+            const float sample = source.format == StorageFormat::int16 ? load(source.fixedFrames[(size_t) sourceFrame * 2 + channel])
+                                                                       : load(source.floatFrames[(size_t) sourceFrame * 2 + channel]);
+
+            if (dest.format == StorageFormat::int16)
+                store(dest.fixedFrames[(size_t) frame * 2 + channel], sample);
+            else
+                store(dest.floatFrames[(size_t) frame * 2 + channel], sample);
+        }
+
+        if (++sourceFrame == source.numFrames)
+            sourceFrame = 0;
+    }
+
+    if (firstFrame < RingStorage::guardFrames)
+    {
+        for (int i = 0; i < RingStorage::guardFrames * 2; i++)
+        {
+            const size_t mirrored = (size_t) dest.numFrames * 2 + i;
+
+            if (dest.format == StorageFormat::int16)
+                dest.fixedFrames[mirrored] = dest.fixedFrames[(size_t) i];
+            else
+                dest.floatFrames[mirrored] = dest.floatFrames[(size_t) i];
+        }
+    }
+
+    migration.numCopied = lastFrame;
+
+    if (migration.numCopied < migration.numToCopy)
+        return;
+
+    // everything in flight is across, so reads can move over
+    maximumDelay.store(dest.maxDelay);
+    storageFormat.store(dest.format);
+    retiredStorage.store(storage.release());
+    storage.reset(pendingStorage.exchange(nullptr));
+    writeFrame = migration.writeFrame;
+    migration = Migration();
+
+    jassert (storage.get() == &dest);
+}
+
+void StereoDelayLine::limitDelays()
+{
+    const float maxDelay = (float) juce::jmax(1, maximumDelay.load());
+
+    leftRamp.limitTo(maxDelay);
+    rightRamp.limitTo(maxDelay);
+
+    for (auto& tap : tapStates)
+        tap.delay.limitTo(maxDelay);
+}
+
+/* ----- READ PATHS ----- */
+
+template <typename SampleType>
+void StereoDelayLine::readInterpolated (const SampleType* data, float* leftOut, float* rightOut, int numSamples)
+{
+    const int numFrames = storage->numFrames;
+    const float* leftDelays = delayTimes.getReadPointer(0);
+    const float* rightDelays = delayTimes.getReadPointer(1);
+
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        const LagrangeTaps left (leftDelays[sample]);
+        const LagrangeTaps right (rightDelays[sample]);
+
+        // oldest tap first, the guard frames keep the following three contiguous
+        const SampleType* l = data + wrapFrame(writeFrame + sample - left.delayInt - 3, numFrames) * 2;
+        const SampleType* r = data + wrapFrame(writeFrame + sample - right.delayInt - 3, numFrames) * 2 + 1;
+
+        leftOut[sample]  = load(l[6]) * left.c1 + load(l[4]) * left.c2 + load(l[2]) * left.c3 + load(l[0]) * left.c4;
+        rightOut[sample] = load(r[6]) * right.c1 + load(r[4]) * right.c2 + load(r[2]) * right.c3 + load(r[0]) * right.c4;
+    }
+}
+
+template <typename SampleType>
+void StereoDelayLine::readInterpolatedLinked (const SampleType* data, float* leftOut, float* rightOut, int numSamples)
+{
+    // both channels share one set of taps, and each tap is one adjacent L/R pair
+    const int numFrames = storage->numFrames;
+    const float* delays = delayTimes.getReadPointer(0);
+
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        const LagrangeTaps taps (delays[sample]);
+        const SampleType* f = data + wrapFrame(writeFrame + sample - taps.delayInt - 3, numFrames) * 2;
+
+        leftOut[sample]  = load(f[6]) * taps.c1 + load(f[4]) * taps.c2 + load(f[2]) * taps.c3 + load(f[0]) * taps.c4;
+        rightOut[sample] = load(f[7]) * taps.c1 + load(f[5]) * taps.c2 + load(f[3]) * taps.c3 + load(f[1]) * taps.c4;
+    }
+}
+
+template <typename SampleType>
+void StereoDelayLine::readWhole (const SampleType* data, float* leftOut, float* rightOut, int numSamples)
+{
+    const int numFrames = storage->numFrames;
+    float* outputs[] = { leftOut, rightOut };
+    const int delays[] = { (int) leftRamp.current, (int) rightRamp.current };
+
+    for (int channel = 0; channel < 2; channel++)
+    {
+        float* out = outputs[channel];
+        int frame = wrapFrame(writeFrame - delays[channel], numFrames);
+        int sample = 0;
+
+        // copy in runs between wrap points so the inner loop carries no wrap check
+        while (sample < numSamples)
+        {
+            const int runLength = juce::jmin(numSamples - sample, numFrames - frame);
+            const SampleType* src = data + frame * 2 + channel;
+
+            for (int i = 0; i < runLength; i++)
+                out[sample + i] = load(src[i * 2]);
+
+            sample += runLength;
+            frame = 0;
+        }
+    }
+}
+
+template <typename SampleType>
+void StereoDelayLine::readTap (const SampleType* data, TapState& tap, float* leftOut, float* rightOut, int numSamples)
+{
+    const int numFrames = storage->numFrames;
+
+    // gains move linearly across the block to avoid zipper noise
+    const float leftStep = (tap.leftGainTarget - tap.leftGain) / (float) numSamples;
+    const float rightStep = (tap.rightGainTarget - tap.rightGain) / (float) numSamples;
+    float leftGain = tap.leftGain, rightGain = tap.rightGain;
+
+    if (tap.delay.isSettled())
+    {
+        int frame = wrapFrame(writeFrame - (int) tap.delay.current, numFrames);
+        int sample = 0;
+
+        while (sample < numSamples)
+        {
+            const int runLength = juce::jmin(numSamples - sample, numFrames - frame);
+            const SampleType* src = data + frame * 2;
+
+            for (int i = 0; i < runLength; i++)
+            {
+                leftGain += leftStep;
+                rightGain += rightStep;
+                leftOut[sample + i] += load(src[i * 2]) * leftGain;
+                rightOut[sample + i] += load(src[i * 2 + 1]) * rightGain;
+            }
+
+            sample += runLength;
+            frame = 0;
+        }
+    }
+    else
+    {
+        float* delays = delayTimes.getWritePointer(0);
+        tap.delay.fill(delays, numSamples);
+
+        for (int sample = 0; sample < numSamples; sample++)
+        {
+            const LagrangeTaps taps (delays[sample]);
+            const SampleType* f = data + wrapFrame(writeFrame + sample - taps.delayInt - 3, numFrames) * 2;
+
+            leftGain += leftStep;
+            rightGain += rightStep;
+            leftOut[sample]  += (load(f[6]) * taps.c1 + load(f[4]) * taps.c2 + load(f[2]) * taps.c3 + load(f[0]) * taps.c4) * leftGain;
+            rightOut[sample] += (load(f[7]) * taps.c1 + load(f[5]) * taps.c2 + load(f[3]) * taps.c3 + load(f[1]) * taps.c4) * rightGain;
+        }
+    }
+
+    tap.leftGain = tap.leftGainTarget;
+    tap.rightGain = tap.rightGainTarget;
+}
+
+int StereoDelayLine::writeRing (RingStorage& ring, int frame, const float* leftIn, const float* rightIn, int numSamples)
+{
+    if (ring.format == StorageFormat::int16)
+        return write(ring.fixedFrames.data(), ring.numFrames, frame, leftIn, rightIn, numSamples);
+
+    return write(ring.floatFrames.data(), ring.numFrames, frame, leftIn, rightIn, numSamples);
+}
+
+template <typename SampleType>
+int StereoDelayLine::write (SampleType* data, int numFrames, int frame, const float* leftIn, const float* rightIn, int numSamples)
+{
+    for (int sample = 0; sample < numSamples; sample++)
+    {
+        store(data[frame * 2], leftIn[sample]);
+        store(data[frame * 2 + 1], rightIn[sample]);
+
+        if (frame < RingStorage::guardFrames)
+        {
+            data[(numFrames + frame) * 2] = data[frame * 2];
+            data[(numFrames + frame) * 2 + 1] = data[frame * 2 + 1];
+        }
+
+        if (++frame == numFrames)
+            frame = 0;
+    }
+
+    return frame;
+}
+
+/* ----- DELAY RAMP ----- */
+
+void StereoDelayLine::DelayRamp::reset (int numSteps) noexcept
+{
+    stepsToTarget = numSteps;
+    current = target;
+    countdown = 0;
+}
+
+void StereoDelayLine::DelayRamp::setTarget (float newTarget) noexcept
+{
+    if (newTarget == target)
+        return;
+
+    target = newTarget;
+
+    if (stepsToTarget <= 0)
+    {
+        current = target;
+        countdown = 0;
+        return;
+    }
+
+    countdown = stepsToTarget;
+    step = (target - current) / (float) countdown;
+}
+
+void StereoDelayLine::DelayRamp::fill (float* dest, int numSamples) noexcept
+{
+    const int rampLength = juce::jmin(countdown, numSamples);
+
+    for (int i = 0; i < rampLength; i++)
+        dest[i] = current + step * (float) (i + 1);
+
+    countdown -= rampLength;
+    current = countdown == 0 ? target : current + step * (float) rampLength;
+
+    if (rampLength < numSamples)
+        juce::FloatVectorOperations::fill(dest + rampLength, current, numSamples - rampLength);
+}
+
+void StereoDelayLine::DelayRamp::skip (int numSamples) noexcept
+{
+    const int rampLength = juce::jmin(countdown, numSamples);
+
+    countdown -= rampLength;
+    current = countdown == 0 ? target : current + step * (float) rampLength;
+}
+
+void StereoDelayLine::DelayRamp::limitTo (float maxDelay) noexcept
+{
+    target = juce::jmin(target, maxDelay);
+    current = juce::jmin(current, maxDelay);
+
+    if (countdown > 0)
+        step = (target - current) / (float) countdown;
+    else
+        current = target;
+}
@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    StereoDelayLine.h
+    Created: 19 Oct 2026 10:12:41am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    Stereo delay engine with a single interleaved ring buffer (L R L R ...).
+    Reads and writes happen a whole block at a time; delay times are ramped
+    linearly per block and read with 3rd order Lagrange interpolation, the
+    same interpolation as juce::dsp::DelayLine<float, Lagrange3rd>. When both
+    channels are settled on a whole number of samples the interpolation is
+    skipped entirely.
+
+    Up to maxTaps extra read heads can gather from the same ring, each with
+    its own delay ramp and left/right gains.
+
+    Storage is only as long as the owner asks for. Growing it (or switching
+    to 16 bit storage) is done with reserveDelay() off the audio thread. The
+    audio thread then carries the echoes already in flight over to the new
+    ring a bounded number of frames per block, writing to both rings in the
+    meantime, and only reads from the new one once everything is across.
+*/
+class StereoDelayLine
+{
+public:
+    enum class StorageFormat { float32, int16 };
+
+    struct Tap
+    {
+        float delayInSamples { 0.0f };
+        float leftGain { 0.0f };
+        float rightGain { 0.0f };
+    };
+    
+    static constexpr int maxTaps { 8 };
+
+    StereoDelayLine() = default;
+    ~StereoDelayLine();
+
+    void prepare (const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    /* allocates immediately, only call while the audio thread is stopped; safe against a concurrent reserveDelay() */
+    void setMaximumDelayInSamples (int maxDelayInSamples, StorageFormat format = StorageFormat::float32);
+
+    /* call from a non-realtime thread; grows the ring (never shrinks) or converts its format */
+    void reserveDelay (int delayInSamples, int delayLimitInSamples, StorageFormat format);
+
+    int getMaximumDelayInSamples() const noexcept { return maximumDelay.load(); }
+
+    void setSmoothingTime (double sampleRate, float smoothingTimeInSeconds);
+
+    /* targets are rounded to whole samples so a settled delay can take the fast path */
+    void setTargetDelay (float leftDelayInSamples, float rightDelayInSamples);
+
+    /* taps beyond numTaps are faded out */
+    void setTapTargets (const Tap* taps, int numTaps);
+
+    /* must be called before writeBlock for the same block */
+    void readBlock (float* leftOut, float* rightOut, int numSamples);
+
+    /* adds every audible tap into the outputs; call after readBlock and before writeBlock */
+    void readTaps (float* leftOut, float* rightOut, int numSamples);
+    void writeBlock (const float* leftIn, const float* rightIn, int numSamples);
+
+    bool isSettled() const noexcept { return leftRamp.isSettled() && rightRamp.isSettled(); }
+
+private:
+    struct DelayRamp
+    {
+        void reset (int numSteps) noexcept;
+        void setTarget (float newTarget) noexcept;
+        void fill (float* dest, int numSamples) noexcept;
+        void skip (int numSamples) noexcept;
+        void limitTo (float maxDelay) noexcept;
+        bool isSettled() const noexcept { return countdown == 0; }
+
+        float current { 0.0f }, target { 0.0f }, step { 0.0f };
+        int countdown { 0 }, stepsToTarget { 0 };
+    };
+
+    struct TapState
+    {
+        DelayRamp delay;
+        float leftGain { 0.0f }, rightGain { 0.0f };
+        float leftGainTarget { 0.0f }, rightGainTarget { 0.0f };
+    };
+
+    struct RingStorage
+    {
+        RingStorage (int maxDelayInSamples, int minimumFrames, StorageFormat format);
+
+        // the first guardFrames frames are mirrored past the end so interpolator taps never wrap
+        static constexpr int guardFrames { 3 };
+
+        const StorageFormat format;
+        const int maxDelay;
+        const int numFrames;
+        std::vector<float> floatFrames;
+        std::vector<int16_t> fixedFrames;
+    };
+
+    /* a pending ring stays in pendingStorage while it's filled, so reserveDelay() can't queue another behind it */
+    struct Migration
+    {
+        RingStorage* ring { nullptr };
+        int writeFrame { 0 };
+        int sourceStart { 0 };
+        int numToCopy { 0 };
+        int numCopied { 0 };
+        int numWritten { 0 };
+    };
+
+    // a 3 second ring at 192 kHz comes across in about 35 blocks
+    static constexpr int framesCopiedPerBlock { 16384 };
+
+    void adoptPendingStorage();
+    void continueMigration();
+    void limitDelays();
+
+    template <typename SampleType>
+    void readInterpolated (const SampleType* data, float* leftOut, float* rightOut, int numSamples);
+    template <typename SampleType>
+    void readInterpolatedLinked (const SampleType* data, float* leftOut, float* rightOut, int numSamples);
+    template <typename SampleType>
+    void readWhole (const SampleType* data, float* leftOut, float* rightOut, int numSamples);
+    template <typename SampleType>
+    void readTap (const SampleType* data, TapState& tap, float* leftOut, float* rightOut, int numSamples);
+    template <typename SampleType>
+    static int write (SampleType* data, int numFrames, int frame, const float* leftIn, const float* rightIn, int numSamples);
+    static int writeRing (RingStorage& ring, int frame, const float* leftIn, const float* rightIn, int numSamples);
+
+    std::unique_ptr<RingStorage> storage;
+    std::atomic<RingStorage*> pendingStorage { nullptr };
+    std::atomic<RingStorage*> retiredStorage { nullptr };
+    std::atomic<int> maximumDelay { 0 };
+    std::atomic<StorageFormat> storageFormat { StorageFormat::float32 };
+    Migration migration;
+
+    // the audio thread never takes this; it keeps reserveDelay() and setMaximumDelayInSamples() from freeing each other's rings
+    juce::CriticalSection reserveLock;
+
+    int writeFrame { 0 };
+    std::atomic<int> maximumBlockSize { 0 };
+
+    DelayRamp leftRamp, rightRamp;
+    std::array<TapState, maxTaps> tapStates;
+    juce::AudioBuffer<float> delayTimes;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StereoDelayLine);
+};
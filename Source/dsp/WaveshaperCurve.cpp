@@ -0,0 +1,261 @@
+/*
+  ==============================================================================
+
+    WaveshaperCurve.cpp
+    Created: 19 Oct 2026 8:02:36pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "WaveshaperCurve.h"
+
+namespace
+{
+    using FloatVector = juce::dsp::SIMDRegister<float>;
+
+    // every exponent the curve takes is a slope of at most 10 times a position in [0, 1]
+    constexpr float maxExponent { 10.0f };
+
+    inline float clampExponent (float x) noexcept
+    {
+        return juce::jlimit(-maxExponent, maxExponent, x);
+    }
+
+    inline FloatVector clampExponent (FloatVector x) noexcept
+    {
+        return FloatVector::min(FloatVector::max(x, FloatVector::expand(-maxExponent)), FloatVector::expand(maxExponent));
+    }
+
+    /* exp (x) - 1 to about 1e-6, from the Taylor series at x / 16 squared back up four times as
+       (1 + u)^2 - 1 = u (2 + u), which keeps small results accurate where exp (x) - 1 would cancel */
+    template <typename Type>
+    inline Type expm1Bounded (Type x) noexcept
+    {
+        const Type z = clampExponent(x) * (1.0f / 16.0f);
+        Type u = z * (1.0f / 8.0f) + 1.0f;
+
+        u = u * z * (1.0f / 7.0f) + 1.0f;
+        u = u * z * (1.0f / 6.0f) + 1.0f;
+        u = u * z * (1.0f / 5.0f) + 1.0f;
+        u = u * z * (1.0f / 4.0f) + 1.0f;
+        u = u * z * (1.0f / 3.0f) + 1.0f;
+        u = u * z * (1.0f / 2.0f) + 1.0f;
+        u = u * z;
+
+        for (int i = 0; i < 4; i++)
+            u = u * (u + 2.0f);
+
+        return u;
+    }
+}
+
+template <typename Type>
+Type WaveshaperCurve::Shape::evaluate (Type t) const noexcept
+{
+    return t * linear + expm1Bounded(t * rate) * scale + base;
+}
+
+WaveshaperCurve::Shape WaveshaperCurve::makeShape (float startY, float endY, float slope) noexcept
+{
+    const float height = endY - startY;
+    Shape shape;
+
+    shape.base = startY;
+
+    // past +-10 the editor treats a segment as a step
+    if (slope < -10.0f)
+    {
+        shape.base = endY;
+        shape.linear = 0.0f;
+    }
+    else if (slope > 10.0f)
+    {
+        shape.linear = 0.0f;
+    }
+    // nearly flat slopes are close enough to a line, and exp loses everything to cancellation there
+    else if (std::abs(slope) < 1.0e-3f)
+    {
+        shape.linear = height;
+    }
+    else
+    {
+        shape.linear = 0.0f;
+        shape.scale = height / (std::exp(slope) - 1.0f);
+        shape.rate = slope;
+    }
+
+    return shape;
+}
+
+void WaveshaperCurve::compile (const juce::ValueTree& nodeTree, float xSlope, float ySlope, bool isOdd)
+{
+    std::array<juce::Point<float>, maxNodes + 1> points;
+    std::array<float, maxNodes> slopes {};
+    int numNodes = 0;
+
+    for (int i = 0; i < juce::jmin(nodeTree.getNumChildren(), maxNodes); i++)
+    {
+        const juce::ValueTree node = nodeTree.getChild(i);
+
+        if (i > 0 && ! node[ParamIDs::nodeEnabled])
+            break;
+
+        // the first node has no position and sits at the origin
+        points[(size_t) numNodes] = node.hasProperty(ParamIDs::nodeX) ? juce::Point<float> (node[ParamIDs::nodeX], node[ParamIDs::nodeY])
+                                                                      : juce::Point<float> (0.0f, 0.0f);
+        slopes[(size_t) numNodes] = node[ParamIDs::nodeSlope];
+        numNodes++;
+    }
+
+    if (numNodes == 0)
+        points[(size_t) numNodes++] = { 0.0f, 0.0f };
+
+    points[(size_t) numNodes] = { 1.0f, 1.0f };
+    numSegments = numNodes;
+
+    for (int i = 0; i < numSegments; i++)
+    {
+        const auto start = points[(size_t) i], end = points[(size_t) i + 1];
+        const float width = end.x - start.x;
+        const Shape shape = makeShape(start.y, end.y, slopes[(size_t) i]);
+
+        segmentStarts[(size_t) i] = start.x;
+        inverseWidths[(size_t) i] = width > 0.0f ? 1.0f / width : 0.0f;
+        bases[(size_t) i] = shape.base;
+        linears[(size_t) i] = shape.linear;
+        scales[(size_t) i] = shape.scale;
+        rates[(size_t) i] = shape.rate;
+    }
+
+    for (int i = numSegments; i < (int) segmentStarts.size(); i++)
+        segmentStarts[(size_t) i] = std::numeric_limits<float>::max();
+
+    // every cell remembers the segment its left edge falls in; the lookup steps on from there
+    stepsPerLookup = 0;
+
+    for (int cell = 0; cell < gridSize; cell++)
+    {
+        const float cellStart = (float) cell / gridSize, cellEnd = (float) (cell + 1) / gridSize;
+        int first = 0;
+
+        while (first + 1 < numSegments && cellStart > segmentStarts[(size_t) first + 1])
+            first++;
+
+        int last = first;
+
+        while (last + 1 < numSegments && cellEnd > segmentStarts[(size_t) last + 1])
+            last++;
+
+        firstSegments[(size_t) cell] = (uint8_t) first;
+        stepsPerLookup = juce::jmax(stepsPerLookup, last - first);
+    }
+
+    setTransforms(xSlope, ySlope);
+    odd = isOdd;
+}
+
+void WaveshaperCurve::setTransforms (float xSlope, float ySlope) noexcept
+{
+    xTransform = makeShape(0.0f, 1.0f, xSlope);
+    yTransform = makeShape(0.0f, 1.0f, ySlope);
+}
+
+int WaveshaperCurve::findSegment (float input) const noexcept
+{
+    const int cell = juce::jmin((int) (input * gridSize), gridSize - 1);
+    int segment = firstSegments[(size_t) cell];
+
+    for (int step = 0; step < stepsPerLookup; step++)
+        segment += input > segmentStarts[(size_t) segment + 1] ? 1 : 0;
+
+    return segment;
+}
+
+float WaveshaperCurve::evaluateNodes (float input) const noexcept
+{
+    const int segment = findSegment(input);
+    const float t = (input - segmentStarts[(size_t) segment]) * inverseWidths[(size_t) segment];
+    const float output = bases[(size_t) segment]
+                       + linears[(size_t) segment] * t
+                       + scales[(size_t) segment] * expm1Bounded(rates[(size_t) segment] * t);
+
+    // anything left of the first node is silent
+    return input > segmentStarts[0] ? output : 0.0f;
+}
+
+float WaveshaperCurve::processControlSample (float input) const noexcept
+{
+    const float absInput = juce::jmin(std::abs(input), 1.0f);
+    const float sign = input < 0.0f ? -1.0f : 1.0f;
+
+    return evaluateNodes(absInput) * sign;
+}
+
+float WaveshaperCurve::processSample (float input) const noexcept
+{
+    const float absInput = juce::jmin(std::abs(input), 1.0f);
+    const float signX = (odd && input < 0.0f) ? -1.0f : 1.0f;
+
+    const float shaped = evaluateNodes(xTransform.evaluate(absInput));
+    const float signY = shaped < 0.0f ? -1.0f : 1.0f;
+
+    return yTransform.evaluate(std::abs(shaped)) * signX * signY;
+}
+
+void WaveshaperCurve::process (float* samples, int numSamples) const noexcept
+{
+    constexpr int numLanes = (int) FloatVector::SIMDNumElements;
+    constexpr size_t alignment = FloatVector::SIMDRegisterSize;
+
+    // buffers needn't be aligned, so each group of samples goes through an aligned copy
+    alignas (alignment) float lanes[numLanes];
+    alignas (alignment) float starts[numLanes], widths[numLanes];
+    alignas (alignment) float laneBases[numLanes], laneLinears[numLanes], laneScales[numLanes], laneRates[numLanes];
+
+    const FloatVector zero = FloatVector::expand(0.0f);
+    const FloatVector::vMaskType oddMask = FloatVector::vMaskType::expand(odd ? ~0u : 0u);
+    int i = 0;
+
+    for (; i + numLanes <= numSamples; i += numLanes)
+    {
+        std::copy(samples + i, samples + i + numLanes, lanes);
+
+        const FloatVector input = FloatVector::fromRawArray(lanes);
+        const FloatVector x = xTransform.evaluate(FloatVector::min(FloatVector::abs(input), FloatVector::expand(1.0f)));
+
+        x.copyToRawArray(lanes);
+
+        for (int lane = 0; lane < numLanes; lane++)
+        {
+            const auto segment = (size_t) findSegment(lanes[lane]);
+
+            starts[lane] = segmentStarts[segment];
+            widths[lane] = inverseWidths[segment];
+            laneBases[lane] = bases[segment];
+            laneLinears[lane] = linears[segment];
+            laneScales[lane] = scales[segment];
+            laneRates[lane] = rates[segment];
+        }
+
+        const FloatVector t = (x - FloatVector::fromRawArray(starts)) * FloatVector::fromRawArray(widths);
+        const FloatVector rate = FloatVector::fromRawArray(laneRates);
+
+        FloatVector shaped = FloatVector::fromRawArray(laneBases)
+                           + FloatVector::fromRawArray(laneLinears) * t
+                           + FloatVector::fromRawArray(laneScales) * expm1Bounded(rate * t);
+
+        // anything left of the first node is silent
+        shaped = shaped & FloatVector::greaterThan(x, FloatVector::expand(segmentStarts[0]));
+
+        // the output is negative when exactly one of an odd curve's negative input and a negative node output is
+        const auto flip = (FloatVector::lessThan(input, zero) & oddMask) ^ FloatVector::lessThan(shaped, zero);
+        const FloatVector sign = FloatVector::expand(1.0f) - (FloatVector::expand(2.0f) & flip);
+
+        (yTransform.evaluate(FloatVector::abs(shaped)) * sign).copyToRawArray(lanes);
+        std::copy(lanes, lanes + numLanes, samples + i);
+    }
+
+    for (; i < numSamples; i++)
+        samples[i] = processSample(samples[i]);
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    WaveshaperCurve.h
+    Created: 19 Oct 2026 8:02:36pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../service/ParamIDs.h"
+
+/*
+    The waveshaper node curve and its X/Y transforms, compiled into flat arrays
+    so they can be evaluated exactly per sample.
+
+    Every segment, whatever its slope, is stored as
+        base + linear * t + scale * (exp (rate * t) - 1)
+    over its normalised position t, so linear, exponential and stepped
+    segments all take the same branch-free path. The segment holding an
+    input is found from a uniform grid over [0, 1] that stores the first
+    segment in each cell, followed by a fixed number of compare-and-add
+    steps for cells more than one segment starts in.
+
+    process() runs SIMDRegister lanes through the transforms and segments,
+    with exp (x) - 1 from a short polynomial that needs only multiplies and
+    adds; the segment lookup is the one part done lane by lane. Single
+    samples use the same polynomial, so tables built from processSample()
+    match the block path.
+
+    Plain value type, so it can be handed to the audio thread whole.
+*/
+class WaveshaperCurve
+{
+public:
+    static constexpr int maxNodes { 32 };
+
+    WaveshaperCurve() = default;
+
+    /* reads the enabled run of nodes from the start of nodeTree, as the editor lays them out */
+    void compile (const juce::ValueTree& nodeTree, float xSlope, float ySlope, bool isOdd);
+
+    /* replaces the X/Y transforms and leaves the nodes be, so it needs no tree and is safe off the message thread */
+    void setTransforms (float xSlope, float ySlope) noexcept;
+
+    /* the node curve alone, odd symmetric, as drawn in the editor */
+    float processControlSample (float input) const noexcept;
+
+    /* the full transfer curve: X transform, node curve, then Y transform */
+    float processSample (float input) const noexcept;
+
+    void process (float* samples, int numSamples) const noexcept;
+
+private:
+    struct Shape
+    {
+        template <typename Type>
+        Type evaluate (Type t) const noexcept;
+
+        float base { 0.0f }, linear { 1.0f }, scale { 0.0f }, rate { 0.0f };
+    };
+
+    static Shape makeShape (float startY, float endY, float slope) noexcept;
+
+    int findSegment (float input) const noexcept;
+    float evaluateNodes (float input) const noexcept;
+
+    static constexpr int gridSize { 64 };
+
+    int numSegments { 1 };
+    int stepsPerLookup { 0 };
+
+    // one past the last segment holds a start no input can pass
+    std::array<float, maxNodes + 1> segmentStarts {};
+    std::array<float, maxNodes> inverseWidths {};
+    std::array<float, maxNodes> bases {}, linears {}, scales {}, rates {};
+    std::array<uint8_t, gridSize> firstSegments {};
+
+    Shape xTransform, yTransform;
+    bool odd { true };
+
+    JUCE_LEAK_DETECTOR (WaveshaperCurve);
+};
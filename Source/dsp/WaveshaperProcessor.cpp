@@ -14,8 +14,11 @@ WaveshaperProcessor::WaveshaperProcessor(juce::AudioProcessorValueTreeState& t_a
                                          juce::ValueTree paramTree,
                                          LFO& t_lfo1,
                                          LFO& t_lfo2,
-                                         juce::dsp::LookupTableTransform<float>& t_waveshaperControlTable,
-                                         juce::dsp::LookupTableTransform<float>& t_waveshaperTransformTable)
+                                         SwappableTable& t_waveshaperControlTable,
+                                         SwappableTable& t_waveshaperTransformTable,
+                                         std::atomic<uint32_t>& t_tableVersion,
+                                         TableRebuilder& t_tableRebuilder,
+                                         StateChangeBatcher& t_changeBatcher)
 : apvts(t_apvts)
 , waveshaperNodeTree(paramTree.getChildWithName(ParamIDs::waveshaperNodeTree))
 , waveshaperToolTree(paramTree.getChildWithName(ParamIDs::waveshaperToolTree))
@@ -24,6 +27,9 @@ WaveshaperProcessor::WaveshaperProcessor(juce::AudioProcessorValueTreeState& t_a
 , lfo2(t_lfo2)
 , waveshaperControlTable(t_waveshaperControlTable)
 , waveshaperTransformTable(t_waveshaperTransformTable)
+, tableVersion(t_tableVersion)
+, tableRebuilder(t_tableRebuilder)
+, changeBatcher(t_changeBatcher)
 {
     ParameterHelper::castParameter (apvts, ParamIDs::waveshaperXTransform, waveshaperXTRansform);
     ParameterHelper::castParameter (apvts, ParamIDs::waveshaperYTransform, waveshaperYTRansform);
@@ -34,7 +40,11 @@ WaveshaperProcessor::WaveshaperProcessor(juce::AudioProcessorValueTreeState& t_a
     apvts.addParameterListener(ParamIDs::waveshaperXTransform, this);
     apvts.addParameterListener(ParamIDs::waveshaperYTransform, this);
     
-    updateWaveshaperControlTable();
+    antialiasing.store(waveshaperToolTree.getProperty(ParamIDs::waveshaperAntialiasing));
+    
+    compileNodes();
+    rebuildCurveAndTables();
+    rebuildJob = tableRebuilder.addJob([this] { rebuildCurveAndTables(); });
     
     waveshaperNodeTree.addListener(this);
     waveshaperToolTree.addListener(this);
@@ -51,8 +61,11 @@ void WaveshaperProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
     waveshaperInputGainDSP.prepare(spec);
     waveshaperOutputGainDSP.prepare(spec);
     
+    antiderivativeShaper.prepare(spec);
+    activeAntialiasing = getWantedAntialiasing();
+    
     waveshaperMixer.prepare(spec);
-    waveshaperMixer.setWetLatency(0.0f);
+    waveshaperMixer.setWetLatency(AntiderivativeShaper::getLatencyInSamples(activeAntialiasing));
     waveshaperMixer.setMixingRule(juce::dsp::DryWetMixingRule::squareRoot4p5dB);
 }
 
@@ -74,8 +87,29 @@ void WaveshaperProcessor::processBlock (juce::AudioSampleBuffer& buffer, juce::M
     waveshaperInputGainDSP.setGainLinear(inputGainVal);
     waveshaperInputGainDSP.process(context);
     
-    waveshaperTransformTable.process(wetL, wetL, buffer.getNumSamples());
-    waveshaperTransformTable.process(wetR, wetR, buffer.getNumSamples());
+    if (getWantedAntialiasing() != activeAntialiasing)
+    {
+        activeAntialiasing = getWantedAntialiasing();
+        antiderivativeShaper.reset();
+        waveshaperMixer.setWetLatency(AntiderivativeShaper::getLatencyInSamples(activeAntialiasing));
+    }
+    
+    float* wetChannels[] = { wetL, wetR };
+    
+    if (activeAntialiasing == ParameterHelper::firstOrderAntiderivative)
+    {
+        antiderivativeShaper.processFirstOrder(wetChannels, 2, buffer.getNumSamples());
+    }
+    else if (activeAntialiasing == ParameterHelper::secondOrderAntiderivative)
+    {
+        antiderivativeShaper.processSecondOrder(wetChannels, 2, buffer.getNumSamples());
+    }
+    else
+    {
+        CurveObject::ScopedAccess<farbot::ThreadType::realtime> compiledCurve (curve);
+        compiledCurve->process(wetL, buffer.getNumSamples());
+        compiledCurve->process(wetR, buffer.getNumSamples());
+    }
     
     const float outputGainVal = LFO::processLFOSample(waveshaperOutputGain,
                                                       lfoTree.getChildWithName(ParamIDs::lfoWaveshaperOutputGain),
@@ -94,95 +128,78 @@ void WaveshaperProcessor::processBlock (juce::AudioSampleBuffer& buffer, juce::M
     waveshaperMixer.mixWetSamples(buffer);
 }
 
-void WaveshaperProcessor::updateWaveshaperControlTable()
+int WaveshaperProcessor::getWantedAntialiasing() const noexcept
 {
-    // initialize to last enabled node in tree
-    juce::ValueTree node = waveshaperNodeTree.getChild(0);
-    while (node.getSibling(1).getProperty(ParamIDs::nodeEnabled))
-        node = node.getSibling(1);
-    
-    waveshaperControlTable.initialise([&] (float input) {
-        
-        const float absInput = std::abs(input);
-        
-        while (node.isValid())
-        {
-            juce::Point<float> startPoint (0.0f, 0.0f);
-            juce::Point<float> endPoint   (1.0f, 1.0f);
-            
-            juce::ValueTree nextNode = node.getSibling(1);
-
-            if (nextNode.isValid() && nextNode[ParamIDs::nodeEnabled])
-            {
-                endPoint.x = nextNode[ParamIDs::nodeX];
-                endPoint.y = nextNode[ParamIDs::nodeY];
-            }
-
-            if (node.hasProperty(ParamIDs::nodeX))
-            {
-                startPoint.x = node[ParamIDs::nodeX];
-                startPoint.y = node[ParamIDs::nodeY];
-            }
-
-            if (absInput > startPoint.x && absInput <= endPoint.x)
-            {
-                const float slope = node.getProperty(ParamIDs::nodeSlope);
-                const float segmentWidth = endPoint.x - startPoint.x;
-                const float segmentHeight = endPoint.y - startPoint.y;
-                const float inputNorm = (absInput - startPoint.x) / segmentWidth;
-                const float mult = input == 0.0f ? 1.0f : absInput / input;
+    return highestQuality.load() ? (int) ParameterHelper::secondOrderAntiderivative : antialiasing.load();
+}
 
-                if (slope == 0.0f)
-                    return (startPoint.y + segmentHeight * inputNorm) * mult;
-                else if (slope < -10.0f)
-                    return endPoint.y * mult;
-                else if (slope > 10.0f)
-                    return startPoint.y * mult;
-                else
-                    return (startPoint.y + segmentHeight * (expf(slope * inputNorm) - 1.0f) / (expf(slope) - 1.0f)) * mult;
-            }
-            else
-            {
-                node = node.getSibling(input < 0.0f ? -1 : 1);
-            }
-        }
-        
-        node = waveshaperNodeTree.getChild(0);
-        return 0.0f;
-        
-    }, -1.0f, 1.0f, 129);
-    
-    updateWaveshaperTransformTable();
+void WaveshaperProcessor::compileNodes()
+{
+    static_assert (ParameterHelper::numShaperNodes <= WaveshaperCurve::maxNodes, "the curve must fit the whole node pool");
+    
+    // the tree walk stays on the message thread; everything after it is the rebuilder's
+    WaveshaperCurve newCurve;
+    newCurve.compile(waveshaperNodeTree,
+                     waveshaperXTRansform->get(),
+                     waveshaperYTRansform->get(),
+                     waveshaperToolTree.getProperty(ParamIDs::oddEven));
+    
+    const juce::ScopedLock sl (nodeCurveLock);
+    nodeCurve = newCurve;
+    nodesChanged = true;
 }
 
-void WaveshaperProcessor::updateWaveshaperTransformTable()
+void WaveshaperProcessor::rebuildCurveAndTables()
 {
-    waveshaperTransformTable.initialise([&] (float input) {
-        
-        const bool isOdd = static_cast<bool>(waveshaperToolTree.getProperty(ParamIDs::oddEven));
-        
-        const float absInput = std::abs(input);
-        const float multX = (isOdd && input != 0.0f) ? input / absInput : 1.0f;
-        
-        const float xSlope = waveshaperXTRansform->get();
-        const float xTransformedOutput = waveshaperControlTable.processSample(xSlope == 0.0f ? absInput : (expf(xSlope * absInput) - 1.0f) / (expf(xSlope) - 1.0f));
-        
-        const float multY = xTransformedOutput != 0.0f ? xTransformedOutput / std::abs(xTransformedOutput) : 1.0f;
-        
-        const float ySlope = waveshaperYTRansform->get();
-        const float yTransformedOutput = ySlope == 0.0f ? std::abs(xTransformedOutput) : (expf(ySlope * std::abs(xTransformedOutput)) - 1.0f) / (expf(ySlope) - 1.0f);
-        return yTransformedOutput * multX * multY;
-        
-    }, -1.0f, 1.0f, 129);
+    WaveshaperCurve newCurve;
+    bool rebuildControlTable;
+    
+    {
+        const juce::ScopedLock sl (nodeCurveLock);
+        newCurve = nodeCurve;
+        rebuildControlTable = nodesChanged;
+        nodesChanged = false;
+    }
+    
+    // the transforms can be automated from any thread, so they're read fresh rather than from the last compile
+    newCurve.setTransforms(waveshaperXTRansform->get(), waveshaperYTRansform->get());
+    curve.nonRealtimeReplace(newCurve);
+    
+    // the control table is the node curve alone, so transform changes leave it be
+    if (rebuildControlTable)
+        waveshaperControlTable.initialise([&newCurve] (float input) { return newCurve.processControlSample(input); },
+                                          -1.0f, 1.0f, transformTableSize);
+    
+    auto transform = [&newCurve] (float input) { return newCurve.processSample(input); };
+    
+    // the editor's table only has to look right; the antialiased paths sample the compiled curve as finely as they can hold
+    waveshaperTransformTable.initialise(transform, -1.0f, 1.0f, transformTableSize);
+    antiderivativeShaper.initialise(transform, AntiderivativeShaper::maxPoints);
+    
+    tableVersion.fetch_add(1);
 }
 
 void WaveshaperProcessor::parameterChanged (const juce::String& parameterID, float newValue)
 {
-    if (parameterID == ParamIDs::waveshaperXTransform || parameterID == ParamIDs::waveshaperYTransform)
-        updateWaveshaperTransformTable();
+    if (parameterID != ParamIDs::waveshaperXTransform && parameterID != ParamIDs::waveshaperYTransform)
+        return;
+    
+    // automation can arrive on any thread; the rebuilder reads both transforms when it gets round to it
+    tableRebuilder.request(rebuildJob);
 }
 
 void WaveshaperProcessor::valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property)
 {
-    updateWaveshaperControlTable();
+    if (property == ParamIDs::waveshaperAntialiasing)
+    {
+        antialiasing.store(treeWhosePropertyHasChanged[property]);
+        return;
+    }
+    
+    // a preset load changes every node at once; the curve only needs compiling after the last
+    changeBatcher.runOrDefer(this, [this]
+    {
+        compileNodes();
+        tableRebuilder.request(rebuildJob);
+    });
 }
@@ -12,8 +12,14 @@
 
 #include "ProcessorBase.h"
 #include "LFO.h"
+#include "AntiderivativeShaper.h"
+#include "WaveshaperCurve.h"
 #include "../service/ParameterHelper.h"
 #include "../service/ParamIDs.h"
+#include "../service/StateChangeBatcher.h"
+#include "../service/SwappableTable.h"
+#include "../service/TableRebuilder.h"
+#include "../service/farbot/RealtimeObject.hpp"
 
 class WaveshaperProcessor  : public ProcessorBase
                            , public juce::AudioProcessorValueTreeState::Listener
@@ -24,21 +30,33 @@ public:
                         juce::ValueTree paramTree,
                         LFO& lfo1,
                         LFO& lfo2,
-                        juce::dsp::LookupTableTransform<float>& waveshaperControlTable,
-                        juce::dsp::LookupTableTransform<float>& waveshaperTransformTable);
+                        SwappableTable& waveshaperControlTable,
+                        SwappableTable& waveshaperTransformTable,
+                        std::atomic<uint32_t>& tableVersion,
+                        TableRebuilder& tableRebuilder,
+                        StateChangeBatcher& changeBatcher);
     
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void processBlock (juce::AudioSampleBuffer& buffer, juce::MidiBuffer&) override;
     
-    void updateWaveshaperControlTable();
-    void updateWaveshaperTransformTable();
-    
     void parameterChanged (const juce::String& parameterID, float newValue) override;
     void valueTreePropertyChanged(juce::ValueTree& treeWhosePropertyHasChanged, const juce::Identifier& property) override;
     
     const juce::String getName() const override { return "Waveshaper Processor"; }
     
+    /* for the render tool alone: shape with second order antialiasing whatever the patch asks for.
+       Hosts never set it, so a bounce sounds like playback and the latency they were told about holds */
+    void setHighestQuality (bool shouldUseHighestQuality) noexcept { highestQuality.store(shouldUseHighestQuality); }
+    
 private:
+    using CurveObject = farbot::RealtimeObject<WaveshaperCurve, farbot::RealtimeObjectOptions::nonRealtimeMutatable>;
+    
+    void compileNodes();
+    void rebuildCurveAndTables();
+    
+    /* the patch's own setting, unless the render tool has asked for the highest quality */
+    int getWantedAntialiasing() const noexcept;
+    
     juce::AudioProcessorValueTreeState& apvts;
     juce::ValueTree waveshaperNodeTree;
     juce::ValueTree waveshaperToolTree;
@@ -54,10 +72,29 @@ private:
     
     juce::dsp::Gain<float> waveshaperInputGainDSP;
     juce::dsp::Gain<float> waveshaperOutputGainDSP;
-    juce::dsp::DryWetMixer<float> waveshaperMixer;
+    // room for the one sample the second order antiderivative delays the wet signal by
+    juce::dsp::DryWetMixer<float> waveshaperMixer { 1 };
+    
+    SwappableTable& waveshaperControlTable;
+    SwappableTable& waveshaperTransformTable;
+    std::atomic<uint32_t>& tableVersion;
+    TableRebuilder& tableRebuilder;
+    StateChangeBatcher& changeBatcher;
+    static constexpr int transformTableSize { 129 };
+    int rebuildJob { -1 };
+    
+    // the audio thread shapes with the compiled curve, or with ADAA tables sampled from it; the tables above only feed the editor
+    CurveObject curve;
+    
+    // the nodes as last compiled on the message thread, for the rebuilder to pick up
+    juce::CriticalSection nodeCurveLock;
+    WaveshaperCurve nodeCurve;
+    bool nodesChanged { true };
     
-    juce::dsp::LookupTableTransform<float>& waveshaperControlTable;
-    juce::dsp::LookupTableTransform<float>& waveshaperTransformTable;
+    AntiderivativeShaper antiderivativeShaper;
+    std::atomic<int> antialiasing;
+    int activeAntialiasing { ParameterHelper::noAntialiasing };
+    std::atomic<bool> highestQuality { false };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveshaperProcessor);
 };
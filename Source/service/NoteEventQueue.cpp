@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    NoteEventQueue.cpp
+    Created: 20 Oct 2026 9:41:07am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "NoteEventQueue.h"
+
+/* ----- NOTE EVENT ----- */
+
+NoteEvent NoteEvent::noteOn (int channel, int noteNumber, float velocity) noexcept
+{
+    jassert (channel > 0 && channel <= 16);
+    jassert (juce::isPositiveAndBelow(noteNumber, 128));
+    
+    NoteEvent event;
+    event.timeMs = juce::Time::getMillisecondCounterHiRes();
+    event.type = Type::noteOn;
+    event.channel = (uint8_t) channel;
+    event.number = (uint8_t) noteNumber;
+    event.value = juce::MidiMessage::floatValueToMidiByte(velocity);
+    return event;
+}
+
+NoteEvent NoteEvent::noteOff (int channel, int noteNumber, float velocity) noexcept
+{
+    NoteEvent event = noteOn(channel, noteNumber, velocity);
+    event.type = Type::noteOff;
+    return event;
+}
+
+NoteEvent NoteEvent::controller (int channel, int controllerNumber, int value) noexcept
+{
+    jassert (channel > 0 && channel <= 16);
+    jassert (juce::isPositiveAndBelow(controllerNumber, 128));
+    
+    NoteEvent event;
+    event.timeMs = juce::Time::getMillisecondCounterHiRes();
+    event.type = Type::controller;
+    event.channel = (uint8_t) channel;
+    event.number = (uint8_t) controllerNumber;
+    event.value = (uint8_t) juce::jlimit(0, 127, value);
+    return event;
+}
+
+/* ----- NOTE EVENT QUEUE ----- */
+
+NoteEventQueue::NoteEventQueue()
+{
+    for (uint32_t i = 0; i < (uint32_t) capacity; i++)
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool NoteEventQueue::push (const NoteEvent& event) noexcept
+{
+    uint32_t position = writePosition.load(std::memory_order_relaxed);
+    
+    for (;;)
+    {
+        Slot& slot = slots[position & indexMask];
+        const auto lag = (int32_t) (slot.sequence.load(std::memory_order_acquire) - position);
+        
+        // the slot is free for this position; try to claim it before another producer does
+        if (lag == 0)
+        {
+            if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.event = event;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        // the reader hasn't got round to this slot since the last lap
+        else if (lag < 0)
+        {
+            droppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        // another producer claimed it first
+        else
+        {
+            position = writePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool NoteEventQueue::pop (NoteEvent& event) noexcept
+{
+    Slot& slot = slots[readPosition & indexMask];
+    
+    // a producer that has claimed the slot but not yet written it holds up the rest until it has
+    if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1)
+        return false;
+    
+    event = slot.event;
+    slot.sequence.store(readPosition + (uint32_t) capacity, std::memory_order_release);
+    readPosition++;
+    return true;
+}
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    NoteEventQueue.h
+    Created: 20 Oct 2026 9:41:07am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/* a note or controller event, stamped with the hi-res millisecond counter when it was made */
+struct NoteEvent
+{
+    enum class Type : uint8_t { noteOn, noteOff, controller };
+    
+    static NoteEvent noteOn (int channel, int noteNumber, float velocity) noexcept;
+    static NoteEvent noteOff (int channel, int noteNumber, float velocity) noexcept;
+    static NoteEvent controller (int channel, int controllerNumber, int value) noexcept;
+    
+    float getVelocity() const noexcept { return value / 127.0f; }
+    
+    double timeMs { 0.0 };
+    Type type { Type::noteOn };
+    uint8_t channel { 1 };
+    uint8_t number { 0 };
+    uint8_t value { 0 };
+};
+
+/*
+    Fixed size queue of NoteEvents that any number of threads can push to
+    at once, the editor, an external control thread and a test harness
+    alike, and the audio thread drains.
+    
+    Each slot carries a sequence number saying whose turn it is, so a push
+    claims its slot with a single compare-and-swap and neither side ever
+    locks or allocates. A full queue drops the event rather than waiting;
+    getNumDroppedEvents() counts them.
+    
+    drainBlock() hands each event to the render with a sample offset, found
+    by spreading the time since the last drain across the block. Events
+    therefore play a block late, but keep the spacing they were made with.
+*/
+class NoteEventQueue
+{
+public:
+    static constexpr int capacity { 512 };
+    
+    NoteEventQueue();
+    
+    /* any thread; false, and counted as dropped, when the queue is full */
+    bool push (const NoteEvent& event) noexcept;
+    
+    /* the single consumer only */
+    bool pop (NoteEvent& event) noexcept;
+    
+    uint32_t getNumDroppedEvents() const noexcept { return droppedEvents.load(std::memory_order_relaxed); }
+    
+    /* audio thread; calls handler (const NoteEvent&, int sampleOffset) in order, offsets never going back */
+    template <typename Handler>
+    void drainBlock (double sampleRate, int numSamples, Handler&& handler) noexcept
+    {
+        const double now = juce::Time::getMillisecondCounterHiRes();
+        
+        // after a stall, or on the first block, only the last block's worth of time is spread out
+        const double windowStart = juce::jmax(lastDrainMs, now - numSamples * 1000.0 / sampleRate);
+        const double windowLength = juce::jmax(now - windowStart, 1.0e-3);
+        lastDrainMs = now;
+        
+        NoteEvent event;
+        int offset = 0;
+        
+        while (pop(event))
+        {
+            const int eventOffset = juce::roundToInt((event.timeMs - windowStart) / windowLength * numSamples);
+            offset = juce::jlimit(offset, juce::jmax(numSamples - 1, 0), eventOffset);
+            
+            handler(event, offset);
+        }
+    }
+
+private:
+    static constexpr uint32_t indexMask { (uint32_t) capacity - 1 };
+    static_assert ((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+    
+    struct Slot
+    {
+        std::atomic<uint32_t> sequence { 0 };
+        NoteEvent event;
+    };
+    
+    std::array<Slot, capacity> slots;
+    std::atomic<uint32_t> writePosition { 0 };
+    uint32_t readPosition { 0 };
+    double lastDrainMs { 0.0 };
+    
+    std::atomic<uint32_t> droppedEvents { 0 };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NoteEventQueue);
+};
@@ -111,6 +111,8 @@ constexpr auto masterGain { "Master Gain" };
 
 /* ----- NON-APVTS VALUE TREE/PROPERTY IDS ----- */
 
+// the APVTS state's own type, which presets store the parameters under
+const juce::Identifier parameterTree { "Parameters" };
 const juce::Identifier nonParamTree { "nonParamTree" };
 
 const juce::Identifier synthTree { "synthTree" };
@@ -132,13 +134,31 @@ const juce::Identifier delayLink { "delayLink" };
 const juce::Identifier delayLowpassCutoff { "delayLowpassCutoff" };
 const juce::Identifier delayHighpassCutoff { "delayHighpassCutoff" };
 const juce::Identifier delayFilterIO { "delayFilterIO" };
+const juce::Identifier delayCompactStorage { "delayCompactStorage" };
+const juce::Identifier delayMode { "delayMode" };
+
+const juce::Identifier delayTapTree { "delayTapTree" };
+const juce::Identifier delayTap0 { "delayTap0" };
+const juce::Identifier delayTap1 { "delayTap1" };
+const juce::Identifier delayTap2 { "delayTap2" };
+const juce::Identifier delayTap3 { "delayTap3" };
+const juce::Identifier delayTap4 { "delayTap4" };
+const juce::Identifier delayTap5 { "delayTap5" };
+const juce::Identifier delayTap6 { "delayTap6" };
+const juce::Identifier delayTap7 { "delayTap7" };
+const juce::Identifier tapEnabled { "tapEnabled" };
+const juce::Identifier tapSync { "tapSync" };
+const juce::Identifier tapTime { "tapTime" };
+const juce::Identifier tapSyncIndex { "tapSyncIndex" };
+const juce::Identifier tapGain { "tapGain" };
+const juce::Identifier tapPan { "tapPan" };
+
+const juce::Identifier reverbTree { "reverbTree" };
+const juce::Identifier reverbEngine { "reverbEngine" };
+const juce::Identifier reverbImpulseFile { "reverbImpulseFile" };
 
 const juce::Identifier waveshaperNodeTree { "waveshaperNodeTree" };
-const juce::Identifier shaperNode0 { "shaperNode0" };
-const juce::Identifier shaperNode1 { "shaperNode1" };
-const juce::Identifier shaperNode2 { "shaperNode2" };
-const juce::Identifier shaperNode3 { "shaperNode3" };
-const juce::Identifier shaperNode4 { "shaperNode4" };
+// children are named shaperNode0 to shaperNode31, see ParameterHelper::getShaperNodeID
 const juce::Identifier nodeX { "node1X" };
 const juce::Identifier nodeY { "node1Y" };
 const juce::Identifier nodeSlope { "node1Slope" };
@@ -146,10 +166,13 @@ const juce::Identifier nodeEnabled { "node1Enabled" };
 
 const juce::Identifier waveshaperToolTree { "waveshaperToolTree" };
 const juce::Identifier oddEven { "oddEven" };
+const juce::Identifier waveshaperAntialiasing { "waveshaperAntialiasing" };
 
 const juce::Identifier filterTree { "filterTree" };
 const juce::Identifier filterLowpassMode { "filterLowpassMode" };
 const juce::Identifier filterHighpassMode { "filterHighpassMode" };
+const juce::Identifier filterLowpassSlope { "filterLowpassSlope" };
+const juce::Identifier filterHighpassSlope { "filterHighpassSlope" };
 
 const juce::Identifier lfoTree { "lfoTree" };
 
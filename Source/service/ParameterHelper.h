@@ -28,7 +28,54 @@ public:
     
     static const inline juce::StringArray syncOptions { "1", "2", "3", "4", "6", "8", "12", "16", "32", "64" };
     
+    // syncOptions as numbers, so the audio thread never has to parse the strings
+    static constexpr int syncSixteenths[] { 1, 2, 3, 4, 6, 8, 12, 16, 32, 64 };
+    
+    static float getSyncTimeInSeconds (const int syncIndex, const float bpm)
+    {
+        const int index = juce::jlimit(0, (int) std::size(syncSixteenths) - 1, syncIndex);
+        return syncSixteenths[index] / (bpm / 60.f * 4.0f);
+    }
+    
     enum filterType { pass, shelf, off };
+    // 12 dB/oct per cascaded biquad stage
+    enum filterSlope { slope12, slope24, slope36, slope48 };
+    
+    enum antialiasingMode { noAntialiasing, firstOrderAntiderivative, secondOrderAntiderivative };
+    
+    enum delayMode { stereo, pingPong, multiTap };
+    
+    enum reverbEngine { freeverb, feedbackDelayNetwork, convolution };
+    static constexpr int numDelayTaps { 8 };
+    // the editor's node pool; WaveshaperCurve compiles up to this many
+    static constexpr int numShaperNodes { 32 };
+    
+    static juce::Identifier getShaperNodeID (const int index)
+    {
+        return juce::Identifier ("shaperNode" + juce::String(index));
+    }
+    
+    // disabled nodes for the end of the pool, at the editor's default position
+    static juce::ValueTree createDisabledShaperNode (const int index)
+    {
+        juce::ValueTree node (getShaperNodeID(index));
+        node.setProperty(ParamIDs::nodeX, 0.5f, nullptr);
+        node.setProperty(ParamIDs::nodeY, 0.45f, nullptr);
+        node.setProperty(ParamIDs::nodeSlope, 5.0f, nullptr);
+        node.setProperty(ParamIDs::nodeEnabled, false, nullptr);
+        return node;
+    }
+    
+    // states from before the pool grew to numShaperNodes have fewer children; the rest are added disabled
+    static void addMissingShaperNodes (juce::ValueTree nodeTree)
+    {
+        if (! nodeTree.isValid())
+            return;
+        
+        for (int i = 0; i < numShaperNodes; i++)
+            if (! nodeTree.getChildWithName(getShaperNodeID(i)).isValid())
+                nodeTree.appendChild(createDisabledShaperNode(i), nullptr);
+    }
     
     static juce::NormalisableRange<float> normRangeWithMidpointSkew (const float lowerBound, const float upperBound,
 //                                                                     const float interval,
@@ -1055,32 +1102,16 @@ public:
         juce::ValueTree waveshaperNodes (ParamIDs::waveshaperNodeTree);
         tree.addChild(waveshaperNodes, -1, nullptr);
         
-        juce::ValueTree node0 (ParamIDs::shaperNode0);
+        juce::ValueTree node0 (getShaperNodeID(0));
         node0.setProperty(ParamIDs::nodeSlope, 0.0f, nullptr);
         node0.setProperty(ParamIDs::nodeEnabled, true, nullptr);
         waveshaperNodes.addChild(node0, 0, nullptr);
         
-        juce::ValueTree node1 (ParamIDs::shaperNode1);
-        node1.setProperty(ParamIDs::nodeX, 0.5f, nullptr);
-        node1.setProperty(ParamIDs::nodeY, 0.45f, nullptr);
-        node1.setProperty(ParamIDs::nodeSlope, 5.0f, nullptr);
-        node1.setProperty(ParamIDs::nodeEnabled, false, nullptr);
-        waveshaperNodes.addChild(node1, 1, nullptr);
-        
-        juce::ValueTree node2 (ParamIDs::shaperNode2);
-        node2.copyPropertiesFrom(node1, nullptr);
-        waveshaperNodes.addChild(node2, 2, nullptr);
-        
-        juce::ValueTree node3 (ParamIDs::shaperNode3);
-        node3.copyPropertiesFrom(node1, nullptr);
-        waveshaperNodes.addChild(node3, 3, nullptr);
-        
-        juce::ValueTree node4 (ParamIDs::shaperNode4);
-        node4.copyPropertiesFrom(node1, nullptr);
-        waveshaperNodes.addChild(node4, 4, nullptr);
+        addMissingShaperNodes(waveshaperNodes);
         
         juce::ValueTree waveshaperTools (ParamIDs::waveshaperToolTree);
         waveshaperTools.setProperty(ParamIDs::oddEven, true, nullptr);
+        waveshaperTools.setProperty(ParamIDs::waveshaperAntialiasing, noAntialiasing, nullptr);
         tree.appendChild(waveshaperTools, nullptr);
         
         /* ----- SYNTH TREE ----- */
@@ -1107,13 +1138,42 @@ public:
         delayTree.setProperty(ParamIDs::delayLowpassCutoff, 0.0f, nullptr);
         delayTree.setProperty(ParamIDs::delayHighpassCutoff, 0.0f, nullptr);
         delayTree.setProperty(ParamIDs::delayFilterIO, true, nullptr);
+        delayTree.setProperty(ParamIDs::delayCompactStorage, false, nullptr);
+        delayTree.setProperty(ParamIDs::delayMode, stereo, nullptr);
         tree.appendChild(delayTree, nullptr);
         
+        juce::ValueTree delayTaps (ParamIDs::delayTapTree);
+        delayTree.appendChild(delayTaps, nullptr);
+        
+        const juce::Identifier tapIDs[] { ParamIDs::delayTap0, ParamIDs::delayTap1, ParamIDs::delayTap2, ParamIDs::delayTap3,
+                                          ParamIDs::delayTap4, ParamIDs::delayTap5, ParamIDs::delayTap6, ParamIDs::delayTap7 };
+        
+        for (int i = 0; i < numDelayTaps; i++)
+        {
+            juce::ValueTree tap (tapIDs[i]);
+            tap.setProperty(ParamIDs::tapEnabled, false, nullptr);
+            tap.setProperty(ParamIDs::tapSync, true, nullptr);
+            tap.setProperty(ParamIDs::tapTime, 0.125f * (i + 1), nullptr);
+            tap.setProperty(ParamIDs::tapSyncIndex, juce::jmin(i, (int) std::size(syncSixteenths) - 1), nullptr);
+            tap.setProperty(ParamIDs::tapGain, 0.5f, nullptr);
+            tap.setProperty(ParamIDs::tapPan, i % 2 == 0 ? -0.5f : 0.5f, nullptr);
+            delayTaps.appendChild(tap, nullptr);
+        }
+        
+        /* ----- REVERB TREE ----- */
+        
+        juce::ValueTree reverbTree (ParamIDs::reverbTree);
+        reverbTree.setProperty(ParamIDs::reverbEngine, freeverb, nullptr);
+        reverbTree.setProperty(ParamIDs::reverbImpulseFile, "", nullptr);
+        tree.appendChild(reverbTree, nullptr);
+        
         /* ----- FILTER TREE ----- */
         
         juce::ValueTree filterTree (ParamIDs::filterTree);
         filterTree.setProperty(ParamIDs::filterLowpassMode, 0, nullptr);
         filterTree.setProperty(ParamIDs::filterHighpassMode, 0, nullptr);
+        filterTree.setProperty(ParamIDs::filterLowpassSlope, slope12, nullptr);
+        filterTree.setProperty(ParamIDs::filterHighpassSlope, slope12, nullptr);
         tree.appendChild(filterTree, nullptr);
         
         /* ----- LFO TREES ----- */
@@ -0,0 +1,371 @@
+/*
+  ==============================================================================
+
+    PresetCatalog.cpp
+    Created: 19 Oct 2026 10:41:09pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "PresetCatalog.h"
+#include "PresetManager.h"
+
+namespace
+{
+    juce::uint64 hashBytes(const void* data, size_t size)
+    {
+        // FNV-1a; only ever compared against hashes made by this same function
+        auto* bytes = static_cast<const juce::uint8*>(data);
+        juce::uint64 hash = 14695981039346656037ull;
+        
+        for (size_t i = 0; i < size; i++)
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        
+        return hash;
+    }
+    
+    bool isBefore(const PresetCatalog::EntryPtr& a, const juce::String& name)
+    {
+        return a->name.compareNatural(name) < 0;
+    }
+}
+
+PresetCatalog::PresetCatalog()
+: juce::Thread("Preset Catalog")
+, directory(PresetManager::defaultDirectory)
+, wildcard("*." + PresetManager::extension)
+, indexFile(juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                .getChildFile(ProjectInfo::companyName)
+                .getChildFile(ProjectInfo::projectName)
+                .getChildFile("presets.index"))
+, parameterTreeType(ParamIDs::parameterTree)
+, nonParamTreeType(ParamIDs::nonParamTree)
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+PresetCatalog::~PresetCatalog()
+{
+    stopThread(4000);
+    cancelPendingUpdate();
+}
+
+int PresetCatalog::getNumPresets() const
+{
+    return (int) entries.size();
+}
+
+juce::StringArray PresetCatalog::getPresetNames() const
+{
+    juce::StringArray names;
+    names.ensureStorageAllocated((int) entries.size());
+    
+    for (const auto& entry : entries)
+        names.add(entry->name);
+    
+    return names;
+}
+
+int PresetCatalog::indexOf(const juce::String& name) const
+{
+    const auto found = std::lower_bound(entries.begin(), entries.end(), name, isBefore);
+    
+    if (found == entries.end() || (*found)->name != name)
+        return -1;
+    
+    return (int) std::distance(entries.begin(), found);
+}
+
+PresetCatalog::EntryPtr PresetCatalog::getEntry(int index) const
+{
+    if (! juce::isPositiveAndBelow(index, (int) entries.size()))
+        return nullptr;
+    
+    return entries[(size_t) index];
+}
+
+PresetCatalog::EntryPtr PresetCatalog::getEntry(const juce::String& name) const
+{
+    return getEntry(indexOf(name));
+}
+
+juce::Array<int> PresetCatalog::search(const juce::String& query) const
+{
+    const auto words = juce::StringArray::fromTokens(query, true);
+    juce::Array<int> results;
+    
+    for (int i = 0; i < (int) entries.size(); i++)
+    {
+        const auto& entry = *entries[(size_t) i];
+        bool matchesAll = true;
+        
+        for (const auto& word : words)
+        {
+            if (! entry.name.containsIgnoreCase(word)
+                && ! std::any_of(entry.tags.begin(), entry.tags.end(),
+                                 [&word] (const juce::String& tag) { return tag.containsIgnoreCase(word); }))
+            {
+                matchesAll = false;
+                break;
+            }
+        }
+        
+        if (matchesAll)
+            results.add(i);
+    }
+    
+    return results;
+}
+
+void PresetCatalog::rescanNow()
+{
+    notify();
+}
+
+void PresetCatalog::addWatcher()
+{
+    // a browser that just opened should show what changed while none was
+    if (numWatchers++ == 0)
+        notify();
+}
+
+void PresetCatalog::removeWatcher()
+{
+    jassert (numWatchers.load() > 0);
+    numWatchers--;
+}
+
+void PresetCatalog::run()
+{
+    loadIndex();
+    
+    if (! scannedEntries.empty())
+        publish();
+    
+    int rescanIntervalMs = minRescanIntervalMs;
+    
+    while (! threadShouldExit())
+    {
+        if (scanDirectory())
+        {
+            publish();
+            saveIndex();
+            rescanIntervalMs = minRescanIntervalMs;
+        }
+        
+        // unwatched, only rescanNow() or a new watcher wakes the thread; watched, a quiet directory is polled less and less
+        const bool woken = wait(numWatchers.load() > 0 ? rescanIntervalMs : -1);
+        rescanIntervalMs = woken ? minRescanIntervalMs : juce::jmin(rescanIntervalMs * 2, maxRescanIntervalMs);
+    }
+}
+
+bool PresetCatalog::scanDirectory()
+{
+    std::map<juce::String, EntryPtr> found;
+    bool changed = false;
+    
+    // the iterator's listing already carries size and date, so unchanged files are never opened
+    for (const auto& item : juce::RangedDirectoryIterator(directory, false, wildcard, juce::File::findFiles))
+    {
+        if (threadShouldExit())
+            return false;
+        
+        const auto file = item.getFile();
+        const auto name = file.getFileNameWithoutExtension();
+        const auto modificationTime = item.getModificationTime().toMilliseconds();
+        const auto previous = scannedEntries.find(name);
+        
+        if (previous != scannedEntries.end()
+            && previous->second->fileSize == item.getFileSize()
+            && previous->second->modificationTime == modificationTime)
+        {
+            found[name] = previous->second;
+            continue;
+        }
+        
+        auto entry = readPreset(file, item.getFileSize(), modificationTime,
+                                previous != scannedEntries.end() ? previous->second : nullptr);
+        
+        if (entry != nullptr)
+        {
+            found[name] = entry;
+            changed = true;
+        }
+    }
+    
+    changed = changed || found.size() != scannedEntries.size();
+    scannedEntries = std::move(found);
+    
+    return changed;
+}
+
+PresetCatalog::EntryPtr PresetCatalog::readPreset(const juce::File& file, juce::int64 fileSize, juce::int64 modificationTime,
+                                                  const EntryPtr& previous) const
+{
+    juce::MemoryBlock contents;
+    
+    if (! file.loadFileAsData(contents))
+    {
+        DBG("Could not read preset file: " + file.getFullPathName());
+        return nullptr;
+    }
+    
+    auto entry = std::make_shared<Entry>();
+    entry->name = file.getFileNameWithoutExtension();
+    entry->fileSize = fileSize;
+    entry->modificationTime = modificationTime;
+    entry->hash = hashBytes(contents.getData(), contents.getSize());
+    
+    // touched but not edited, e.g. copied onto a share: keep what was already parsed
+    if (previous != nullptr && previous->hash == entry->hash)
+    {
+        entry->tags = previous->tags;
+        entry->state = previous->state;
+        return entry;
+    }
+    
+    const auto xml = juce::parseXML(contents.toString());
+    
+    if (xml == nullptr || ! convertToState(*xml, entry->state))
+    {
+        DBG("Could not parse preset file: " + file.getFullPathName());
+        return nullptr;
+    }
+    
+    entry->tags.addTokens(xml->getStringAttribute("tags"), ",", "");
+    entry->tags.trim();
+    entry->tags.removeEmptyStrings();
+    
+    return entry;
+}
+
+bool PresetCatalog::convertToState(const juce::XmlElement& xml, juce::MemoryBlock& state) const
+{
+    const auto* parameterXml = xml.getChildByName(parameterTreeType);
+    const auto* nonParamXml = xml.getChildByName(nonParamTreeType);
+    
+    if (parameterXml == nullptr || nonParamXml == nullptr)
+        return false;
+    
+    std::vector<juce::uint32> keys;
+    std::vector<float> values;
+    
+    // the APVTS writes each parameter as <PARAM id="..." value="..."/>
+    for (const auto* parameter : parameterXml->getChildIterator())
+    {
+        if (! parameter->hasAttribute("id"))
+            continue;
+        
+        keys.push_back(PresetManager::getStableParameterKey(parameter->getStringAttribute("id")));
+        values.push_back((float) parameter->getDoubleAttribute("value"));
+    }
+    
+    juce::MemoryOutputStream stream (state, false);
+    PresetManager::writeStateBinary(stream, keys, values, juce::ValueTree::fromXml(*nonParamXml));
+    
+    return true;
+}
+
+void PresetCatalog::publish()
+{
+    std::vector<EntryPtr> snapshot;
+    snapshot.reserve(scannedEntries.size());
+    
+    for (const auto& [name, entry] : scannedEntries)
+        snapshot.push_back(entry);
+    
+    std::sort(snapshot.begin(), snapshot.end(),
+              [] (const EntryPtr& a, const EntryPtr& b) { return isBefore(a, b->name); });
+    
+    {
+        const juce::ScopedLock lock (pendingLock);
+        pendingEntries = std::move(snapshot);
+    }
+    
+    triggerAsyncUpdate();
+}
+
+void PresetCatalog::handleAsyncUpdate()
+{
+    {
+        const juce::ScopedLock lock (pendingLock);
+        entries.swap(pendingEntries);
+        pendingEntries.clear();
+    }
+    
+    sendChangeMessage();
+}
+
+void PresetCatalog::loadIndex()
+{
+    juce::FileInputStream stream (indexFile);
+    
+    if (! stream.openedOk() || stream.readInt() != indexMagic || stream.readInt() != indexVersion)
+        return;
+    
+    // a preset state schema change invalidates every cached state
+    if (stream.readInt() != PresetManager::stateVersion)
+        return;
+    
+    const int numEntries = stream.readInt();
+    
+    for (int i = 0; i < numEntries && ! stream.isExhausted(); i++)
+    {
+        auto entry = std::make_shared<Entry>();
+        entry->name = stream.readString();
+        entry->tags.addTokens(stream.readString(), ",", "");
+        entry->tags.removeEmptyStrings();
+        entry->fileSize = stream.readInt64();
+        entry->modificationTime = stream.readInt64();
+        entry->hash = (juce::uint64) stream.readInt64();
+        
+        const auto stateSize = stream.readInt64();
+        
+        if (stateSize < 0 || stateSize > stream.getNumBytesRemaining())
+        {
+            DBG("Preset index is damaged; rebuilding it");
+            scannedEntries.clear();
+            return;
+        }
+        
+        stream.readIntoMemoryBlock(entry->state, (juce::ssize_t) stateSize);
+        
+        const auto name = entry->name;
+        scannedEntries[name] = std::move(entry);
+    }
+}
+
+void PresetCatalog::saveIndex() const
+{
+    indexFile.getParentDirectory().createDirectory();
+    
+    // written beside the index and swapped in, so a crash never leaves half a file
+    juce::TemporaryFile temporary (indexFile);
+    
+    {
+        juce::FileOutputStream stream (temporary.getFile());
+        
+        if (! stream.openedOk())
+            return;
+        
+        stream.writeInt(indexMagic);
+        stream.writeInt(indexVersion);
+        stream.writeInt(PresetManager::stateVersion);
+        stream.writeInt((int) scannedEntries.size());
+        
+        for (const auto& [name, entry] : scannedEntries)
+        {
+            stream.writeString(entry->name);
+            stream.writeString(entry->tags.joinIntoString(","));
+            stream.writeInt64(entry->fileSize);
+            stream.writeInt64(entry->modificationTime);
+            stream.writeInt64((juce::int64) entry->hash);
+            stream.writeInt64((juce::int64) entry->state.getSize());
+            stream.write(entry->state.getData(), entry->state.getSize());
+        }
+    }
+    
+    if (! temporary.overwriteTargetFileWithTemporary())
+        DBG("Could not write preset index: " + indexFile.getFullPathName());
+}
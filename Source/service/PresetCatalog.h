@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    PresetCatalog.h
+    Created: 19 Oct 2026 10:41:09pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    An in-memory index of the preset directory, so browsing never touches the
+    disk. Every entry keeps the preset's name, tags, a content hash and its
+    state already converted to the binary state format, ready to apply.
+    
+    A low priority thread keeps the index current. It scans once at startup
+    and whenever rescanNow() is called, and only reads files whose size or
+    modification time changed. Changes made outside the plugin need polling,
+    as JUCE has no portable directory notifications. The thread only polls
+    while a preset browser is on screen, and it backs off from every 2 s to
+    every 32 s while nothing changes. The index is saved to a per-user file,
+    so a fresh session only re-reads what changed since.
+    
+    Entries are published to the message thread in one swap, and all of the
+    public getters are message thread only. Listeners hear about changes
+    through ChangeBroadcaster.
+    
+    There is one catalog per process, held through a SharedResourcePointer,
+    so however many plugin instances are open there is a single scanner, a
+    single copy of the library in memory and a single writer of the index.
+*/
+class PresetCatalog  : public juce::ChangeBroadcaster
+                     , private juce::Thread
+                     , private juce::AsyncUpdater
+{
+public:
+    struct Entry
+    {
+        juce::String name;
+        juce::StringArray tags;
+        juce::int64 fileSize { 0 };
+        juce::int64 modificationTime { 0 };
+        juce::uint64 hash { 0 };
+        juce::MemoryBlock state;
+    };
+    
+    using EntryPtr = std::shared_ptr<const Entry>;
+    
+    /* scans PresetManager's directory; only ever made by SharedResourcePointer */
+    PresetCatalog();
+    ~PresetCatalog() override;
+    
+    int getNumPresets() const;
+    juce::StringArray getPresetNames() const;
+    int indexOf(const juce::String& name) const;
+    EntryPtr getEntry(int index) const;
+    EntryPtr getEntry(const juce::String& name) const;
+    
+    /* indexes of presets whose name or tags contain every word of the query */
+    juce::Array<int> search(const juce::String& query) const;
+    
+    /* wakes the scanner, e.g. straight after saving or deleting a preset */
+    void rescanNow();
+    
+    /* message thread; each browser on screen holds one, and the directory is only polled while any do */
+    void addWatcher();
+    void removeWatcher();
+    
+private:
+    void run() override;
+    void handleAsyncUpdate() override;
+    
+    bool scanDirectory();
+    EntryPtr readPreset(const juce::File& file, juce::int64 fileSize, juce::int64 modificationTime,
+                        const EntryPtr& previous) const;
+    bool convertToState(const juce::XmlElement& xml, juce::MemoryBlock& state) const;
+    void publish();
+    
+    void loadIndex();
+    void saveIndex() const;
+    
+    static constexpr int indexMagic { 0x7843434c }; // "LCCx"
+    static constexpr int indexVersion { 1 };
+    static constexpr int minRescanIntervalMs { 2000 };
+    static constexpr int maxRescanIntervalMs { 32000 };
+    
+    const juce::File directory;
+    const juce::String wildcard;
+    const juce::File indexFile;
+    const juce::Identifier parameterTreeType, nonParamTreeType;
+    
+    std::atomic<int> numWatchers { 0 };
+    
+    // scanner thread only, keyed by file name
+    std::map<juce::String, EntryPtr> scannedEntries;
+    
+    juce::CriticalSection pendingLock;
+    std::vector<EntryPtr> pendingEntries;
+    
+    // message thread only, sorted by name
+    std::vector<EntryPtr> entries;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetCatalog)
+};
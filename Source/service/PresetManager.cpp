@@ -8,6 +8,8 @@
 */
 
 #include "PresetManager.h"
+#include "StateDiff.h"
+#include "ParameterHelper.h"
 
 const juce::File PresetManager::defaultDirectory {
     juce::File::getSpecialLocation(juce::File::SpecialLocationType::commonDocumentsDirectory)
@@ -17,10 +19,11 @@ const juce::File PresetManager::defaultDirectory {
 const juce::String PresetManager::extension { "preset" };
 //const juce::String PresetManager::presetNameProperty { "presetName" };
 
-PresetManager::PresetManager(juce::AudioProcessorValueTreeState& t_apvts, juce::ValueTree t_nonParamTree)
+PresetManager::PresetManager(juce::AudioProcessorValueTreeState& t_apvts, juce::ValueTree t_nonParamTree, TableRebuilder& t_tableRebuilder)
 : apvts(t_apvts)
 , nonParamTree(t_nonParamTree)
 , settingsTree(nonParamTree.getChildWithName(ParamIDs::settingsTree))
+, tableRebuilder(t_tableRebuilder)
 {
     // Create a default Preset Directory, if it doesn't exist
     if (!defaultDirectory.exists())
@@ -35,6 +38,24 @@ PresetManager::PresetManager(juce::AudioProcessorValueTreeState& t_apvts, juce::
 
 //    settingsTree.addListener(this);
     currentPreset.referTo(settingsTree.getPropertyAsValue(ParamIDs::currentPreset, nullptr));
+    
+    catalog->addChangeListener(this);
+    
+    for (auto* parameter : apvts.processor.getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            parametersByKey.emplace_back(getStableParameterKey(ranged->paramID), ranged);
+    
+    std::sort(parametersByKey.begin(), parametersByKey.end(),
+              [] (const auto& a, const auto& b) { return a.first < b.first; });
+    
+    // two IDs hashing to the same key would share one slot in saved state; rename one of them
+    jassert(std::adjacent_find(parametersByKey.begin(), parametersByKey.end(),
+                               [] (const auto& a, const auto& b) { return a.first == b.first; }) == parametersByKey.end());
+}
+
+PresetManager::~PresetManager()
+{
+    catalog->removeChangeListener(this);
 }
 
 void PresetManager::savePreset(const juce::String& presetName)
@@ -52,6 +73,8 @@ void PresetManager::savePreset(const juce::String& presetName)
         DBG("Could not create preset file: " + presetFile.getFullPathName());
         jassertfalse;
     }
+    
+    catalog->rescanNow();
 }
 
 void PresetManager::deletePreset(const juce::String& presetName)
@@ -73,60 +96,104 @@ void PresetManager::deletePreset(const juce::String& presetName)
         return;
     }
     currentPreset.setValue("");
+    catalog->rescanNow();
 }
 
 void PresetManager::loadPreset(const juce::String& presetName)
 {
     if (presetName.isEmpty())
         return;
-
-    const auto presetFile = defaultDirectory.getChildFile(presetName + "." + extension);
-    if (!presetFile.existsAsFile())
+    
+    const auto entry = catalog->getEntry(presetName);
+    
+    if (entry == nullptr)
     {
-        DBG("Preset file " + presetFile.getFullPathName() + " does not exist");
-        jassertfalse;
+        const auto presetFile = defaultDirectory.getChildFile(presetName + "." + extension);
+        if (!presetFile.existsAsFile())
+        {
+            DBG("Preset file " + presetFile.getFullPathName() + " does not exist");
+            jassertfalse;
+            return;
+        }
+        
+        // not catalogued yet, e.g. saved a moment ago; loads once the catalog has parsed it
+        presetAwaitingCatalog = presetName;
+        catalog->rescanNow();
         return;
     }
     
-    juce::XmlDocument xmlDocument { presetFile };
+    // rapid browsing just replaces the pending preset; only the last one is applied
+    presetAwaitingCatalog.clear();
+    pendingEntry = entry;
+    awaitingRebuilds = false;
+    currentPreset.setValue(presetName);
     
-    std::unique_ptr<juce::XmlElement> xmlState = xmlDocument.getDocumentElement();
-    loadStateFromXml(std::move(xmlState));
+    transition.fadeOut();
+    transitionWaitedMs = 0;
+    startTimer(transitionPollMs);
+}
 
-    currentPreset.setValue(presetName);
+void PresetManager::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    if (source == &catalog.get() && presetAwaitingCatalog.isNotEmpty() && catalog->getEntry(presetAwaitingCatalog) != nullptr)
+        loadPreset(presetAwaitingCatalog);
+}
+
+void PresetManager::timerCallback()
+{
+    transitionWaitedMs += transitionPollMs;
+    
+    if (awaitingRebuilds)
+    {
+        if (! tableRebuilder.hasFinished(rebuildTicket))
+            return;
+        
+        stopTimer();
+        awaitingRebuilds = false;
+        transition.fadeIn();
+        return;
+    }
+    
+    if (!transition.isSilent() && transitionWaitedMs < maxTransitionWaitMs)
+        return;
+    
+    if (pendingEntry != nullptr)
+        loadStateFromBinary(pendingEntry->state.getData(), (int) pendingEntry->state.getSize());
+    
+    pendingEntry = nullptr;
+    
+    // the curves and envelopes the new state asked for have to be in place before anything is heard,
+    // but they're built on the rebuild thread; this only polls for it to be done
+    rebuildTicket = tableRebuilder.getRequestTicket();
+    awaitingRebuilds = true;
+    tableRebuilder.runSoon();
 }
 
 int PresetManager::loadNextPreset()
 {
-    const auto allPresets = getAllPresets();
-    if (allPresets.isEmpty())
+    const auto numPresets = catalog->getNumPresets();
+    if (numPresets == 0)
         return -1;
-    const auto currentIndex = allPresets.indexOf(currentPreset.toString());
-    const auto nextIndex = currentIndex + 1 > (allPresets.size() - 1) ? 0 : currentIndex + 1;
-    loadPreset(allPresets.getReference(nextIndex));
+    const auto currentIndex = catalog->indexOf(currentPreset.toString());
+    const auto nextIndex = currentIndex + 1 > (numPresets - 1) ? 0 : currentIndex + 1;
+    loadPreset(catalog->getEntry(nextIndex)->name);
     return nextIndex;
 }
 
 int PresetManager::loadPreviousPreset()
 {
-    const auto allPresets = getAllPresets();
-    if (allPresets.isEmpty())
+    const auto numPresets = catalog->getNumPresets();
+    if (numPresets == 0)
         return -1;
-    const auto currentIndex = allPresets.indexOf(currentPreset.toString());
-    const auto previousIndex = currentIndex - 1 < 0 ? allPresets.size() - 1 : currentIndex - 1;
-    loadPreset(allPresets.getReference(previousIndex));
+    const auto currentIndex = catalog->indexOf(currentPreset.toString());
+    const auto previousIndex = currentIndex - 1 < 0 ? numPresets - 1 : currentIndex - 1;
+    loadPreset(catalog->getEntry(previousIndex)->name);
     return previousIndex;
 }
 
 juce::StringArray PresetManager::getAllPresets() const
 {
-    juce::StringArray presets;
-    const auto fileArray = defaultDirectory.findChildFiles(juce::File::TypesOfFileToFind::findFiles, false, "*." + extension);
-    for (const auto& file : fileArray)
-    {
-        presets.add(file.getFileNameWithoutExtension());
-    }
-    return presets;
+    return catalog->getPresetNames();
 }
 
 juce::String PresetManager::getCurrentPreset() const
@@ -134,6 +201,21 @@ juce::String PresetManager::getCurrentPreset() const
     return currentPreset.toString();
 }
 
+PresetCatalog& PresetManager::getCatalog()
+{
+    return catalog.get();
+}
+
+PresetTransition& PresetManager::getTransition()
+{
+    return transition;
+}
+
+StateChangeBatcher& PresetManager::getChangeBatcher()
+{
+    return changeBatcher;
+}
+
 std::unique_ptr<juce::XmlElement> PresetManager::getStateXml()
 {
     std::unique_ptr<juce::XmlElement> xmlParent (new juce::XmlElement("parent"));
@@ -149,47 +231,159 @@ std::unique_ptr<juce::XmlElement> PresetManager::getStateXml()
 
 void PresetManager::loadStateFromXml(std::unique_ptr<juce::XmlElement> xml)
 {
-    juce::XmlElement* xmlAPVTS = xml->getChildByName(apvts.state.getType());
-    juce::XmlElement* xmlNonAPVTS = xml->getChildByName(nonParamTree.getType());
-
     if (xml.get() != nullptr)
     {
+        StateChangeBatcher::ScopedBatch batch (changeBatcher);
+        
+        juce::XmlElement* xmlAPVTS = xml->getChildByName(apvts.state.getType());
+        juce::XmlElement* xmlNonAPVTS = xml->getChildByName(nonParamTree.getType());
+        
         if (xmlAPVTS != nullptr)
             if (xmlAPVTS->hasTagName(apvts.state.getType()))
                 apvts.replaceState(juce::ValueTree::fromXml(*xmlAPVTS));
 
         if (xmlNonAPVTS != nullptr)
+        {
             if (xmlNonAPVTS->hasTagName(nonParamTree.getType()))
-                overwriteAllValueTreeProperties(juce::ValueTree::fromXml(*xmlNonAPVTS), nonParamTree);
+            {
+                // XML states carry no version, so they may come from before the node pool grew
+                juce::ValueTree nonParamState = juce::ValueTree::fromXml(*xmlNonAPVTS);
+                ParameterHelper::addMissingShaperNodes(nonParamState.getChildWithName(ParamIDs::waveshaperNodeTree));
+                overwriteAllValueTreeProperties(nonParamState, nonParamTree);
+            }
+        }
     }
 }
 
 void PresetManager::overwriteAllValueTreeProperties(juce::ValueTree treeToCopy, juce::ValueTree destTree)
 {
-    jassert(destTree.hasType(treeToCopy.getType()));
+    // only what differs is touched, so unchanged properties and children in place fire nothing
+    StateDiff::between(treeToCopy, destTree).apply();
+}
+
+void PresetManager::writeStateBinary(juce::MemoryBlock& destData)
+{
+    const auto& parameters = apvts.processor.getParameters();
+    std::vector<juce::uint32> keys;
+    std::vector<float> values;
     
-//    DBG(treeToCopy.getType().toString() + ", " + juce::String{treeToCopy.getNumProperties()});
-//    DBG(destTree.getType().toString() + ", " + juce::String{destTree.getNumProperties()});
+    keys.reserve((size_t) parameters.size());
+    values.reserve((size_t) parameters.size());
     
-    for (int i = 0; i < treeToCopy.getNumProperties(); i++)
+    // plain values, so a parameter whose range changes still comes back where it was
+    for (auto* parameter : parameters)
     {
-        auto propertyName = treeToCopy.getPropertyName(i);
-        jassert(destTree.hasProperty(propertyName));
-        
-        auto val = treeToCopy.getProperty(propertyName);
-        destTree.setProperty(propertyName, val, nullptr);
+        auto* ranged = static_cast<juce::RangedAudioParameter*>(parameter);
+        keys.push_back(getStableParameterKey(ranged->paramID));
+        values.push_back(ranged->convertFrom0to1(ranged->getValue()));
     }
     
-    for (int i = 0; i < treeToCopy.getNumChildren(); i++)
+    juce::MemoryOutputStream stream (destData, false);
+    writeStateBinary(stream, keys, values, nonParamTree);
+}
+
+void PresetManager::writeStateBinary(juce::OutputStream& stream, const std::vector<juce::uint32>& keys,
+                                     const std::vector<float>& values, const juce::ValueTree& nonParamState)
+{
+    jassert(keys.size() == values.size());
+    
+    stream.writeInt(stateMagic);
+    stream.writeInt(stateVersion);
+    stream.writeInt((int) keys.size());
+    
+    for (auto key : keys)
+        stream.writeInt((int) key);
+    
+    for (auto value : values)
+        stream.writeFloat(value);
+    
+    nonParamState.writeToStream(stream);
+}
+
+bool PresetManager::loadStateFromBinary(const void* data, int sizeInBytes)
+{
+    juce::MemoryInputStream stream (data, (size_t) juce::jmax(sizeInBytes, 0), false);
+    
+    if (sizeInBytes < 12 || stream.readInt() != stateMagic)
+        return false;
+    
+    const int version = stream.readInt();
+    const int numParameters = stream.readInt();
+    
+    if (version > stateVersion)
+        DBG("State was saved by a newer version (" + juce::String(version) + "); loading what this version understands");
+    
+    if (numParameters < 0 || stream.getNumBytesRemaining() < (juce::int64) numParameters * 8)
     {
-        juce::ValueTree copyChild = treeToCopy.getChild(i);
-        juce::ValueTree destChild = destTree.getChildWithName(copyChild.getType());
-        jassert(destChild.isValid());
+        DBG("Binary state is truncated");
+        jassertfalse;
+        return true;
+    }
+    
+    StateChangeBatcher::ScopedBatch batch (changeBatcher);
+    juce::HeapBlock<juce::uint32> keys ((size_t) numParameters);
+    std::vector<bool> inState (parametersByKey.size(), false);
+    
+    for (int i = 0; i < numParameters; i++)
+        keys[i] = (juce::uint32) stream.readInt();
+    
+    for (int i = 0; i < numParameters; i++)
+    {
+        const float value = stream.readFloat();
+        const auto found = std::lower_bound(parametersByKey.begin(), parametersByKey.end(), keys[i],
+                                            [] (const auto& entry, juce::uint32 key) { return entry.first < key; });
+        
+        // parameters that no longer exist are skipped
+        if (found == parametersByKey.end() || found->first != keys[i])
+            continue;
+        
+        inState[(size_t) std::distance(parametersByKey.begin(), found)] = true;
         
-//        DBG(copyChild.getType().toString() + " has index: " + juce::String(treeToCopy.indexOf(copyChild)) + ", " + destChild.getType().toString() + " has index: " + juce::String(destTree.indexOf(destChild)));
+        // setValueNotifyingHost notifies even when nothing changes, so unchanged values are left alone
+        auto* parameter = found->second;
+        const float normalisedValue = parameter->convertTo0to1(value);
         
-        destTree.moveChild(destTree.indexOf(destChild), treeToCopy.indexOf(copyChild), nullptr);
+        if (normalisedValue != parameter->getValue())
+            parameter->setValueNotifyingHost(normalisedValue);
+    }
+    
+    // ones missing from the state, e.g. added since it was saved, go back to their defaults as replaceState would have
+    // left them, rather than keeping whatever the last patch set
+    for (size_t i = 0; i < parametersByKey.size(); i++)
+    {
+        auto* parameter = parametersByKey[i].second;
         
-        overwriteAllValueTreeProperties(copyChild, destChild);
+        if (! inState[i] && parameter->getValue() != parameter->getDefaultValue())
+            parameter->setValueNotifyingHost(parameter->getDefaultValue());
     }
+    
+    juce::ValueTree nonParamState = juce::ValueTree::readFromStream(stream);
+    
+    if (nonParamState.hasType(nonParamTree.getType()))
+    {
+        migrateState(version, nonParamState);
+        overwriteAllValueTreeProperties(nonParamState, nonParamTree);
+    }
+    
+    return true;
+}
+
+juce::uint32 PresetManager::getStableParameterKey(const juce::String& parameterID)
+{
+    // FNV-1a over the UTF-8 ID; fixed forever, since saved states depend on it
+    juce::uint32 hash = 2166136261u;
+    
+    for (auto* character = parameterID.toRawUTF8(); *character != 0; character++)
+        hash = (hash ^ (juce::uint8) *character) * 16777619u;
+    
+    return hash;
+}
+
+void PresetManager::migrateState(int fromVersion, juce::ValueTree& nonParamState)
+{
+    // each bump adds a step here, so old states climb one version at a time
+    
+    // version 2 grew the waveshaper node pool from 5 to ParameterHelper::numShaperNodes
+    if (fromVersion < 2)
+        ParameterHelper::addMissingShaperNodes(nonParamState.getChildWithName(ParamIDs::waveshaperNodeTree));
 }
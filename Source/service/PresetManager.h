@@ -11,31 +11,89 @@
 
 #include <JuceHeader.h>
 #include "ParamIDs.h"
+#include "PresetCatalog.h"
+#include "PresetTransition.h"
+#include "StateChangeBatcher.h"
+#include "TableRebuilder.h"
 
-class PresetManager
+class PresetManager  : private juce::ChangeListener
+                     , private juce::Timer
 {
 public:
     static const juce::File defaultDirectory;
     static const juce::String extension;
 //    static const juce::String presetNameProperty;
 
-    PresetManager(juce::AudioProcessorValueTreeState&, juce::ValueTree);
+    /* the rebuilder is only used once a preset loads, so it may be constructed after this */
+    PresetManager(juce::AudioProcessorValueTreeState&, juce::ValueTree, TableRebuilder&);
+    ~PresetManager() override;
 
     void savePreset(const juce::String& presetName);
     void deletePreset(const juce::String& presetName);
+    /* asynchronous: the output fades out, the catalogued state is applied whole, then it fades back in */
     void loadPreset(const juce::String& presetName);
     int loadNextPreset();
     int loadPreviousPreset();
     juce::StringArray getAllPresets() const;
     juce::String getCurrentPreset() const;
+    PresetCatalog& getCatalog();
+    PresetTransition& getTransition();
+    /* listeners with expensive rebuilds defer them through this, so a state load runs each once */
+    StateChangeBatcher& getChangeBatcher();
     
     std::unique_ptr<juce::XmlElement> getStateXml();
     void loadStateFromXml(std::unique_ptr<juce::XmlElement>);
     static void overwriteAllValueTreeProperties(juce::ValueTree treeToCopy, juce::ValueTree destTree);
     
+    /*
+        Host state, in a compact binary layout:
+            magic, schema version, parameter count,
+            stable parameter keys, then plain parameter values (both dense arrays),
+            the non-parameter tree in ValueTree's own binary format.
+        Keys are hashes of the parameter IDs, so parameters can be added, removed or
+        reordered without breaking old states; anything that needs more than that
+        bumps stateVersion and gets a step in migrateState.
+    */
+    void writeStateBinary(juce::MemoryBlock& destData);
+    static void writeStateBinary(juce::OutputStream& stream, const std::vector<juce::uint32>& keys,
+                                 const std::vector<float>& values, const juce::ValueTree& nonParamState);
+    /* returns false if the data isn't in the binary format, so the caller can try the XML reader */
+    bool loadStateFromBinary(const void* data, int sizeInBytes);
+    
+    static juce::uint32 getStableParameterKey(const juce::String& parameterID);
+    
+    static constexpr int stateMagic { 0x7453434c }; // "LCSt"
+    static constexpr int stateVersion { 2 };
+    
 private:
+    static void migrateState(int fromVersion, juce::ValueTree& nonParamState);
+    
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+    void timerCallback() override;
+    
+    static constexpr int transitionPollMs { 5 };
+    // without audio running the fade never finishes, so the state goes in after this anyway
+    static constexpr int maxTransitionWaitMs { 200 };
+    
     juce::AudioProcessorValueTreeState& apvts;
     juce::ValueTree nonParamTree;
     juce::ValueTree settingsTree;
     juce::Value currentPreset;
+    TableRebuilder& tableRebuilder;
+    
+    StateChangeBatcher changeBatcher;
+    // shared by every instance in the process
+    juce::SharedResourcePointer<PresetCatalog> catalog;
+    PresetTransition transition;
+    
+    PresetCatalog::EntryPtr pendingEntry;
+    juce::String presetAwaitingCatalog;
+    int transitionWaitedMs { 0 };
+    
+    // once the state is in, the fade waits for the rebuilds it asked for
+    bool awaitingRebuilds { false };
+    juce::uint32 rebuildTicket { 0 };
+    
+    // sorted by key, for lookups while loading binary state
+    std::vector<std::pair<juce::uint32, juce::RangedAudioParameter*>> parametersByKey;
 };
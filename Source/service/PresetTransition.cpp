@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    PresetTransition.cpp
+    Created: 19 Oct 2026 11:18:52pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "PresetTransition.h"
+
+void PresetTransition::prepare (double sampleRate)
+{
+    gainPerSample = 1.0f / juce::jmax(1.0f, (float) sampleRate * fadeSeconds);
+}
+
+float PresetTransition::advance (int numSamples) noexcept
+{
+    const float previousGain = gain;
+    int current = state.load();
+    
+    if (current == fadingOut)
+    {
+        gain = juce::jmax(0.0f, gain - gainPerSample * numSamples);
+        
+        if (gain == 0.0f)
+            state.compare_exchange_strong(current, silent);
+    }
+    else if (current == fadingIn)
+    {
+        gain = juce::jmin(1.0f, gain + gainPerSample * numSamples);
+        
+        if (gain == 1.0f)
+            state.compare_exchange_strong(current, idle);
+    }
+    else
+    {
+        gain = current == silent ? 0.0f : 1.0f;
+    }
+    
+    ramping = gain != previousGain;
+    return gain;
+}
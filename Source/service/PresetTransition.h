@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    PresetTransition.h
+    Created: 19 Oct 2026 11:18:52pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    Fades the plugin's output out and back in around a preset change, so the
+    state is only ever swapped while nothing is audible and no block is heard
+    with half of the new preset applied.
+    
+    The message thread asks for a fade out, waits for isSilent(), applies the
+    state in one go and asks for the fade in. The audio thread advances the
+    fade once per block and feeds the gain to the master stage. The state
+    lives in one atomic; the audio thread only moves it on with a
+    compare-exchange, so a newer request from the message thread always wins.
+*/
+class PresetTransition
+{
+public:
+    PresetTransition() = default;
+    
+    void prepare (double sampleRate);
+    
+    /* message thread */
+    void fadeOut() noexcept  { state.store(fadingOut); }
+    void fadeIn() noexcept   { state.store(fadingIn); }
+    bool isSilent() const noexcept { return state.load() == silent; }
+    
+    /* audio thread; the gain to reach by the end of this block */
+    float advance (int numSamples) noexcept;
+    /* audio thread; true if the last advance moved the gain, so it should be ramped across the block */
+    bool isRamping() const noexcept { return ramping; }
+    
+    static constexpr float fadeSeconds { 0.015f };
+
+private:
+    enum State { idle, fadingOut, silent, fadingIn };
+    
+    std::atomic<int> state { idle };
+    
+    float gain { 1.0f };
+    float gainPerSample { 1.0f };
+    bool ramping { false };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetTransition);
+};
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    StateChangeBatcher.cpp
+    Created: 19 Oct 2026 11:52:30pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "StateChangeBatcher.h"
+
+void StateChangeBatcher::runOrDefer (const void* key, std::function<void()> work)
+{
+    if (depth == 0)
+    {
+        work();
+        return;
+    }
+    
+    for (auto& [existingKey, existingWork] : deferred)
+    {
+        if (existingKey == key)
+        {
+            existingWork = std::move(work);
+            return;
+        }
+    }
+    
+    deferred.emplace_back(key, std::move(work));
+}
+
+void StateChangeBatcher::flush()
+{
+    // work can set state of its own, which mustn't be deferred into a queue that's already gone
+    auto pending = std::move(deferred);
+    deferred.clear();
+    
+    for (auto& [key, work] : pending)
+        work();
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    StateChangeBatcher.h
+    Created: 19 Oct 2026 11:52:30pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    Holds back expensive listener work while a whole state is applied, so a
+    rebuild that several changed properties would each trigger runs once,
+    after the last of them.
+    
+    Listeners hand their work to runOrDefer(). Outside a batch it runs
+    straight away; inside one it is queued under the given key, and queuing
+    the same key again keeps just the one entry. The queue runs when the
+    outermost ScopedBatch ends. Message thread only.
+*/
+class StateChangeBatcher
+{
+public:
+    class ScopedBatch
+    {
+    public:
+        explicit ScopedBatch (StateChangeBatcher& t_batcher) : batcher(t_batcher) { batcher.depth++; }
+        ~ScopedBatch() { if (--batcher.depth == 0) batcher.flush(); }
+        
+    private:
+        StateChangeBatcher& batcher;
+        
+        JUCE_DECLARE_NON_COPYABLE (ScopedBatch)
+    };
+    
+    StateChangeBatcher() = default;
+    
+    void runOrDefer (const void* key, std::function<void()> work);
+    bool isBatching() const noexcept { return depth > 0; }
+
+private:
+    void flush();
+    
+    int depth { 0 };
+    std::vector<std::pair<const void*, std::function<void()>>> deferred;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StateChangeBatcher);
+};
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    StateDiff.cpp
+    Created: 19 Oct 2026 11:52:30pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "StateDiff.h"
+
+StateDiff StateDiff::between (const juce::ValueTree& incoming, const juce::ValueTree& current)
+{
+    jassert (current.hasType(incoming.getType()));
+    
+    StateDiff diff;
+    diff.collect(incoming, current);
+    return diff;
+}
+
+void StateDiff::collect (const juce::ValueTree& incoming, const juce::ValueTree& current)
+{
+    for (int i = 0; i < incoming.getNumProperties(); i++)
+    {
+        const auto name = incoming.getPropertyName(i);
+        const auto& value = incoming.getProperty(name);
+        
+        // properties only a newer version knows about are skipped
+        if (! current.hasProperty(name))
+        {
+            DBG("StateDiff: skipping unknown property " + name.toString() + " of " + current.getType().toString());
+            continue;
+        }
+        
+        if (current.getProperty(name) != value)
+            propertyChanges.push_back({ current, name, value });
+    }
+    
+    // walk the wanted order against a copy of the current one, moving only what's out of place
+    std::vector<juce::ValueTree> order;
+    order.reserve((size_t) current.getNumChildren());
+    
+    for (const auto& child : current)
+        order.push_back(child);
+    
+    int position = 0;
+    
+    for (const auto& incomingChild : incoming)
+    {
+        const auto currentChild = current.getChildWithName(incomingChild.getType());
+        
+        // likewise children, since the diff never adds or removes any
+        if (! currentChild.isValid())
+        {
+            DBG("StateDiff: skipping unknown child " + incomingChild.getType().toString() + " of " + current.getType().toString());
+            continue;
+        }
+        
+        const auto found = std::find(order.begin() + position, order.end(), currentChild);
+        
+        if (found != order.begin() + position)
+        {
+            childMoves.push_back({ current, currentChild, position });
+            std::rotate(order.begin() + position, found, found + 1);
+        }
+        
+        position++;
+        
+        collect(incomingChild, currentChild);
+    }
+}
+
+void StateDiff::apply() const
+{
+    for (const auto& change : propertyChanges)
+        change.tree.setProperty(change.name, change.value, nullptr);
+    
+    for (const auto& move : childMoves)
+        move.parent.moveChild(move.parent.indexOf(move.child), move.newIndex, nullptr);
+}
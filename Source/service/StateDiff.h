@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    StateDiff.h
+    Created: 19 Oct 2026 11:52:30pm
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    The smallest set of edits that turns one ValueTree into another with the
+    same layout: property values that differ, and the child moves needed to
+    match the incoming child order. Children are matched by type, as every
+    child in the plugin's state has a type of its own.
+    
+    The diff never adds or removes anything. Properties and children that
+    only the incoming tree has are skipped, with a DBG line but no assert,
+    as states from newer versions carry them. Whatever only the current tree
+    has keeps its value, and such children end up after the matched ones;
+    callers that need them reset, like an older state's smaller waveshaper
+    node pool, fill in the incoming tree first.
+    
+    Applying a diff only sets what actually changed, so listeners only hear
+    about real changes, and a reorder costs one move per child out of place.
+*/
+class StateDiff
+{
+public:
+    /* what it takes to turn current into incoming; both trees must have the same type */
+    static StateDiff between (const juce::ValueTree& incoming, const juce::ValueTree& current);
+    
+    bool isEmpty() const noexcept { return propertyChanges.empty() && childMoves.empty(); }
+    int getNumChanges() const noexcept { return (int) (propertyChanges.size() + childMoves.size()); }
+    
+    void apply() const;
+
+private:
+    struct PropertyChange
+    {
+        juce::ValueTree tree;
+        juce::Identifier name;
+        juce::var value;
+    };
+    
+    struct ChildMove
+    {
+        juce::ValueTree parent;
+        juce::ValueTree child;
+        int newIndex;
+    };
+    
+    void collect (const juce::ValueTree& incoming, const juce::ValueTree& current);
+    
+    std::vector<PropertyChange> propertyChanges;
+    std::vector<ChildMove> childMoves;
+};
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    SwappableTable.cpp
+    Created: 21 Oct 2026 9:14:27am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "SwappableTable.h"
+
+SwappableTable::ScopedRead::ScopedRead (const SwappableTable& table) noexcept
+: owner(table)
+{
+    // the slot only counts as held once it's still current after the reader is registered on it
+    for (;;)
+    {
+        slot = owner.current.load();
+        owner.readers[(size_t) slot].fetch_add(1);
+        
+        if (owner.current.load() == slot)
+            return;
+        
+        owner.readers[(size_t) slot].fetch_sub(1);
+    }
+}
+
+SwappableTable::ScopedRead::~ScopedRead()
+{
+    owner.readers[(size_t) slot].fetch_sub(1);
+}
+
+void SwappableTable::initialise (const std::function<float (float)>& function, float minInput, float maxInput, size_t numPoints)
+{
+    const int live = current.load();
+    int spare = -1;
+    
+    while (spare < 0)
+    {
+        for (int slot = 0; slot < numSlots && spare < 0; slot++)
+            if (slot != live && readers[(size_t) slot].load() == 0)
+                spare = slot;
+        
+        if (spare < 0)
+            juce::Thread::yield();
+    }
+    
+    // a reader that registers on the spare from here on sees it isn't current and moves off it
+    slots[(size_t) spare].initialise(function, minInput, maxInput, numPoints);
+    current.store(spare);
+}
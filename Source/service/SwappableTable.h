@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    SwappableTable.h
+    Created: 21 Oct 2026 9:14:27am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    A juce::dsp::LookupTableTransform that one thread rebuilds while any
+    number of others, the audio thread included, read it.
+    
+    initialise() builds into a slot nobody is reading and then makes it the
+    current one, so a reader never sees a table half rewritten. Readers
+    hold a slot for as long as a ScopedRead lives, which costs an atomic
+    increment and decrement and never blocks. With three slots the writer
+    has a spare unless two readers are stuck on two old tables, and then it waits.
+    
+    Only one thread may initialise at a time. TableRebuilder's pass lock
+    sees to that for everything it rebuilds.
+*/
+class SwappableTable
+{
+public:
+    using Table = juce::dsp::LookupTableTransform<float>;
+    
+    class ScopedRead
+    {
+    public:
+        explicit ScopedRead (const SwappableTable& table) noexcept;
+        ~ScopedRead();
+        
+        const Table& operator*() const noexcept  { return owner.slots[(size_t) slot]; }
+        const Table* operator->() const noexcept { return &owner.slots[(size_t) slot]; }
+    
+    private:
+        const SwappableTable& owner;
+        int slot;
+        
+        JUCE_DECLARE_NON_COPYABLE (ScopedRead)
+    };
+    
+    SwappableTable() = default;
+    
+    /* non-realtime; the same arguments as LookupTableTransform::initialise */
+    void initialise (const std::function<float (float)>& function, float minInput, float maxInput, size_t numPoints);
+    
+    /* a single lookup; hold a ScopedRead instead when looking up many points that should agree */
+    float processSample (float input) const noexcept
+    {
+        const ScopedRead table (*this);
+        return table->processSample(input);
+    }
+
+private:
+    static constexpr int numSlots { 3 };
+    
+    std::array<Table, numSlots> slots;
+    mutable std::array<std::atomic<int>, numSlots> readers {};
+    std::atomic<int> current { 0 };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SwappableTable);
+};
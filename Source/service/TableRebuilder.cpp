@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    TableRebuilder.cpp
+    Created: 20 Oct 2026 7:25:34am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "TableRebuilder.h"
+
+TableRebuilder::TableRebuilder()
+: juce::Thread("Table Rebuilder")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+TableRebuilder::~TableRebuilder()
+{
+    stopThread(1000);
+}
+
+int TableRebuilder::addJob (std::function<void()> rebuild)
+{
+    const int job = numJobs.load();
+    
+    jassert (job < maxJobs);
+    if (job >= maxJobs)
+        return -1;
+    
+    jobs[(size_t) job].rebuild = std::move(rebuild);
+    
+    // publishes the job to the thread only once its function is in place
+    numJobs.store(job + 1, std::memory_order_release);
+    return job;
+}
+
+void TableRebuilder::request (int job) noexcept
+{
+    if (juce::isPositiveAndBelow(job, numJobs.load(std::memory_order_acquire)))
+    {
+        jobs[(size_t) job].pending.store(true);
+        numRequests.fetch_add(1);
+    }
+}
+
+void TableRebuilder::runSoon()
+{
+    notify();
+}
+
+void TableRebuilder::run()
+{
+    // polling once a frame keeps request() free of locks; anything requested while a pass runs waits for the next
+    while (! threadShouldExit())
+    {
+        runPass();
+        wait(frameIntervalMs);
+    }
+}
+
+void TableRebuilder::runPendingJobs()
+{
+    runPass();
+}
+
+void TableRebuilder::runPass()
+{
+    const juce::ScopedLock lock (passLock);
+    const juce::uint32 ticket = numRequests.load();
+    const int count = numJobs.load(std::memory_order_acquire);
+    
+    for (int job = 0; job < count; job++)
+        if (jobs[(size_t) job].pending.exchange(false))
+            jobs[(size_t) job].rebuild();
+    
+    finishedTicket.store(ticket);
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    TableRebuilder.h
+    Created: 20 Oct 2026 7:25:34am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    Runs the lookup table rebuilds behind the envelope slopes and the
+    waveshaper curve on a background thread, at most once a frame each.
+    
+    Each rebuild is registered once with addJob(). request() only raises
+    that job's flag, so it's safe from any thread, the audio thread
+    included, and however many requests arrive between two passes cost a
+    single rebuild. A drag that changes a slope on every mouse event
+    therefore rebuilds its table once a frame, off the message thread.
+    
+    Because requests collapse, a rebuild must read its inputs when it
+    runs rather than capture them when it's requested. The tables are
+    SwappableTables, so voices and the editor go on reading the old one
+    until the new one is whole. Table owners then publish a new version,
+    which the editor polls.
+    
+    Something that needs its rebuilds in place before it carries on, like
+    a preset fading back in, takes a ticket after its requests and polls
+    hasFinished() with it; the work itself stays on the rebuild thread.
+*/
+class TableRebuilder  : private juce::Thread
+{
+public:
+    static constexpr int maxJobs { 16 };
+    static constexpr int frameIntervalMs { 16 };
+    
+    TableRebuilder();
+    ~TableRebuilder() override;
+    
+    /* message thread; returns the id to request the job by */
+    int addJob (std::function<void()> rebuild);
+    
+    /* any thread; never blocks or allocates */
+    void request (int job) noexcept;
+    
+    /* any thread; covers every request made before it's taken */
+    juce::uint32 getRequestTicket() const noexcept { return numRequests.load(); }
+    
+    /* any thread; true once a pass that started after the ticket was taken has finished */
+    bool hasFinished (juce::uint32 ticket) const noexcept { return (juce::int32) (finishedTicket.load() - ticket) >= 0; }
+    
+    /* any thread but the audio thread; starts the next pass now rather than at the next frame */
+    void runSoon();
+    
+    /* any thread but the audio thread; runs whatever is pending now, for callers like the offline
+       renderer that need every table current before they carry on */
+    void runPendingJobs();
+
+private:
+    struct Job
+    {
+        std::function<void()> rebuild;
+        std::atomic<bool> pending { false };
+    };
+    
+    void run() override;
+    void runPass();
+    
+    // a job's rebuild is never run on two threads at once
+    juce::CriticalSection passLock;
+    std::array<Job, maxJobs> jobs;
+    std::atomic<int> numJobs { 0 };
+    
+    // counted after the flag is raised, so a pass that reads the count sees every flag it covers
+    std::atomic<juce::uint32> numRequests { 0 };
+    std::atomic<juce::uint32> finishedTicket { 0 };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TableRebuilder);
+};
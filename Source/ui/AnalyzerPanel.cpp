@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    AnalyzerPanel.cpp
+    Created: 20 Oct 2026 6:40:51am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AnalyzerPanel.h"
+
+AnalyzerPanel::AnalyzerPanel(ScopeAnalyzer& t_analyzer)
+: analyzer(t_analyzer)
+{
+    setOpaque(true);
+}
+
+AnalyzerPanel::~AnalyzerPanel()
+{
+    analyzer.setActive(false);
+}
+
+void AnalyzerPanel::mouseDown (const juce::MouseEvent& event)
+{
+    setVisible(false);
+}
+
+void AnalyzerPanel::paint (juce::Graphics& g)
+{
+    /* ----- DRAW GRID ----- */
+    
+    if (frame.maximumFrequency != gridMaximumFrequency)
+    {
+        gridMaximumFrequency = frame.maximumFrequency;
+        gridLayer.invalidate();
+    }
+    
+    gridLayer.draw(g, getLocalBounds(), [this] (juce::Graphics& g)
+    {
+        g.fillAll(MyColors::background);
+        
+        g.setColour(MyColors::viewBackground);
+        g.fillRect(scopeArea);
+        g.fillRect(spectrumArea);
+        
+        juce::Path gridLines;
+        
+        gridLines.startNewSubPath(scopeArea.getX(), scopeArea.getCentreY());
+        gridLines.lineTo(scopeArea.getRight(), scopeArea.getCentreY());
+        
+        for (float decibels = -12.0f; decibels > ScopeAnalyzer::minimumDecibels; decibels -= 12.0f)
+        {
+            gridLines.startNewSubPath(spectrumArea.getX(), decibelsToY(decibels));
+            gridLines.lineTo(spectrumArea.getRight(), decibelsToY(decibels));
+        }
+        
+        g.setFont(10.0f);
+        
+        for (float decade = 100.0f; decade < gridMaximumFrequency; decade *= 10.0f)
+        {
+            for (int multiple = 1; multiple < 10 && decade * multiple < gridMaximumFrequency; multiple++)
+            {
+                const float x = frequencyToX(decade * multiple);
+                gridLines.startNewSubPath(x, spectrumArea.getY());
+                gridLines.lineTo(x, spectrumArea.getBottom());
+            }
+            
+            g.setColour(MyColors::lightNeutral);
+            g.drawText(decade < 1000.0f ? juce::String((int) decade) : juce::String((int) decade / 1000) + "k",
+                       juce::Rectangle<float> (frequencyToX(decade) + 2.0f, spectrumArea.getBottom() - 12.0f, 30.0f, 12.0f),
+                       juce::Justification::centredLeft);
+        }
+        
+        g.setColour(MyColors::darkPrimary);
+        g.strokePath(gridLines, juce::PathStrokeType(MyWidths::thinWidth));
+        
+        g.setColour(MyColors::darkNeutral);
+        GUIHelper::drawRectangleWithThickness(g, scopeArea.toFloat(), MyWidths::standardWidth);
+        GUIHelper::drawRectangleWithThickness(g, spectrumArea.toFloat(), MyWidths::standardWidth);
+    });
+    
+    /* ----- DRAW SCOPE ----- */
+    
+    const float columnWidth = (float) scopeArea.getWidth() / ScopeAnalyzer::numScopeColumns;
+    const float halfHeight = scopeArea.getHeight() * 0.5f - MyWidths::standardWidth;
+    const float centreY = (float) scopeArea.getCentreY();
+    
+    // the upper envelope left to right, then the lower one back again
+    juce::Path scopePath;
+    scopePath.startNewSubPath(scopeArea.getX(), centreY - frame.scopeMaximums[0] * halfHeight);
+    
+    for (int column = 0; column < ScopeAnalyzer::numScopeColumns; column++)
+        scopePath.lineTo(scopeArea.getX() + (column + 0.5f) * columnWidth, centreY - frame.scopeMaximums[(size_t) column] * halfHeight);
+    
+    for (int column = ScopeAnalyzer::numScopeColumns - 1; column >= 0; column--)
+        scopePath.lineTo(scopeArea.getX() + (column + 0.5f) * columnWidth, centreY - frame.scopeMinimums[(size_t) column] * halfHeight);
+    
+    scopePath.closeSubPath();
+    
+    g.setColour(MyColors::lightPrimary);
+    g.fillPath(scopePath);
+    g.strokePath(scopePath, juce::PathStrokeType(MyWidths::thinWidth));
+    
+    /* ----- DRAW SPECTRUM ----- */
+    
+    juce::Path spectrumPath, peakPath;
+    const float bandWidth = (float) spectrumArea.getWidth() / ScopeAnalyzer::numSpectrumBands;
+    
+    for (int band = 0; band < ScopeAnalyzer::numSpectrumBands; band++)
+    {
+        const float x = spectrumArea.getX() + (band + 0.5f) * bandWidth;
+        const float y = decibelsToY(frame.spectrum[(size_t) band]);
+        const float peakY = decibelsToY(frame.spectrumPeaks[(size_t) band]);
+        
+        if (band == 0)
+        {
+            spectrumPath.startNewSubPath(spectrumArea.getX(), spectrumArea.getBottom());
+            spectrumPath.lineTo(spectrumArea.getX(), y);
+            peakPath.startNewSubPath(spectrumArea.getX(), peakY);
+        }
+        
+        spectrumPath.lineTo(x, y);
+        peakPath.lineTo(x, peakY);
+    }
+    
+    spectrumPath.lineTo(spectrumArea.getRight(), decibelsToY(frame.spectrum.back()));
+    spectrumPath.lineTo(spectrumArea.getRight(), spectrumArea.getBottom());
+    spectrumPath.closeSubPath();
+    peakPath.lineTo(spectrumArea.getRight(), decibelsToY(frame.spectrumPeaks.back()));
+    
+    g.setColour(MyColors::mediumPrimary);
+    g.fillPath(spectrumPath);
+    g.setColour(MyColors::lightSecondary);
+    g.strokePath(peakPath, juce::PathStrokeType(MyWidths::thinWidth));
+}
+
+void AnalyzerPanel::resized()
+{
+    juce::Rectangle<int> bounds = getLocalBounds().reduced(MyWidths::standardMarginInt);
+    
+    scopeArea = bounds.removeFromTop(bounds.proportionOfHeight(0.4f));
+    bounds.removeFromTop(MyWidths::standardMarginInt);
+    spectrumArea = bounds;
+}
+
+void AnalyzerPanel::parentHierarchyChanged()
+{
+    frameAttachment.update();
+}
+
+void AnalyzerPanel::visibilityChanged()
+{
+    analyzer.setActive(isVisible());
+}
+
+float AnalyzerPanel::frequencyToX (float frequency) const
+{
+    const float proportion = std::log(frequency / ScopeAnalyzer::minimumFrequency)
+                           / std::log(gridMaximumFrequency / ScopeAnalyzer::minimumFrequency);
+    
+    return spectrumArea.getX() + proportion * spectrumArea.getWidth();
+}
+
+float AnalyzerPanel::decibelsToY (float decibels) const
+{
+    const float proportion = juce::jlimit(0.0f, 1.0f, decibels / ScopeAnalyzer::minimumDecibels);
+    
+    return spectrumArea.getY() + MyWidths::standardWidth + proportion * (spectrumArea.getHeight() - MyWidths::standardWidth * 2.0f);
+}
+
+juce::Rectangle<int> AnalyzerPanel::advanceFrame()
+{
+    if (! analyzer.getLatestFrame(frame))
+        return {};
+    
+    return scopeArea.getUnion(spectrumArea);
+}
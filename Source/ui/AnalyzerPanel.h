@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    AnalyzerPanel.h
+    Created: 20 Oct 2026 6:40:51am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "GUIHelper.h"
+#include "FrameScheduler.h"
+#include "CachedLayer.h"
+#include "../dsp/ScopeAnalyzer.h"
+
+/*
+    The output scope above, the spectrum with its peak hold below. It opens
+    over the effects from a click on the level meters and closes from a
+    click on itself; the analyzer only runs while it's visible.
+*/
+class AnalyzerPanel  : public juce::Component
+                     , private FrameScheduler::Client
+{
+public:
+    AnalyzerPanel(ScopeAnalyzer& analyzer);
+    ~AnalyzerPanel() override;
+    
+    void mouseDown (const juce::MouseEvent& event) override;
+    
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    void parentHierarchyChanged() override;
+    void visibilityChanged() override;
+
+private:
+    float frequencyToX (float frequency) const;
+    float decibelsToY (float decibels) const;
+    
+    ScopeAnalyzer& analyzer;
+    ScopeAnalyzer::Frame frame;
+    
+    juce::Rectangle<int> scopeArea, spectrumArea;
+    CachedLayer gridLayer;
+    float gridMaximumFrequency { 0.0f };
+    
+    juce::Rectangle<int> advanceFrame() override;
+    
+    FrameScheduler::Attachment frameAttachment { *this, *this, ScopeAnalyzer::framesPerSecond };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalyzerPanel)
+};
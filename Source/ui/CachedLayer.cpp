@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    CachedLayer.cpp
+    Created: 20 Oct 2026 1:52:40am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "CachedLayer.h"
+
+void CachedLayer::draw (juce::Graphics& g, juce::Rectangle<int> area, const Painter& painter)
+{
+    if (area.isEmpty())
+        return;
+    
+    // covers the host's scaling and the editor's own transform, so the image maps 1:1 onto screen pixels
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    
+    if (image.isNull() || area != cachedArea || scale != cachedScale)
+    {
+        image = juce::Image(juce::Image::ARGB,
+                            juce::jmax(1, juce::roundToInt(area.getWidth() * scale)),
+                            juce::jmax(1, juce::roundToInt(area.getHeight() * scale)),
+                            true);
+        
+        juce::Graphics imageGraphics (image);
+        imageGraphics.addTransform(juce::AffineTransform::translation((float) -area.getX(), (float) -area.getY()).scaled(scale));
+        painter(imageGraphics);
+        
+        cachedArea = area;
+        cachedScale = scale;
+    }
+    
+    juce::Graphics::ScopedSaveState state (g);
+    g.setOpacity(1.0f);
+    g.drawImage(image, area.toFloat());
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    CachedLayer.h
+    Created: 20 Oct 2026 1:52:40am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    A static part of a component's paint, rendered once into an image at the
+    display's pixel scale and blitted on every later paint.
+    
+    The painter draws in the component's own coordinates, exactly as it
+    would straight into paint()'s Graphics. The image is rendered again
+    only when the area or the physical pixel scale changes, or after
+    invalidate(), so grids and outlines cost one image copy per frame while
+    the curves and bars on top of them are still drawn live.
+*/
+class CachedLayer
+{
+public:
+    using Painter = std::function<void (juce::Graphics&)>;
+    
+    CachedLayer() = default;
+    
+    void draw (juce::Graphics& g, juce::Rectangle<int> area, const Painter& painter);
+    
+    /* for layers that depend on more than their size */
+    void invalidate() noexcept { image = {}; }
+
+private:
+    juce::Image image;
+    juce::Rectangle<int> cachedArea;
+    float cachedScale { 0.0f };
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedLayer);
+};
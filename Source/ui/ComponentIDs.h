@@ -68,12 +68,17 @@ constexpr auto delayMix { "delayMix" };
 constexpr auto delayFilter { "delayFilter" };
 constexpr auto delayFilterCenter { "delayFilterCenter" };
 constexpr auto delayFilterWidth { "delayFilterWidth" };
+constexpr auto delayMode { "delayMode" };
+constexpr auto delayCompactStorage { "delayCompactStorage" };
+constexpr auto delayTaps { "delayTaps" };
 
 constexpr auto reverbPad { "reverbPad" };
 constexpr auto reverbSize { "reverbSize" };
 constexpr auto reverbDamping { "reverbDamping" };
 constexpr auto reverbWidth { "reverbWidth" };
 constexpr auto reverbMix { "reverbMix" };
+constexpr auto reverbEngine { "reverbEngine" };
+constexpr auto reverbImpulse { "reverbImpulse" };
 
 constexpr auto filterVisualizer { "filterVisualizer" };
 constexpr auto filterLowCutoff { "filterLowCutoff" };
@@ -106,6 +111,7 @@ constexpr auto midiNote { "midiNote" };
 
 constexpr auto masterGain { "masterGain" };
 constexpr auto levelMeter { "levelMeter" };
+constexpr auto analyzerPanel { "analyzerPanel" };
 
 constexpr auto descriptionBox { "descriptionBox" };
 }
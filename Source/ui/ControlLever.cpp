@@ -14,7 +14,7 @@
 //==============================================================================
 ControlLever::ControlLever(juce::RangedAudioParameter& param, const juce::String labelText, juce::ValueTree t_lfoTree)
 : SliderBase(param, labelText, t_lfoTree)
-, handleSVG(juce::Drawable::createFromImageData(BinaryData::lever_handle_svg, BinaryData::lever_handle_svgSize))
+, handleSVG(svgCache->getDrawable(BinaryData::lever_handle_svg, BinaryData::lever_handle_svgSize))
 {
     setOpaque(true);
 }
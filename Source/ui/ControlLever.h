@@ -13,6 +13,7 @@
 #include <JuceHeader.h>
 #include "SliderBase.h"
 #include "GUIHelper.h"
+#include "SvgCache.h"
 
 class ControlLever  : public SliderBase
 {
@@ -24,6 +25,8 @@ public:
     void resized() override;
 
 private:
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> handleSVG;
     
     juce::Rectangle<int> mainArea;
@@ -12,7 +12,7 @@
 #include "CrosshairDragger.h"
 
 CrosshairDragger::CrosshairDragger(const juce::String t_description)
-: crosshair(juce::Drawable::createFromImageData(BinaryData::crosshair_svg, BinaryData::crosshair_svgSize))
+: crosshair(svgCache->getDrawable(BinaryData::crosshair_svg, BinaryData::crosshair_svgSize))
 , description(t_description)
 {
     setMouseCursor(juce::MouseCursor::CrosshairCursor);
@@ -12,6 +12,7 @@
 
 #include <JuceHeader.h>
 #include "GUIHelper.h"
+#include "SvgCache.h"
 
 //==============================================================================
 /*
@@ -27,6 +28,8 @@ public:
     void resized() override;
 
 private:
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> crosshair;
     
     const juce::String description;
@@ -17,8 +17,8 @@ DelayFilter::DelayFilter(juce::RangedAudioParameter& centerParam,
                          juce::ValueTree lfoTree,
                          double sampRate)
 : delayTree(t_delayTree)
-, filterIcon(juce::Drawable::createFromImageData(BinaryData::bandpass_svg, BinaryData::bandpass_svgSize))
-, offIcon(juce::Drawable::createFromImageData(BinaryData::cancel_svg, BinaryData::cancel_svgSize))
+, filterIcon(svgCache->getDrawable(BinaryData::bandpass_svg, BinaryData::bandpass_svgSize))
+, offIcon(svgCache->getDrawable(BinaryData::cancel_svg, BinaryData::cancel_svgSize))
 , centerParameter(centerParam)
 , widthParameter(widthParam)
 , centerAttachment(centerParameter, [&] (float value) { updateCenter(value); }, nullptr)
@@ -33,7 +33,7 @@ DelayFilter::DelayFilter(juce::RangedAudioParameter& centerParam,
     delayTree.addListener(this);
     
     filterOn = delayTree[ParamIDs::delayFilterIO];
-    magnitudes.resize(1);
+    response.onResponseReady = [this] (const std::vector<float>& decibels) { setResponseCurvePath(decibels); };
     
     addAndMakeVisible(ioButton);
     addAndMakeVisible(centerSlider);
@@ -119,7 +119,6 @@ void DelayFilter::resized()
     mainArea = bounds.removeFromTop(bounds.getHeight() - MyWidths::buttonDimension - margin);
     bounds.removeFromTop(margin);
     
-    magnitudes.resize(mainArea.getWidth());
     updateResponseCurve();
     
     ioButton.setBounds(bounds.removeFromRight(MyWidths::buttonDimension));
@@ -155,24 +154,30 @@ void DelayFilter::updateFilter()
 
 void DelayFilter::updateResponseCurve()
 {
-    const int numFrequencies = mainArea.getWidth();
+    std::vector<ResponseCurve::Stage> stages;
     
-    for (int i = 0; i < numFrequencies; i++)
+    if (filterOn)
     {
-        double mag = 1.0;
-        double freq = DSPHelper::mapNormalizedToFrequency((float) i / numFrequencies);
-        
-        if (filterOn)
-        {
-            mag *= lowpassCoeffs.getMagnitudeForFrequency(freq, sampleRate);
-            mag *= highpassCoeffs.getMagnitudeForFrequency(freq, sampleRate);
-        }
-        
-        magnitudes[i] = juce::Decibels::gainToDecibels(mag);
+        stages.push_back(ResponseCurve::makeStage(lowpassCoeffs));
+        stages.push_back(ResponseCurve::makeStage(highpassCoeffs));
     }
     
+    response.request(std::move(stages), mainArea.getWidth(), sampleRate);
+    
+    // the node follows the parameters straight away; the curve once the response is in
+    repaint();
+}
+
+void DelayFilter::setResponseCurvePath (const std::vector<float>& decibels)
+{
     responseCurve.clear();
     
+    if (decibels.empty())
+    {
+        repaint();
+        return;
+    }
+    
     const double outputMin = mainArea.getBottom();
     const double outputMax = mainArea.getY();
     auto map = [outputMin, outputMax](double input)
@@ -186,11 +191,11 @@ void DelayFilter::updateResponseCurve()
                           outputMax);
     };
     
-    responseCurve.startNewSubPath(mainArea.getX(), map(magnitudes.front()));
+    responseCurve.startNewSubPath(mainArea.getX(), map(decibels.front()));
     
-    for(int i = 1; i < magnitudes.size(); i++)
+    for(int i = 1; i < decibels.size(); i++)
     {
-        responseCurve.lineTo(mainArea.getX() + i, map(magnitudes[i]));
+        responseCurve.lineTo(mainArea.getX() + i, map(decibels[i]));
     }
     
     repaint();
@@ -15,6 +15,8 @@
 #include "GUIHelper.h"
 #include "TextSlider.h"
 #include "ValueTreeComponents.h"
+#include "ResponseCurve.h"
+#include "SvgCache.h"
 #include "../dsp/DSPHelper.h"
 #include "../service/ParamIDs.h"
 
@@ -41,12 +43,15 @@ public:
 private:
     void updateFilter();
     void updateResponseCurve();
+    void setResponseCurvePath (const std::vector<float>& decibels);
     
     void updateCenter(float newCenter);
     void updateWidth(float newWidth);
     
     juce::ValueTree delayTree;
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> filterIcon;
     std::unique_ptr<juce::Drawable> offIcon;
     
@@ -67,11 +72,11 @@ private:
     float currentWidth { 5.0f };
     
     juce::dsp::IIR::Coefficients<float> highpassCoeffs, lowpassCoeffs;
-    std::vector<double> magnitudes;
     
     bool filterOn;
     
     juce::Path responseCurve;
+    ResponseCurve response;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayFilter)
 };
@@ -22,11 +22,11 @@ DelayModule::DelayModule(PluginProcessor& t_processor,
 , apvts(t_apvts)
 , delayTree(t_delayTree)
 , lfoTree(t_lfoTree)
-, header(juce::Drawable::createFromImageData(BinaryData::delay_header_svg, BinaryData::delay_header_svgSize))
-, timeIcon(juce::Drawable::createFromImageData(BinaryData::frequencyTime_svg, BinaryData::frequencyTime_svgSize))
-, syncIcon(juce::Drawable::createFromImageData(BinaryData::frequencySync_svg, BinaryData::frequencySync_svgSize))
-, unlinkedIcon(juce::Drawable::createFromImageData(BinaryData::unlinked_svg, BinaryData::unlinked_svgSize))
-, linkedIcon(juce::Drawable::createFromImageData(BinaryData::linked_svg, BinaryData::linked_svgSize))
+, header(svgCache->getDrawable(BinaryData::delay_header_svg, BinaryData::delay_header_svgSize))
+, timeIcon(svgCache->getDrawable(BinaryData::frequencyTime_svg, BinaryData::frequencyTime_svgSize))
+, syncIcon(svgCache->getDrawable(BinaryData::frequencySync_svg, BinaryData::frequencySync_svgSize))
+, unlinkedIcon(svgCache->getDrawable(BinaryData::unlinked_svg, BinaryData::unlinked_svgSize))
+, linkedIcon(svgCache->getDrawable(BinaryData::linked_svg, BinaryData::linked_svgSize))
 , crosshair(ParamIDs::delayNode.toString())
 , delayLeftTime(*apvts.getParameter(ParamIDs::leftDelayTime), "Time L", lfoTree.getChildWithName(ParamIDs::lfoLeftDelayTime))
 , delayLeftSync(*apvts.getParameter(ParamIDs::leftDelaySync), "Sync L", lfoTree.getChildWithName(ParamIDs::lfoLeftDelaySync), ParameterHelper::syncOptions.size())
@@ -74,6 +74,49 @@ DelayModule::DelayModule(PluginProcessor& t_processor,
     delayFeedbackKnob.setComponentID(ComponentIDs::delayFeedback);
     mixSlider.setComponentID(ComponentIDs::delayMix);
     delayFilter.setComponentID(ComponentIDs::delayFilter);
+    
+    modeList.addItem("Stereo", ParameterHelper::stereo + 1);
+    modeList.addItem("Ping-Pong", ParameterHelper::pingPong + 1);
+    modeList.addItem("Multi-Tap", ParameterHelper::multiTap + 1);
+    modeList.setLookAndFeel(&lnf);
+    modeList.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    modeList.setComponentID(ComponentIDs::delayMode);
+    addAndMakeVisible(modeList);
+    
+    modeList.onChange = [this]
+    {
+        delayTree.setProperty(ParamIDs::delayMode, modeList.getSelectedId() - 1, nullptr);
+    };
+    
+    compactStorageButton.setButtonText("16-bit");
+    compactStorageButton.setClickingTogglesState(true);
+    compactStorageButton.getToggleStateValue().referTo(delayTree.getPropertyAsValue(ParamIDs::delayCompactStorage, nullptr));
+    compactStorageButton.setComponentID(ComponentIDs::delayCompactStorage);
+    
+    tapsButton.setButtonText("Taps");
+    tapsButton.setComponentID(ComponentIDs::delayTaps);
+    tapsButton.onClick = [this] { showTapEditor(); };
+    
+    for (auto* button : { &compactStorageButton, &tapsButton })
+    {
+        button->setColour(juce::TextButton::buttonColourId, MyColors::background);
+        button->setColour(juce::TextButton::buttonOnColourId, MyColors::darkPrimary);
+        button->setColour(juce::TextButton::textColourOffId, MyColors::lightNeutral);
+        button->setColour(juce::TextButton::textColourOnId, MyColors::white);
+        button->setColour(juce::ComboBox::outlineColourId, MyColors::mediumNeutral);
+        button->setMouseCursor(juce::MouseCursor::PointingHandCursor);
+        addAndMakeVisible(button);
+    }
+    
+    delayTree.addListener(this);
+    updateModeControls();
+}
+
+DelayModule::~DelayModule()
+{
+    delayTree.removeListener(this);
+    
+    modeList.setLookAndFeel(nullptr);
 }
 
 void DelayModule::paint (juce::Graphics& g)
@@ -125,5 +168,40 @@ void DelayModule::resized()
     delayFilter.setBounds(bounds.removeFromTop(delayFilterHeight));
     bounds.removeFromTop(margin);
     
-    delayFeedbackKnob.setBounds(MyWidths::knobBounds.withCentre(bounds.removeFromTop(MyWidths::knobDimension).getCentre()));
+    juce::Rectangle<int> feedbackArea = bounds.removeFromTop(MyWidths::knobDimension);
+    delayFeedbackKnob.setBounds(MyWidths::knobBounds.withCentre(feedbackArea.getCentre()));
+    
+    // mode on the left of the feedback knob, storage and taps stacked on its right
+    static const int selectorHeight = 24;
+    const int sideWidth = (feedbackArea.getWidth() - MyWidths::knobDimension) / 2 - 2 * margin;
+    juce::Rectangle<int> modeArea = feedbackArea.removeFromLeft(sideWidth + margin).withTrimmedLeft(margin);
+    modeList.setBounds(modeArea.withSizeKeepingCentre(sideWidth, selectorHeight));
+    juce::Rectangle<int> buttonsArea = feedbackArea.removeFromRight(sideWidth + margin).withTrimmedRight(margin)
+                                                   .withSizeKeepingCentre(sideWidth, 2 * selectorHeight + margin);
+    compactStorageButton.setBounds(buttonsArea.removeFromTop(selectorHeight));
+    tapsButton.setBounds(buttonsArea.removeFromBottom(selectorHeight));
+}
+
+void DelayModule::valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier& property)
+{
+    if (property == ParamIDs::delayMode)
+        updateModeControls();
+}
+
+void DelayModule::updateModeControls()
+{
+    const int mode = delayTree[ParamIDs::delayMode];
+    const bool isMultiTap = mode == ParameterHelper::multiTap;
+    
+    modeList.setSelectedId(mode + 1, juce::dontSendNotification);
+    
+    tapsButton.setEnabled(isMultiTap);
+    tapsButton.setAlpha(isMultiTap ? 1.0f : 0.4f);
+}
+
+void DelayModule::showTapEditor()
+{
+    auto tapEditor = std::make_unique<DelayTapEditor>(delayTree.getChildWithName(ParamIDs::delayTapTree));
+    
+    juce::CallOutBox::launchAsynchronously(std::move(tapEditor), tapsButton.getScreenBounds(), nullptr);
 }
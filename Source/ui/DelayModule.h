@@ -17,14 +17,18 @@
 #include "TextSlider.h"
 #include "DialKnob.h"
 #include "DelayFilter.h"
+#include "DelayTapEditor.h"
 #include "GUIHelper.h"
 #include "ComponentIDs.h"
 #include "EffectsSlot.h"
 #include "CrosshairDragger.h"
+#include "SvgCache.h"
+#include "lnfs/PresetPanelLNF.h"
 #include "../service/ParameterHelper.h"
 #include "../service/ParamIDs.h"
 
 class DelayModule  : public EffectsSlot
+                   , private juce::ValueTree::Listener
 {
 public:
     DelayModule(PluginProcessor& processor,
@@ -32,11 +36,18 @@ public:
                 juce::ValueTree delayTree,
                 juce::ValueTree lfoTree,
                 juce::ValueTree effectsOrderTree);
-
+    ~DelayModule() override;
+    
     void paint (juce::Graphics&) override;
     void resized() override;
 
 private:
+    void valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier& property) override;
+    
+    // the taps only play in multi-tap mode, so their editor can only be opened there
+    void updateModeControls();
+    void showTapEditor();
+    
     PluginProcessor& processor;
     juce::AudioProcessorValueTreeState& apvts;
     juce::ValueTree delayTree;
@@ -45,6 +56,8 @@ private:
     
     juce::Rectangle<int> mainArea;
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> header, timeIcon, syncIcon, unlinkedIcon, linkedIcon;
     
     CrosshairDragger crosshair;
@@ -76,5 +89,11 @@ private:
     
     TextSlider mixSlider;
     
+    juce::ComboBox modeList;
+    juce::TextButton compactStorageButton;
+    juce::TextButton tapsButton;
+    
+    PresetPanelLNF lnf;
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayModule)
 };
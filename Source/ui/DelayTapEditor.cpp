@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    DelayTapEditor.cpp
+    Created: 23 Oct 2026 9:12:44am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DelayTapEditor.h"
+
+DelayTapEditor::TapRow::TapRow(juce::ValueTree t_tree, int index)
+: tree(t_tree)
+, label({}, juce::String(index + 1))
+, enabledButton("On")
+, syncButton("Sync")
+, timeSwitcher(timeSlider, syncSlider, tree, ParamIDs::tapSync)
+{
+    enabledButton.getToggleStateValue().referTo(tree.getPropertyAsValue(ParamIDs::tapEnabled, nullptr));
+    syncButton.getToggleStateValue().referTo(tree.getPropertyAsValue(ParamIDs::tapSync, nullptr));
+    
+    // the delay line holds at most 3 seconds
+    timeSlider.setRange(0.01, 3.0, 0.001);
+    timeSlider.setSkewFactorFromMidPoint(0.5);
+    timeSlider.setTextValueSuffix(" s");
+    timeSlider.getValueObject().referTo(tree.getPropertyAsValue(ParamIDs::tapTime, nullptr));
+    
+    syncSlider.setRange(0.0, (double) ParameterHelper::syncOptions.size() - 1, 1.0);
+    syncSlider.textFromValueFunction = [] (double value)
+    {
+        return ParameterHelper::syncOptions[juce::roundToInt(value)] + "/16";
+    };
+    syncSlider.getValueObject().referTo(tree.getPropertyAsValue(ParamIDs::tapSyncIndex, nullptr));
+    
+    gainSlider.setRange(0.0, 1.0, 0.01);
+    gainSlider.getValueObject().referTo(tree.getPropertyAsValue(ParamIDs::tapGain, nullptr));
+    
+    panSlider.setRange(-1.0, 1.0, 0.01);
+    panSlider.getValueObject().referTo(tree.getPropertyAsValue(ParamIDs::tapPan, nullptr));
+    
+    for (auto* slider : { &timeSlider, &syncSlider, &gainSlider, &panSlider })
+        styleSlider(*slider);
+    
+    for (auto* button : { &enabledButton, &syncButton })
+    {
+        button->setColour(juce::ToggleButton::textColourId, MyColors::white);
+        button->setColour(juce::ToggleButton::tickColourId, MyColors::lightSecondary);
+        button->setColour(juce::ToggleButton::tickDisabledColourId, MyColors::mediumNeutral);
+    }
+    
+    label.setColour(juce::Label::textColourId, MyColors::lightNeutral);
+}
+
+DelayTapEditor::DelayTapEditor(juce::ValueTree tapTree)
+{
+    setOpaque(true);
+    
+    for (int i = 0; i < juce::jmin(tapTree.getNumChildren(), ParameterHelper::numDelayTaps); i++)
+    {
+        auto* row = rows.add(new TapRow(tapTree.getChild(i), i));
+        
+        addAndMakeVisible(row->label);
+        addAndMakeVisible(row->enabledButton);
+        addAndMakeVisible(row->syncButton);
+        addAndMakeVisible(row->timeSwitcher);
+        addAndMakeVisible(row->gainSlider);
+        addAndMakeVisible(row->panSlider);
+    }
+    
+    setSize(380, rowHeight * (rows.size() + 1));
+}
+
+void DelayTapEditor::styleSlider (juce::Slider& slider)
+{
+    slider.setSliderStyle(juce::Slider::LinearBar);
+    slider.setColour(juce::Slider::trackColourId, MyColors::mediumPrimary);
+    slider.setColour(juce::Slider::backgroundColourId, MyColors::background);
+    slider.setColour(juce::Slider::textBoxTextColourId, MyColors::white);
+    slider.setColour(juce::Slider::textBoxOutlineColourId, MyColors::mediumNeutral);
+    slider.setMouseCursor(juce::MouseCursor::LeftRightResizeCursor);
+}
+
+void DelayTapEditor::paint (juce::Graphics& g)
+{
+    g.fillAll(MyColors::background);
+    
+    g.setColour(MyColors::lightNeutral);
+    g.setFont(12.0f);
+    
+    auto header = getLocalBounds().removeFromTop(rowHeight).reduced(4, 0);
+    header.removeFromLeft(24 + 48 + 56);
+    g.drawText("Time", header.removeFromLeft(100), juce::Justification::centred);
+    g.drawText("Gain", header.removeFromLeft(70), juce::Justification::centred);
+    g.drawText("Pan", header, juce::Justification::centred);
+}
+
+void DelayTapEditor::resized()
+{
+    auto bounds = getLocalBounds().reduced(4, 0);
+    bounds.removeFromTop(rowHeight);
+    
+    for (auto* row : rows)
+    {
+        auto rowBounds = bounds.removeFromTop(rowHeight).reduced(0, 2);
+        
+        row->label.setBounds(rowBounds.removeFromLeft(24));
+        row->enabledButton.setBounds(rowBounds.removeFromLeft(48));
+        row->syncButton.setBounds(rowBounds.removeFromLeft(56));
+        row->timeSwitcher.setBounds(rowBounds.removeFromLeft(100).reduced(2, 0));
+        row->gainSlider.setBounds(rowBounds.removeFromLeft(70).reduced(2, 0));
+        row->panSlider.setBounds(rowBounds.reduced(2, 0));
+    }
+}
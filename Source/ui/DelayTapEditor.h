@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    DelayTapEditor.h
+    Created: 23 Oct 2026 9:12:44am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "GUIHelper.h"
+#include "ValueTreeComponents.h"
+#include "../service/ParameterHelper.h"
+#include "../service/ParamIDs.h"
+
+/*
+    The multi-tap delay's taps, one row each: on/off, sync, the time in
+    seconds or sixteenths, gain and pan. Every control refers straight to its
+    property in the tap tree, so preset loads show up without a listener.
+    Shown by the delay panel in a CallOutBox.
+*/
+class DelayTapEditor  : public juce::Component
+{
+public:
+    DelayTapEditor(juce::ValueTree tapTree);
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    static constexpr int rowHeight { 24 };
+
+private:
+    struct TapRow
+    {
+        TapRow(juce::ValueTree tapTree, int index);
+
+        juce::ValueTree tree;
+        juce::Label label;
+        juce::ToggleButton enabledButton, syncButton;
+        juce::Slider timeSlider, syncSlider, gainSlider, panSlider;
+        ComponentSwitcher<juce::Slider> timeSwitcher;
+    };
+
+    static void styleSlider (juce::Slider& slider);
+
+    juce::OwnedArray<TapRow> rows;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayTapEditor)
+};
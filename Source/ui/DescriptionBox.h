@@ -337,6 +337,21 @@ public:
             componentTitle.setText("Delay Filter Center", juce::dontSendNotification);
             descriptionText.setText("Drag to adjust the bandwidth of the delay unit's filter", juce::dontSendNotification);
         }
+        else if (compID == ComponentIDs::delayMode)
+        {
+            componentTitle.setText("Delay Mode", juce::dontSendNotification);
+            descriptionText.setText("Click to choose how the delay unit repeats: stereo keeps each side separate, ping-pong bounces the repeats between sides, and multi-tap plays up to eight taps off one line", juce::dontSendNotification);
+        }
+        else if (compID == ComponentIDs::delayCompactStorage)
+        {
+            componentTitle.setText("Delay 16-bit Storage", juce::dontSendNotification);
+            descriptionText.setText("Toggle to store the delay line at 16 bits, halving its memory at the cost of a little noise in the repeats", juce::dontSendNotification);
+        }
+        else if (compID == ComponentIDs::delayTaps)
+        {
+            componentTitle.setText("Delay Taps", juce::dontSendNotification);
+            descriptionText.setText("Click to edit the time, gain and pan of each tap. Only available in multi-tap mode", juce::dontSendNotification);
+        }
         else if (compID == ComponentIDs::reverbPad)
         {
             componentTitle.setText("Reverb XY Pad", juce::dontSendNotification);
@@ -362,6 +377,16 @@ public:
             componentTitle.setText("Reverb Dry/Wet", juce::dontSendNotification);
             descriptionText.setText("Drag to adjust the mix of the reverb unit, where 0% outputs no reverb signal and 100% outputs only reverb signal", juce::dontSendNotification);
         }
+        else if (compID == ComponentIDs::reverbEngine)
+        {
+            componentTitle.setText("Reverb Engine", juce::dontSendNotification);
+            descriptionText.setText("Click to choose how the reverb unit is made: Freeverb, a feedback delay network, or convolution with an impulse response. Convolution ignores size and damping", juce::dontSendNotification);
+        }
+        else if (compID == ComponentIDs::reverbImpulse)
+        {
+            componentTitle.setText("Reverb Impulse", juce::dontSendNotification);
+            descriptionText.setText("Click to load the impulse response file the convolution engine plays through, or to clear it", juce::dontSendNotification);
+        }
         else if (compID == ComponentIDs::filterVisualizer)
         {
             componentTitle.setText("Filter Visualizer", juce::dontSendNotification);
@@ -490,7 +515,12 @@ public:
         else if (compID == ComponentIDs::levelMeter)
         {
             componentTitle.setText("Level Meter", juce::dontSendNotification);
-            descriptionText.setText("The solid meters indicate the RMS levels of the output, while the thin lines indicate peak levels. The bottom value keeps track of the maximum output, and can be clicked to reset", juce::dontSendNotification);
+            descriptionText.setText("The solid meters indicate the RMS levels of the output, while the thin lines indicate peak levels. The bottom value keeps track of the maximum output, and can be clicked to reset. Click the meters to open the output analyzer", juce::dontSendNotification);
+        }
+        else if (compID == ComponentIDs::analyzerPanel)
+        {
+            componentTitle.setText("Output Analyzer", juce::dontSendNotification);
+            descriptionText.setText("The top view is an oscilloscope of the output, triggered on rising zero crossings. The bottom view is its spectrum, with the thin line holding recent peaks. Click to close", juce::dontSendNotification);
         }
         else
         {
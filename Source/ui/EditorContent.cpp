@@ -17,28 +17,28 @@ EditorContent::EditorContent(PluginProcessor& p, juce::UndoManager& um)
 , nonParamTree(p.getPluginNonParamTree())
 , lfoTree(nonParamTree.getChildWithName(ParamIDs::lfoTree))
 , effectsOrderTree(nonParamTree.getChildWithName(ParamIDs::effectsOrderTree))
-, logoGroup(juce::Drawable::createFromImageData(BinaryData::logo_group_svg, BinaryData::logo_group_svgSize))
-, timeIcon(juce::Drawable::createFromImageData(BinaryData::frequencyTime_svg, BinaryData::frequencyTime_svgSize))
-, syncIcon(juce::Drawable::createFromImageData(BinaryData::frequencySync_svg, BinaryData::frequencySync_svgSize))
-, unlinkedIcon(juce::Drawable::createFromImageData(BinaryData::unlinked_svg, BinaryData::unlinked_svgSize))
-, linkedIcon(juce::Drawable::createFromImageData(BinaryData::linked_svg, BinaryData::linked_svgSize))
-, oneshotIcon(juce::Drawable::createFromImageData(BinaryData::oneshot_svg, BinaryData::oneshot_svgSize))
-, loopIcon(juce::Drawable::createFromImageData(BinaryData::loop_svg, BinaryData::loop_svgSize))
-, offIcon(juce::Drawable::createFromImageData(BinaryData::cancel_svg, BinaryData::cancel_svgSize))
-, pianoIcon(juce::Drawable::createFromImageData(BinaryData::piano_svg, BinaryData::piano_svgSize))
-, oscillatorHeader(juce::Drawable::createFromImageData(BinaryData::oscillator_header_svg, BinaryData::oscillator_header_svgSize))
-, noiseHeader(juce::Drawable::createFromImageData(BinaryData::noise_header_svg, BinaryData::noise_header_svgSize))
-, lfoHeader(juce::Drawable::createFromImageData(BinaryData::lfo_header_svg, BinaryData::lfo_header_svgSize))
-, buttonHeader(juce::Drawable::createFromImageData(BinaryData::button_header_svg, BinaryData::button_header_svgSize))
-, meterHeader(juce::Drawable::createFromImageData(BinaryData::meter_header_svg, BinaryData::meter_header_svgSize))
-, bottomRightMarkings(juce::Drawable::createFromImageData(BinaryData::bottomright_markings_svg, BinaryData::bottomright_markings_svgSize))
+, logoGroup(svgCache->getDrawable(BinaryData::logo_group_svg, BinaryData::logo_group_svgSize))
+, timeIcon(svgCache->getDrawable(BinaryData::frequencyTime_svg, BinaryData::frequencyTime_svgSize))
+, syncIcon(svgCache->getDrawable(BinaryData::frequencySync_svg, BinaryData::frequencySync_svgSize))
+, unlinkedIcon(svgCache->getDrawable(BinaryData::unlinked_svg, BinaryData::unlinked_svgSize))
+, linkedIcon(svgCache->getDrawable(BinaryData::linked_svg, BinaryData::linked_svgSize))
+, oneshotIcon(svgCache->getDrawable(BinaryData::oneshot_svg, BinaryData::oneshot_svgSize))
+, loopIcon(svgCache->getDrawable(BinaryData::loop_svg, BinaryData::loop_svgSize))
+, offIcon(svgCache->getDrawable(BinaryData::cancel_svg, BinaryData::cancel_svgSize))
+, pianoIcon(svgCache->getDrawable(BinaryData::piano_svg, BinaryData::piano_svgSize))
+, oscillatorHeader(svgCache->getDrawable(BinaryData::oscillator_header_svg, BinaryData::oscillator_header_svgSize))
+, noiseHeader(svgCache->getDrawable(BinaryData::noise_header_svg, BinaryData::noise_header_svgSize))
+, lfoHeader(svgCache->getDrawable(BinaryData::lfo_header_svg, BinaryData::lfo_header_svgSize))
+, buttonHeader(svgCache->getDrawable(BinaryData::button_header_svg, BinaryData::button_header_svgSize))
+, meterHeader(svgCache->getDrawable(BinaryData::meter_header_svg, BinaryData::meter_header_svgSize))
+, bottomRightMarkings(svgCache->getDrawable(BinaryData::bottomright_markings_svg, BinaryData::bottomright_markings_svgSize))
 , presetPanel(p.getPresetManager())
 , oscSwitch      (nonParamTree.getChildWithName(ParamIDs::synthTree), ParamIDs::oscIO)
 , oscGainKnob    (*apvts.getParameter(ParamIDs::oscGain), "Gain", lfoTree.getChildWithName(ParamIDs::lfoOscGain), &um)
 , oscPanWheel(*apvts.getParameter(ParamIDs::oscPan), "Pan", lfoTree.getChildWithName(ParamIDs::lfoOscPan))
 , oscWavePicker(nonParamTree.getChildWithName(ParamIDs::synthTree), ParamIDs::oscWaveType)
-, oscAmpEnv(apvts.getParameter(ParamIDs::oscInitialAmp), apvts.getParameter(ParamIDs::oscAttackAmp), apvts.getParameter(ParamIDs::oscPeakAmp), apvts.getParameter(ParamIDs::oscDecayAmp), apvts.getParameter(ParamIDs::oscSustainAmp), apvts.getParameter(ParamIDs::oscReleaseAmp), nullptr, apvts.getParameter(ParamIDs::oscSlope1Amp), apvts.getParameter(ParamIDs::oscSlope2Amp), apvts.getParameter(ParamIDs::oscSlope3Amp), audioProcessor.oscAmpTables, &um)
-, oscPitchEnv(apvts.getParameter(ParamIDs::oscInitialPitch), apvts.getParameter(ParamIDs::oscAttackPitch), apvts.getParameter(ParamIDs::oscPeakPitch), apvts.getParameter(ParamIDs::oscDecayPitch), apvts.getParameter(ParamIDs::oscSustainPitch), apvts.getParameter(ParamIDs::oscReleasePitch), apvts.getParameter(ParamIDs::oscEndPitch), apvts.getParameter(ParamIDs::oscSlope1Pitch), apvts.getParameter(ParamIDs::oscSlope2Pitch), apvts.getParameter(ParamIDs::oscSlope3Pitch), audioProcessor.oscPitchTables, &um)
+, oscAmpEnv(apvts.getParameter(ParamIDs::oscInitialAmp), apvts.getParameter(ParamIDs::oscAttackAmp), apvts.getParameter(ParamIDs::oscPeakAmp), apvts.getParameter(ParamIDs::oscDecayAmp), apvts.getParameter(ParamIDs::oscSustainAmp), apvts.getParameter(ParamIDs::oscReleaseAmp), nullptr, apvts.getParameter(ParamIDs::oscSlope1Amp), apvts.getParameter(ParamIDs::oscSlope2Amp), apvts.getParameter(ParamIDs::oscSlope3Amp), audioProcessor.oscAmpTables, audioProcessor.envelopeTableVersion, &um)
+, oscPitchEnv(apvts.getParameter(ParamIDs::oscInitialPitch), apvts.getParameter(ParamIDs::oscAttackPitch), apvts.getParameter(ParamIDs::oscPeakPitch), apvts.getParameter(ParamIDs::oscDecayPitch), apvts.getParameter(ParamIDs::oscSustainPitch), apvts.getParameter(ParamIDs::oscReleasePitch), apvts.getParameter(ParamIDs::oscEndPitch), apvts.getParameter(ParamIDs::oscSlope1Pitch), apvts.getParameter(ParamIDs::oscSlope2Pitch), apvts.getParameter(ParamIDs::oscSlope3Pitch), audioProcessor.oscPitchTables, audioProcessor.envelopeTableVersion, &um)
 , oscOctaveSlider(*apvts.getParameter(ParamIDs::oscOctave), "Oct", TextSlider::displayHorizonal, lfoTree.getChildWithName(ParamIDs::lfoOscOctave))
 , oscSemitoneSlider(*apvts.getParameter(ParamIDs::oscSemitone), "Semi", TextSlider::displayHorizonal, lfoTree.getChildWithName(ParamIDs::lfoOscSemitone))
 , oscFineSlider(*apvts.getParameter(ParamIDs::oscFine), "Fine", TextSlider::displayHorizonal, lfoTree.getChildWithName(ParamIDs::lfoOscFine))
@@ -50,21 +50,22 @@ EditorContent::EditorContent(PluginProcessor& p, juce::UndoManager& um)
 , noisePanWheel(*apvts.getParameter(ParamIDs::noisePan), "Pan", lfoTree.getChildWithName(ParamIDs::lfoNoisePan))
 , noiseFilterPicker(nonParamTree.getChildWithName(ParamIDs::synthTree), *apvts.getParameter(ParamIDs::noiseQ))
 , filterQSlider(*apvts.getParameter(ParamIDs::noiseQ), "Q", TextSlider::displayHorizonal, lfoTree.getChildWithName(ParamIDs::lfoNoiseQ))
-, noiseAmpEnv(apvts.getParameter(ParamIDs::noiseInitialAmp), apvts.getParameter(ParamIDs::noiseAttackAmp), apvts.getParameter(ParamIDs::noisePeakAmp), apvts.getParameter(ParamIDs::noiseDecayAmp), apvts.getParameter(ParamIDs::noiseSustainAmp), apvts.getParameter(ParamIDs::noiseReleaseAmp), nullptr, apvts.getParameter(ParamIDs::noiseSlope1Amp), apvts.getParameter(ParamIDs::noiseSlope2Amp), apvts.getParameter(ParamIDs::noiseSlope3Amp), audioProcessor.noiseAmpTables, &um)
-, noiseFilterEnv(apvts.getParameter(ParamIDs::noiseInitialCutoff), apvts.getParameter(ParamIDs::noiseAttackCutoff), apvts.getParameter(ParamIDs::noisePeakCutoff), apvts.getParameter(ParamIDs::noiseDecayCutoff), apvts.getParameter(ParamIDs::noiseSustainCutoff), apvts.getParameter(ParamIDs::noiseReleaseCutoff), apvts.getParameter(ParamIDs::noiseEndCutoff), apvts.getParameter(ParamIDs::noiseSlope1Cutoff), apvts.getParameter(ParamIDs::noiseSlope2Cutoff), apvts.getParameter(ParamIDs::noiseSlope3Cutoff), audioProcessor.noiseFilterTables, &um)
+, noiseAmpEnv(apvts.getParameter(ParamIDs::noiseInitialAmp), apvts.getParameter(ParamIDs::noiseAttackAmp), apvts.getParameter(ParamIDs::noisePeakAmp), apvts.getParameter(ParamIDs::noiseDecayAmp), apvts.getParameter(ParamIDs::noiseSustainAmp), apvts.getParameter(ParamIDs::noiseReleaseAmp), nullptr, apvts.getParameter(ParamIDs::noiseSlope1Amp), apvts.getParameter(ParamIDs::noiseSlope2Amp), apvts.getParameter(ParamIDs::noiseSlope3Amp), audioProcessor.noiseAmpTables, audioProcessor.envelopeTableVersion, &um)
+, noiseFilterEnv(apvts.getParameter(ParamIDs::noiseInitialCutoff), apvts.getParameter(ParamIDs::noiseAttackCutoff), apvts.getParameter(ParamIDs::noisePeakCutoff), apvts.getParameter(ParamIDs::noiseDecayCutoff), apvts.getParameter(ParamIDs::noiseSustainCutoff), apvts.getParameter(ParamIDs::noiseReleaseCutoff), apvts.getParameter(ParamIDs::noiseEndCutoff), apvts.getParameter(ParamIDs::noiseSlope1Cutoff), apvts.getParameter(ParamIDs::noiseSlope2Cutoff), apvts.getParameter(ParamIDs::noiseSlope3Cutoff), audioProcessor.noiseFilterTables, audioProcessor.envelopeTableVersion, &um)
 , noiseCoarseSlider(*apvts.getParameter(ParamIDs::noiseFilterCoarse), "Crs", TextSlider::displayHorizonal, lfoTree.getChildWithName(ParamIDs::lfoNoiseCoarse))
 , noiseAmpEnvToggler(nonParamTree.getChildWithName(ParamIDs::synthTree), ParamIDs::noiseAmpEnvMode, oneshotIcon, loopIcon)
 , filterEnvToggler(nonParamTree.getChildWithName(ParamIDs::synthTree), ParamIDs::filterEnvMode, oneshotIcon, loopIcon, offIcon)
 , filterKeyFollowButton(nonParamTree.getChildWithName(ParamIDs::synthTree), ParamIDs::filterKeyFollowIO, pianoIcon, pianoIcon, ValueTreeToolButton::showBackgroundToggled)
 , delayModule(audioProcessor, apvts, nonParamTree.getChildWithName(ParamIDs::delayTree), lfoTree, effectsOrderTree)
-, reverbModule(audioProcessor, apvts, lfoTree, effectsOrderTree)
+, reverbModule(audioProcessor, apvts, nonParamTree.getChildWithName(ParamIDs::reverbTree), lfoTree, effectsOrderTree)
 , filterModule(audioProcessor, apvts, nonParamTree.getChildWithName(ParamIDs::filterTree), lfoTree, effectsOrderTree)
 , waveshaperModule(audioProcessor, apvts, nonParamTree.getChildWithName(ParamIDs::waveshaperNodeTree), nonParamTree.getChildWithName(ParamIDs::waveshaperToolTree), lfoTree, effectsOrderTree)
 , lfo1Module(lfoTree.getChildWithName(ParamIDs::lfo1), *apvts.getParameter(ParamIDs::lfo1FrequencyTime), *apvts.getParameter(ParamIDs::lfo1FrequencySync), *apvts.getParameter(ParamIDs::lfo1Range), audioProcessor.getLFOVisualizer(0))
 , lfo2Module(lfoTree.getChildWithName(ParamIDs::lfo2), *apvts.getParameter(ParamIDs::lfo2FrequencyTime), *apvts.getParameter(ParamIDs::lfo2FrequencySync), *apvts.getParameter(ParamIDs::lfo2Range), audioProcessor.getLFOVisualizer(1))
-, bigRedButton(*apvts.getParameter(ParamIDs::midiNote), audioProcessor.midiFifo)
+, bigRedButton(*apvts.getParameter(ParamIDs::midiNote), audioProcessor.noteEvents)
 , midiNoteSlider(*apvts.getParameter(ParamIDs::midiNote), "Note")
 , levelMeters(audioProcessor)
+, analyzerPanel(audioProcessor.getScopeAnalyzer())
 , volumeLever(*apvts.getParameter(ParamIDs::masterGain), "Master Gain", lfoTree.getChildWithName(ParamIDs::lfoMasterGain))
 {
     addAndMakeVisible(presetPanel);
@@ -99,6 +100,9 @@ EditorContent::EditorContent(PluginProcessor& p, juce::UndoManager& um)
     addAndMakeVisible(waveshaperModule);
     addAndMakeVisible(filterModule);
     
+    // opens over the effects
+    addChildComponent(analyzerPanel);
+    
     addAndMakeVisible(lfo1Module);
     addAndMakeVisible(lfo2Module);
     
@@ -137,6 +141,9 @@ EditorContent::EditorContent(PluginProcessor& p, juce::UndoManager& um)
     midiNoteSlider.setComponentID(ComponentIDs::midiNote);
     volumeLever.setComponentID(ComponentIDs::masterGain);
     levelMeters.setComponentID(ComponentIDs::levelMeter);
+    analyzerPanel.setComponentID(ComponentIDs::analyzerPanel);
+    
+    levelMeters.onMetersClicked = [this] { analyzerPanel.setVisible(! analyzerPanel.isVisible()); };
     
     for (auto& child: getChildren())
         child->addMouseListener(&descriptionBox, true);
@@ -267,6 +274,7 @@ void EditorContent::resized()
     
     effectsBounds = totalArea.removeFromLeft((effectWidth + additionalHeaderWidth) * 2);
     setEffectsBounds();
+    analyzerPanel.setBounds(effectsBounds);
     
     static const int utilitiesWidth = 300;
     juce::Rectangle<int> utilitiesArea = totalArea.removeFromLeft(utilitiesWidth);
@@ -29,7 +29,9 @@
 #include "ReverbModule.h"
 #include "WaveshaperModule.h"
 #include "LevelMeter.h"
+#include "AnalyzerPanel.h"
 #include "ControlLever.h"
+#include "SvgCache.h"
 #include "lnfs/EditorLnf.h"
 
 class EditorContent  : public juce::Component
@@ -53,6 +55,8 @@ private:
     juce::ValueTree lfoTree;
     juce::ValueTree effectsOrderTree;
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     juce::Rectangle<int> logoArea;
     std::unique_ptr<juce::Drawable> logoGroup, timeIcon, syncIcon, unlinkedIcon, linkedIcon, oneshotIcon, loopIcon, offIcon, pianoIcon;
     std::unique_ptr<juce::Drawable> oscillatorHeader, noiseHeader, lfoHeader, buttonHeader, meterHeader, bottomRightMarkings;
@@ -113,6 +117,7 @@ private:
     TextSlider midiNoteSlider;
     
     MeterPair levelMeters;
+    AnalyzerPanel analyzerPanel;
     ControlLever volumeLever;
     
     DescriptionBox descriptionBox;
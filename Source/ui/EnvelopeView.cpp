@@ -20,7 +20,8 @@ EnvelopeGraph::EnvelopeGraph(juce::RangedAudioParameter* param1Y,
                              juce::RangedAudioParameter* param3Y,
                              juce::RangedAudioParameter* param4X,
                              juce::RangedAudioParameter* param4Y,
-                             juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& tables,
+                             juce::OwnedArray<SwappableTable>& tables,
+                             const std::atomic<uint32_t>& t_tableVersion,
                              juce::UndoManager* um)
 : audioParam1Y(param1Y)
 , audioParam2X(param2X)
@@ -37,6 +38,7 @@ EnvelopeGraph::EnvelopeGraph(juce::RangedAudioParameter* param1Y,
 , paramAttachment4X(*param4X, [&] (float val) {update4X(val);}, um)
 , paramAttachment4Y(audioParam4Y ? std::unique_ptr<juce::ParameterAttachment> (new juce::ParameterAttachment(*audioParam4Y, [&] (float val) {update4Y(val);} , um)) : nullptr)
 , envTables(tables)
+, tableVersion(t_tableVersion)
 {
     for (int i = 0; i < 4; i++)
         points.emplace_back(0.0f, 0.0f);
@@ -53,79 +55,114 @@ EnvelopeGraph::EnvelopeGraph(juce::RangedAudioParameter* param1Y,
 
 void EnvelopeGraph::paint(juce::Graphics & g)
 {
-    juce::Path envGraph;
-    envGraph.startNewSubPath(mainArea.getX(), mainArea.getBottom() - points[0].y * mainArea.getHeight());
+    const uint32_t currentTableVersion = tableVersion.load();
+    
+    // hover and focus repaints land here too, and only need the stroke
+    if (! hasPath || pathGeometryVersion != geometryVersion || pathTableVersion != currentTableVersion)
+    {
+        rebuildEnvelopePath();
+        pathGeometryVersion = geometryVersion;
+        pathTableVersion = currentTableVersion;
+        hasPath = true;
+    }
+    
+    g.setColour(MyColors::white);
+    g.strokePath(envelopePath, juce::PathStrokeType(MyWidths::standardWidth, juce::PathStrokeType::curved));
+}
+
+void EnvelopeGraph::rebuildEnvelopePath()
+{
+    envelopePath.clear();
+    envelopePath.startNewSubPath(mainArea.getX(), mainArea.getBottom() - points[0].y * mainArea.getHeight());
+    
+    float totalXNorm = 0;
     
     for (int i = 0; i < points.size() - 1; i++)
     {
-        float totalXNorm = 0;
-        for (int j = 1; j <= i; j++)
-            totalXNorm += points[j].x;
+        if (i > 0)
+            totalXNorm += points[i].x;
 
         const float startX = mainArea.getX() + totalXNorm * timeParameterWidth;
         const float startY = mainArea.getBottom() - points[i].y * mainArea.getHeight();
         float x = startX;
         const float deltaX = points[i + 1].x * timeParameterWidth / resolution;
         
+        // one table for the whole segment, even if the rebuilder swaps in a new one halfway along
+        const SwappableTable::ScopedRead table (*envTables[i]);
+        
         for (int k = 0; k < resolution; k++)
         {
-            const float tableVal = envTables[i]->processSample(static_cast<float>(k) / resolution);
+            const float tableVal = table->processSample(static_cast<float>(k) / resolution);
             const float y = startY - mainArea.getHeight() * (tableVal * (points[i + 1].y - points[i].y));
-            envGraph.lineTo(x, y);
+            envelopePath.lineTo(x, y);
             x += deltaX;
         }
     }
-    
-    g.setColour(MyColors::white);
-    g.strokePath(envGraph, juce::PathStrokeType(MyWidths::standardWidth, juce::PathStrokeType::curved));
 }
 
 void EnvelopeGraph::resized()
 {
     mainArea = getLocalBounds();
     timeParameterWidth = mainArea.getWidth() * 0.3f;
+    geometryVersion++;
+}
+
+void EnvelopeGraph::parentHierarchyChanged()
+{
+    frameAttachment.update();
+}
+
+juce::Rectangle<int> EnvelopeGraph::advanceFrame()
+{
+    return tableVersion.load() != pathTableVersion ? getLocalBounds() : juce::Rectangle<int>();
+}
+
+void EnvelopeGraph::geometryChanged()
+{
+    geometryVersion++;
+    repaint();
 }
 
 void EnvelopeGraph::update1Y(float newVal)
 {
     points[0].y = audioParam1Y->convertTo0to1(newVal);
-    repaint();
+    geometryChanged();
 }
 
 void EnvelopeGraph::update2X(float newVal)
 {
     points[1].x = audioParam2X->convertTo0to1(newVal);
-    repaint();
+    geometryChanged();
 }
 
 void EnvelopeGraph::update2Y(float newVal)
 {
     points[1].y = audioParam2Y->convertTo0to1(newVal);
-    repaint();
+    geometryChanged();
 }
 
 void EnvelopeGraph::update3X(float newVal)
 {
     points[2].x = audioParam3X->convertTo0to1(newVal);
-    repaint();
+    geometryChanged();
 }
 
 void EnvelopeGraph::update3Y(float newVal)
 {
     points[2].y = audioParam3Y->convertTo0to1(newVal);
-    repaint();
+    geometryChanged();
 }
 
 void EnvelopeGraph::update4X(float newVal)
 {
     points[3].x = audioParam4X->convertTo0to1(newVal);
-    repaint();
+    geometryChanged();
 }
 
 void EnvelopeGraph::update4Y(float newVal)
 {
     points[3].y = audioParam4Y->convertTo0to1(newVal);
-    repaint();
+    geometryChanged();
 }
 
 /* ----- ENVELOPE CONTROLS ----- */
@@ -526,9 +563,10 @@ EnvelopeView::EnvelopeView(juce::RangedAudioParameter* param1Y,
                            juce::RangedAudioParameter* paramSlope1,
                            juce::RangedAudioParameter* paramSlope2,
                            juce::RangedAudioParameter* paramSlope3,
-                           juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& tables,
+                           juce::OwnedArray<SwappableTable>& tables,
+                           const std::atomic<uint32_t>& tableVersion,
                            juce::UndoManager* um)
-: envelopeGraph(param1Y, param2X, param2Y, param3X, param3Y, param4X, param4Y, tables, um)
+: envelopeGraph(param1Y, param2X, param2Y, param3X, param3Y, param4X, param4Y, tables, tableVersion, um)
 , envelopeControls(param1Y, param2X, param2Y, param3X, param3Y, param4X, param4Y, paramSlope1, paramSlope2, paramSlope3, um)
 , attackSlider(*param2X, "Attack")
 , decaySlider(*param3X, "Decay")
@@ -605,39 +643,43 @@ void EnvelopeView::mouseExit (const juce::MouseEvent& event)
 
 void EnvelopeView::paint(juce::Graphics & g)
 {
-    g.fillAll(MyColors::background);
-    
-    g.setColour(MyColors::viewBackground);
-    g.fillRect(viewBounds);
-    
-    juce::Path gridLines;
-    
-    for (int i = 0; i < numXGridLines; i++)
+    // everything here is static; the graph and controls on top repaint it with every drag
+    backgroundLayer.draw(g, getLocalBounds(), [this] (juce::Graphics& g)
     {
-        const float x = mainArea.getX() + (static_cast<float>(i) / (numXGridLines - 1)) * mainArea.getWidth();
+        g.fillAll(MyColors::background);
         
-        gridLines.startNewSubPath(x, mainArea.getY());
-        gridLines.lineTo         (x, mainArea.getBottom());
-    }
-    
-    for (int i = 0; i < numYGridLines; i++)
-    {
-        const float y = mainArea.getY() + (static_cast<float>(i) / (numYGridLines - 1)) * mainArea.getHeight();
+        g.setColour(MyColors::viewBackground);
+        g.fillRect(viewBounds);
         
-        gridLines.startNewSubPath(mainArea.getX(), y);
-        gridLines.lineTo         (mainArea.getRight(), y);
-    }
-    
-    g.setColour(MyColors::darkPrimary);
-    g.strokePath(gridLines, juce::PathStrokeType(MyWidths::standardWidth));
-    
-    GUIHelper::drawRectangleWithThickness(g, viewBounds.toFloat(), MyWidths::thinWidth);
-    
-    if (! endSlider)
-    {
-        g.setColour(MyColors::darkNeutral);
-        GUIHelper::paintXBox(g, endSliderArea);
-    }
+        juce::Path gridLines;
+        
+        for (int i = 0; i < numXGridLines; i++)
+        {
+            const float x = mainArea.getX() + (static_cast<float>(i) / (numXGridLines - 1)) * mainArea.getWidth();
+            
+            gridLines.startNewSubPath(x, mainArea.getY());
+            gridLines.lineTo         (x, mainArea.getBottom());
+        }
+        
+        for (int i = 0; i < numYGridLines; i++)
+        {
+            const float y = mainArea.getY() + (static_cast<float>(i) / (numYGridLines - 1)) * mainArea.getHeight();
+            
+            gridLines.startNewSubPath(mainArea.getX(), y);
+            gridLines.lineTo         (mainArea.getRight(), y);
+        }
+        
+        g.setColour(MyColors::darkPrimary);
+        g.strokePath(gridLines, juce::PathStrokeType(MyWidths::standardWidth));
+        
+        GUIHelper::drawRectangleWithThickness(g, viewBounds.toFloat(), MyWidths::thinWidth);
+        
+        if (! endSlider)
+        {
+            g.setColour(MyColors::darkNeutral);
+            GUIHelper::paintXBox(g, endSliderArea);
+        }
+    });
 }
 
 void EnvelopeView::resized()
@@ -16,12 +16,15 @@
 #include "EnvelopeNode.h"
 #include "TextSlider.h"
 #include "ValueTreeComponents.h"
+#include "CachedLayer.h"
+#include "FrameScheduler.h"
 #include "lnfs/EditorLnf.h"
 #include "../dsp/MyADSR.h"
 
 /* ----- ENVELOPE GRAPH ----- */
 
 class EnvelopeGraph : public juce::Component
+                    , private FrameScheduler::Client
 {
 public:
     EnvelopeGraph(juce::RangedAudioParameter* param1Y,
@@ -31,13 +34,20 @@ public:
                   juce::RangedAudioParameter* param3Y,
                   juce::RangedAudioParameter* param4X,
                   juce::RangedAudioParameter* param4Y,
-                  juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& tables,
+                  juce::OwnedArray<SwappableTable>& tables,
+                  const std::atomic<uint32_t>& tableVersion,
                   juce::UndoManager* um = nullptr);
     
     void paint (juce::Graphics&) override;
     void resized() override;
+    void parentHierarchyChanged() override;
     
 private:
+    juce::Rectangle<int> advanceFrame() override;
+    
+    void geometryChanged();
+    void rebuildEnvelopePath();
+    
     void update1Y(float newVal);
     void update2X(float newVal);
     void update2Y(float newVal);
@@ -62,7 +72,8 @@ private:
     juce::ParameterAttachment paramAttachment4X;
     std::unique_ptr<juce::ParameterAttachment> paramAttachment4Y;
     
-    juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& envTables;
+    juce::OwnedArray<SwappableTable>& envTables;
+    const std::atomic<uint32_t>& tableVersion;
     
     juce::Rectangle<int> mainArea;
     float timeParameterWidth;
@@ -70,6 +81,16 @@ private:
     
     std::vector<juce::Point<float>> points;
     
+    // the path is only rebuilt when the points, size or slope tables have moved on since it was built
+    juce::Path envelopePath;
+    uint32_t geometryVersion { 0 }, pathGeometryVersion { 0 };
+    uint32_t pathTableVersion { 0 };
+    bool hasPath { false };
+    
+    // slope tables are rebuilt off the message thread, so the graph polls for them landing
+    const int refreshRate { 60 };
+    FrameScheduler::Attachment frameAttachment { *this, *this, refreshRate };
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EnvelopeGraph);
 };
 
@@ -173,7 +194,8 @@ public:
                  juce::RangedAudioParameter* paramSlope1,
                  juce::RangedAudioParameter* paramSlope2,
                  juce::RangedAudioParameter* paramSlope3,
-                 juce::OwnedArray<juce::dsp::LookupTableTransform<float>>& tables,
+                 juce::OwnedArray<SwappableTable>& tables,
+                 const std::atomic<uint32_t>& tableVersion,
                  juce::UndoManager* um = nullptr);
     ~EnvelopeView() override;
     
@@ -198,6 +220,7 @@ private:
     std::unique_ptr<TextSlider> endSlider;
     
     juce::Rectangle<int> viewBounds, mainArea, emptySliderArea, endSliderArea;
+    CachedLayer backgroundLayer;
     
     const int numXGridLines { 11 };
     const int numYGridLines { 5 };
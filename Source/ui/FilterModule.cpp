@@ -32,6 +32,8 @@ FilterVisualizer::FilterVisualizer(PluginProcessor& p, juce::AudioProcessorValue
     
     highFilterType = filterTree.getProperty(ParamIDs::filterHighpassMode);
     lowFilterType = filterTree.getProperty(ParamIDs::filterLowpassMode);
+    highFilterSlope = juce::jlimit(0, DSPHelper::maxFilterStages - 1, (int) filterTree.getProperty(ParamIDs::filterHighpassSlope));
+    lowFilterSlope = juce::jlimit(0, DSPHelper::maxFilterStages - 1, (int) filterTree.getProperty(ParamIDs::filterLowpassSlope));
     
     nodes.add(new FilterNode(highpassCutoffParam,
                              highpassQParam,
@@ -46,7 +48,7 @@ FilterVisualizer::FilterVisualizer(PluginProcessor& p, juce::AudioProcessorValue
                              lowpassQAttachment,
                              lowpassGainAttachment));
     
-    magnitudes.resize(1);
+    response.onResponseReady = [this] (const std::vector<float>& decibels) { setResponseCurvePath(decibels); };
     
     ParameterHelper::castParameter (apvts, ParamIDs::filterLowpassCutoff, lowpassCutoff);
     ParameterHelper::castParameter (apvts, ParamIDs::filterLowpassQ, lowpassQ);
@@ -134,31 +136,34 @@ void FilterVisualizer::paint(juce::Graphics& g)
 {
     /* ----- DRAW BACKGROUND GRID ----- */
     
-    g.setColour(MyColors::viewBackground);
-    g.fillRect(mainArea);
-    
-    g.setColour(MyColors::darkPrimary);
-    
-    for (int& freq: frequencies)
-    {
-        const float normX = juce::mapFromLog10(static_cast<float>(freq),
-                                               DSPHelper::minimumFrequency,
-                                               DSPHelper::maximumFrequency);
-        g.drawLine(normX * mainArea.getWidth() + mainArea.getX(),
-                   mainArea.getY(),
-                   normX * mainArea.getWidth() + mainArea.getX(),
-                   mainArea.getBottom(),
-                   MyWidths::thinWidth);
-    }
-    
-    for (int i = 1; i < 8; i++)
+    gridLayer.draw(g, mainArea, [this] (juce::Graphics& g)
     {
-        g.drawLine(mainArea.getX(),
-                   mainArea.getY() + static_cast<float>(i) / 8 * mainArea.getHeight(),
-                   mainArea.getRight(),
-                   mainArea.getY() + static_cast<float>(i) / 8 * mainArea.getHeight(),
-                   MyWidths::thinWidth);
-    }
+        g.setColour(MyColors::viewBackground);
+        g.fillRect(mainArea);
+        
+        g.setColour(MyColors::darkPrimary);
+        
+        for (int& freq: frequencies)
+        {
+            const float normX = juce::mapFromLog10(static_cast<float>(freq),
+                                                   DSPHelper::minimumFrequency,
+                                                   DSPHelper::maximumFrequency);
+            g.drawLine(normX * mainArea.getWidth() + mainArea.getX(),
+                       mainArea.getY(),
+                       normX * mainArea.getWidth() + mainArea.getX(),
+                       mainArea.getBottom(),
+                       MyWidths::thinWidth);
+        }
+        
+        for (int i = 1; i < 8; i++)
+        {
+            g.drawLine(mainArea.getX(),
+                       mainArea.getY() + static_cast<float>(i) / 8 * mainArea.getHeight(),
+                       mainArea.getRight(),
+                       mainArea.getY() + static_cast<float>(i) / 8 * mainArea.getHeight(),
+                       MyWidths::thinWidth);
+        }
+    });
     
     /* ----- DRAW RESPONSE CURVE ----- */
     
@@ -198,7 +203,6 @@ void FilterVisualizer::resized()
     for (auto* node: nodes)
         node->viewArea = mainArea;
     
-    magnitudes.resize(mainArea.getWidth());
     updateResponseCurve();
 }
 
@@ -224,47 +228,67 @@ void FilterVisualizer::updateFilter()
     using CoeffArray = juce::dsp::IIR::ArrayCoefficients<float>;
     
     const double sampleRate = processor.getSampleRate();
+    const int lowStages = lowFilterSlope + 1, highStages = highFilterSlope + 1;
+    
+    // same stage layout as FilterProcessor::applyControls
+    for (int stage = 0; stage < lowStages; stage++)
+    {
+        const float q = DSPHelper::getCascadeStageQ(stage, lowStages, lowpassQ->get());
+        
+        if (lowFilterType == ParameterHelper::pass)
+           lowpassCoeffs[stage] = CoeffArray::makeLowPass(sampleRate,
+                                                          DSPHelper::mapNormalizedToFrequency(lowpassCutoff->get()),
+                                                          q);
+        else if (lowFilterType == ParameterHelper::shelf)
+            lowpassCoeffs[stage] = CoeffArray::makeHighShelf(sampleRate,
+                                                             DSPHelper::mapNormalizedToFrequency(lowpassCutoff->get()),
+                                                             q,
+                                                             juce::Decibels::decibelsToGain(lowpassGain->get() / lowStages));
+    }
     
-    if (lowFilterType == ParameterHelper::pass)
-       lowpassCoeffs = CoeffArray::makeLowPass(sampleRate,
-                                               DSPHelper::mapNormalizedToFrequency(lowpassCutoff->get()),
-                                               lowpassQ->get());
-    else if (lowFilterType == ParameterHelper::shelf)
-        lowpassCoeffs = CoeffArray::makeHighShelf(sampleRate,
-                                                  DSPHelper::mapNormalizedToFrequency(lowpassCutoff->get()),
-                                                  lowpassQ->get(),
-                                                  juce::Decibels::decibelsToGain(lowpassGain->get()));
-    
-    if (highFilterType == ParameterHelper::pass)
-        highpassCoeffs = CoeffArray::makeHighPass(sampleRate,
-                                                  DSPHelper::mapNormalizedToFrequency(highpassCutoff->get()),
-                                                  highpassQ->get());
-    else if (highFilterType == ParameterHelper::shelf)
-        highpassCoeffs = CoeffArray::makeLowShelf(sampleRate,
-                                                  DSPHelper::mapNormalizedToFrequency(highpassCutoff->get()),
-                                                  highpassQ->get(),
-                                                  juce::Decibels::decibelsToGain(highpassGain->get()));
+    for (int stage = 0; stage < highStages; stage++)
+    {
+        const float q = DSPHelper::getCascadeStageQ(stage, highStages, highpassQ->get());
+        
+        if (highFilterType == ParameterHelper::pass)
+            highpassCoeffs[stage] = CoeffArray::makeHighPass(sampleRate,
+                                                             DSPHelper::mapNormalizedToFrequency(highpassCutoff->get()),
+                                                             q);
+        else if (highFilterType == ParameterHelper::shelf)
+            highpassCoeffs[stage] = CoeffArray::makeLowShelf(sampleRate,
+                                                             DSPHelper::mapNormalizedToFrequency(highpassCutoff->get()),
+                                                             q,
+                                                             juce::Decibels::decibelsToGain(highpassGain->get() / highStages));
+    }
 }
 
 void FilterVisualizer::updateResponseCurve()
 {
-    const int numFrequencies = mainArea.getWidth();
+    std::vector<ResponseCurve::Stage> stages;
     
-    for (int i = 0; i < numFrequencies; i++)
-    {
-        double mag = 1.0;
-        double freq = DSPHelper::mapNormalizedToFrequency((float) i / numFrequencies);
-        
-        if (lowFilterType < 2)
-            mag *= lowpassCoeffs.getMagnitudeForFrequency(freq, processor.getSampleRate());
-        if (highFilterType < 2)
-            mag *= highpassCoeffs.getMagnitudeForFrequency(freq, processor.getSampleRate());
-        
-        magnitudes[i] = juce::Decibels::gainToDecibels(mag);
-    }
+    if (lowFilterType < 2)
+        for (int stage = 0; stage <= lowFilterSlope; stage++)
+            stages.push_back(ResponseCurve::makeStage(lowpassCoeffs[stage]));
+    if (highFilterType < 2)
+        for (int stage = 0; stage <= highFilterSlope; stage++)
+            stages.push_back(ResponseCurve::makeStage(highpassCoeffs[stage]));
+    
+    // the curve follows once the response is in; the nodes can move straight away
+    response.request(std::move(stages), mainArea.getWidth(), processor.getSampleRate());
     
+    updateNodes();
+}
+
+void FilterVisualizer::setResponseCurvePath (const std::vector<float>& decibels)
+{
     responseCurve.clear();
     
+    if (decibels.empty())
+    {
+        repaint();
+        return;
+    }
+    
     const double outputMin = mainArea.getBottom();
     const double outputMax = mainArea.getY();
     auto map = [outputMin, outputMax](double input)
@@ -278,14 +302,14 @@ void FilterVisualizer::updateResponseCurve()
                           outputMax);
     };
     
-    responseCurve.startNewSubPath(mainArea.getX(), map(magnitudes.front()));
+    responseCurve.startNewSubPath(mainArea.getX(), map(decibels.front()));
     
-    for(int i = 1; i < magnitudes.size(); i++)
+    for(int i = 1; i < decibels.size(); i++)
     {
-        responseCurve.lineTo(mainArea.getX() + i, map(magnitudes[i]));
+        responseCurve.lineTo(mainArea.getX() + i, map(decibels[i]));
     }
     
-    updateNodes();
+    repaint();
 }
 
 void FilterVisualizer::updateNodes()
@@ -308,6 +332,10 @@ void FilterVisualizer::valueTreePropertyChanged(juce::ValueTree& treeWhoseProper
         lowFilterType = filterTree[property];
         nodes[1]->mode = lowFilterType;
     }
+    else if (property == ParamIDs::filterHighpassSlope)
+        highFilterSlope = juce::jlimit(0, DSPHelper::maxFilterStages - 1, (int) filterTree[property]);
+    else if (property == ParamIDs::filterLowpassSlope)
+        lowFilterSlope = juce::jlimit(0, DSPHelper::maxFilterStages - 1, (int) filterTree[property]);
     
     updateFilter();
     updateResponseCurve();
@@ -360,12 +388,12 @@ FilterModule::FilterModule(PluginProcessor& p, juce::AudioProcessorValueTreeStat
 : EffectsSlot(ParamIDs::filterNode, effectsOrderTree)
 , apvts(t_apvts)
 , filterTree(t_filterTree)
-, header(juce::Drawable::createFromImageData(BinaryData::filter_header_svg, BinaryData::filter_header_svgSize))
-, lowpassIcon(juce::Drawable::createFromImageData(BinaryData::lowpass_svg, BinaryData::lowpass_svgSize))
-, highpassIcon(juce::Drawable::createFromImageData(BinaryData::highpass_svg, BinaryData::highpass_svgSize))
-, lowshelfIcon(juce::Drawable::createFromImageData(BinaryData::lowshelf_svg, BinaryData::lowshelf_svgSize))
-, highshelfIcon(juce::Drawable::createFromImageData(BinaryData::highshelf_svg, BinaryData::highshelf_svgSize))
-, offIcon(juce::Drawable::createFromImageData(BinaryData::cancel_svg, BinaryData::cancel_svgSize))
+, header(svgCache->getDrawable(BinaryData::filter_header_svg, BinaryData::filter_header_svgSize))
+, lowpassIcon(svgCache->getDrawable(BinaryData::lowpass_svg, BinaryData::lowpass_svgSize))
+, highpassIcon(svgCache->getDrawable(BinaryData::highpass_svg, BinaryData::highpass_svgSize))
+, lowshelfIcon(svgCache->getDrawable(BinaryData::lowshelf_svg, BinaryData::lowshelf_svgSize))
+, highshelfIcon(svgCache->getDrawable(BinaryData::highshelf_svg, BinaryData::highshelf_svgSize))
+, offIcon(svgCache->getDrawable(BinaryData::cancel_svg, BinaryData::cancel_svgSize))
 , crosshair(ParamIDs::filterNode.toString())
 , visualizer(p, apvts, filterTree)
 , highpassCutoffSlider(*apvts.getParameter(ParamIDs::filterHighpassCutoff), "Cutoff", 0, lfoTree.getChildWithName(ParamIDs::lfoFilterHighpassCutoff))
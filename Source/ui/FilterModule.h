@@ -17,7 +17,10 @@
 #include "GUIHelper.h"
 #include "EffectsSlot.h"
 #include "CrosshairDragger.h"
+#include "CachedLayer.h"
+#include "ResponseCurve.h"
 #include "ComponentIDs.h"
+#include "SvgCache.h"
 #include "../dsp/DSPHelper.h"
 #include "../service/ParamIDs.h"
 #include "../service/ParameterHelper.h"
@@ -125,6 +128,8 @@ private:
     void lowQChanged (float newVal);
     void lowGainChanged (float newVal);
     
+    void setResponseCurvePath (const std::vector<float>& decibels);
+    
     PluginProcessor& processor;
     juce::AudioProcessorValueTreeState& apvts;
     juce::ValueTree filterTree;
@@ -144,18 +149,20 @@ private:
     juce::AudioParameterFloat* highpassQ { nullptr };
     juce::AudioParameterFloat* highpassGain { nullptr };
     
-    juce::dsp::IIR::Coefficients<float> highpassCoeffs, lowpassCoeffs;
-    std::vector<double> magnitudes;
+    std::array<juce::dsp::IIR::Coefficients<float>, DSPHelper::maxFilterStages> highpassCoeffs, lowpassCoeffs;
     
     int lowFilterType, highFilterType;
+    int lowFilterSlope, highFilterSlope;
     
     juce::Path responseCurve;
+    ResponseCurve response;
     
     juce::OwnedArray<FilterNode> nodes;
     FilterNode* currentNode { nullptr };
     
     juce::Rectangle<int> mainArea;
     std::vector<int> frequencies;
+    CachedLayer gridLayer;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FilterVisualizer);
 };
@@ -176,6 +183,8 @@ private:
     juce::AudioProcessorValueTreeState& apvts;
     juce::ValueTree filterTree;
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> header, lowpassIcon, highpassIcon, lowshelfIcon, highshelfIcon, offIcon;
     
     CrosshairDragger crosshair;
@@ -16,8 +16,8 @@ FilterPicker::FilterPicker(juce::ValueTree tree, juce::RangedAudioParameter& qPa
 : paramTree(tree)
 , qParameter(qParam)
 , qAttachment(qParam, [&] (float val) { qChanged(val); })
-, previousIcon(juce::Drawable::createFromImageData(BinaryData::previous_svg, BinaryData::previous_svgSize))
-, nextIcon(juce::Drawable::createFromImageData(BinaryData::next_svg, BinaryData::next_svgSize))
+, previousIcon(svgCache->getDrawable(BinaryData::previous_svg, BinaryData::previous_svgSize))
+, nextIcon(svgCache->getDrawable(BinaryData::next_svg, BinaryData::next_svgSize))
 , previousButton(previousIcon)
 , nextButton(nextIcon)
 {
@@ -14,6 +14,7 @@
 #include "../service/ParamIDs.h"
 #include "GUIHelper.h"
 #include "FunctionalButton.h"
+#include "SvgCache.h"
 
 class FilterPicker : public juce::Component
                    , public juce::ValueTree::Listener
@@ -54,6 +55,8 @@ private:
     juce::Rectangle<int> leftArrowArea;
     juce::Rectangle<int> rightArrowArea;
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> previousIcon, nextIcon;
     FunctionalButton previousButton, nextButton;
     
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    FrameScheduler.cpp
+    Created: 20 Oct 2026 12:34:15am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "FrameScheduler.h"
+
+/* ----- ATTACHMENT ----- */
+
+FrameScheduler::Attachment::Attachment (juce::Component& t_component, Client& t_client, int t_framesPerSecond)
+: component(t_component)
+, client(t_client)
+, framesPerSecond(t_framesPerSecond)
+{
+}
+
+FrameScheduler::Attachment::~Attachment()
+{
+    if (scheduler != nullptr)
+        scheduler->removeClient(client);
+}
+
+void FrameScheduler::Attachment::update()
+{
+    auto* owner = component.findParentComponentOfClass<Owner>();
+    FrameScheduler* newScheduler = owner != nullptr ? &owner->getFrameScheduler() : nullptr;
+    
+    if (newScheduler == scheduler.get())
+        return;
+    
+    if (scheduler != nullptr)
+        scheduler->removeClient(client);
+    
+    scheduler = newScheduler;
+    
+    if (scheduler != nullptr)
+        scheduler->addClient(component, client, framesPerSecond);
+}
+
+void FrameScheduler::Attachment::setFrameRate (int newFramesPerSecond)
+{
+    framesPerSecond = newFramesPerSecond;
+    
+    if (scheduler != nullptr)
+    {
+        scheduler->removeClient(client);
+        scheduler->addClient(component, client, framesPerSecond);
+    }
+}
+
+/* ----- SCHEDULER ----- */
+
+FrameScheduler::FrameScheduler (juce::Component& t_editor)
+: editor(t_editor)
+, vBlankAttachment(&t_editor, [this] { onVBlank(); })
+{
+}
+
+FrameScheduler::~FrameScheduler()
+{
+    masterReference.clear();
+}
+
+void FrameScheduler::addClient (juce::Component& component, Client& client, int framesPerSecond)
+{
+    jassert (framesPerSecond > 0);
+    
+    removeClient(client);
+    registrations.push_back({ &component, &client, 1000.0 / juce::jmax(1, framesPerSecond), 0.0 });
+}
+
+void FrameScheduler::removeClient (Client& client)
+{
+    registrations.erase(std::remove_if(registrations.begin(), registrations.end(),
+                                       [&client] (const Registration& registration) { return registration.client == &client; }),
+                        registrations.end());
+}
+
+void FrameScheduler::onVBlank()
+{
+    // nothing to see, so nothing to work out
+    if (! editor.isShowing())
+        return;
+    
+    if (auto* peer = editor.getPeer(); peer == nullptr || peer->isMinimised())
+        return;
+    
+    const double now = juce::Time::getMillisecondCounterHiRes();
+    dirtyAreas.clear();
+    
+    for (auto& registration : registrations)
+    {
+        if (now < registration.nextDue || registration.component == nullptr)
+            continue;
+        
+        // stay on the client's own beat, but don't try to catch up on frames that were skipped
+        registration.nextDue = juce::jmax(registration.nextDue + registration.interval, now + registration.interval * 0.5);
+        
+        if (! registration.component->isShowing())
+            continue;
+        
+        const auto area = registration.client->advanceFrame();
+        
+        if (area.isEmpty())
+            continue;
+        
+        auto* component = registration.component.getComponent();
+        auto existing = std::find_if(dirtyAreas.begin(), dirtyAreas.end(),
+                                     [component] (const auto& dirty) { return dirty.first == component; });
+        
+        if (existing != dirtyAreas.end())
+            existing->second = existing->second.getUnion(area);
+        else
+            dirtyAreas.emplace_back(component, area);
+    }
+    
+    // invalidating everything before the peer paints lets it draw the whole frame in one pass
+    for (const auto& [component, area] : dirtyAreas)
+        component->repaint(area);
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    FrameScheduler.h
+    Created: 20 Oct 2026 12:34:15am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    One clock for every animated component in an editor, driven by the
+    display's refresh instead of a Timer per component.
+    
+    Each frame, every client that is due at its own frame rate advances its
+    state and returns the area of itself that changed. The areas are merged
+    per component and repainted together, so JUCE paints them all in one
+    pass, and a client whose state didn't change costs no paint at all.
+    While the editor is hidden or minimised no client is advanced.
+    
+    Clients hold an Attachment and call update() from parentHierarchyChanged();
+    it finds the scheduler of whichever editor the component is now inside,
+    so components that outlive an editor, like the LFO visualizers, follow
+    it around.
+*/
+class FrameScheduler
+{
+public:
+    class Client
+    {
+    public:
+        virtual ~Client() = default;
+        
+        /* returns the area that needs repainting, in the component's coordinates; empty if nothing changed */
+        virtual juce::Rectangle<int> advanceFrame() = 0;
+    };
+    
+    /* the editor that owns the scheduler implements this, so clients can find it */
+    class Owner
+    {
+    public:
+        virtual ~Owner() = default;
+        virtual FrameScheduler& getFrameScheduler() = 0;
+    };
+    
+    class Attachment
+    {
+    public:
+        Attachment (juce::Component& component, Client& client, int framesPerSecond);
+        ~Attachment();
+        
+        /* call from the component's parentHierarchyChanged() */
+        void update();
+        void setFrameRate (int framesPerSecond);
+        
+    private:
+        juce::Component& component;
+        Client& client;
+        int framesPerSecond;
+        juce::WeakReference<FrameScheduler> scheduler;
+        
+        JUCE_DECLARE_NON_COPYABLE (Attachment)
+    };
+    
+    explicit FrameScheduler (juce::Component& editor);
+    ~FrameScheduler();
+    
+    void addClient (juce::Component& component, Client& client, int framesPerSecond);
+    void removeClient (Client& client);
+
+private:
+    struct Registration
+    {
+        juce::Component::SafePointer<juce::Component> component;
+        Client* client;
+        double interval;
+        double nextDue;
+    };
+    
+    void onVBlank();
+    
+    juce::Component& editor;
+    std::vector<Registration> registrations;
+    std::vector<std::pair<juce::Component*, juce::Rectangle<int>>> dirtyAreas;
+    
+    juce::VBlankAttachment vBlankAttachment;
+    
+    JUCE_DECLARE_WEAK_REFERENCEABLE (FrameScheduler)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrameScheduler)
+};
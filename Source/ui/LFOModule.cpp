@@ -14,8 +14,8 @@
 LFOModule::LFOModule(juce::ValueTree t_lfoTree, juce::RangedAudioParameter& frequencyTimeParam, juce::RangedAudioParameter& frequencySyncParam, juce::RangedAudioParameter& rangeParam, LFOVisualizer& t_visualizer)
 : lfoTree(t_lfoTree)
 , selectionTree(lfoTree.getParent().getChildWithName(ParamIDs::lfoSelectionTree))
-, timeIcon(juce::Drawable::createFromImageData(BinaryData::frequencyHertz_svg, BinaryData::frequencyHertz_svgSize))
-, syncIcon(juce::Drawable::createFromImageData(BinaryData::frequencySync_svg, BinaryData::frequencySync_svgSize))
+, timeIcon(svgCache->getDrawable(BinaryData::frequencyHertz_svg, BinaryData::frequencyHertz_svgSize))
+, syncIcon(svgCache->getDrawable(BinaryData::frequencySync_svg, BinaryData::frequencySync_svgSize))
 , dragger(lfoTree.getType().toString())
 , visualizer(t_visualizer)
 , frequencySlider(frequencyTimeParam, frequencySyncParam, lfoTree)
@@ -19,6 +19,7 @@
 #include "TextSlider.h"
 #include "WavePicker.h"
 #include "ValueTreeComponents.h"
+#include "SvgCache.h"
 #include "../service/ParamIDs.h"
 
 class LFOModule  : public juce::Component
@@ -40,6 +41,8 @@ private:
     juce::ValueTree lfoTree;
     juce::ValueTree selectionTree;
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> timeIcon, syncIcon;
     
     CrosshairDragger dragger;
@@ -22,8 +22,6 @@ LFOVisualizer::LFOVisualizer()
 
 LFOVisualizer::~LFOVisualizer()
 {
-    if (isTimerRunning())
-        stopTimer();
 }
 
 void LFOVisualizer::setBufferSize(int newBufferSize)
@@ -61,7 +59,7 @@ void LFOVisualizer::pushBuffer (const juce::AudioBuffer<float>& bufferToPush)
 void LFOVisualizer::setRepaintRate (int frequencyInHz)
 {
     repaintRate = frequencyInHz;
-    startTimerHz(frequencyInHz);
+    frameAttachment.setFrameRate(frequencyInHz);
 }
 
 void LFOVisualizer::mouseDown (const juce::MouseEvent& event)
@@ -70,44 +68,47 @@ void LFOVisualizer::mouseDown (const juce::MouseEvent& event)
     
     if (viewOn)
     {
-        startTimerHz(repaintRate);
         values.fill(0.0f);
         float dummy;
         while (fifo.pop(dummy))
             ;
     }
-    else
-        stopTimer();
+    
+    repaint();
 }
 
 void LFOVisualizer::paint (juce::Graphics& g)
 {
     /* ----- DRAW VISUALIZER BACKGROUND ----- */
     
-    g.fillAll(MyColors::viewBackground);
-    
-    juce::Path gridLines;
     const auto bounds = getLocalBounds();
     
-    for (int i = 1; i < numXGridLines - 1; i++)
+    backgroundLayer.draw(g, bounds, [this, bounds] (juce::Graphics& g)
     {
-        const float x = bounds.getX() + (static_cast<float>(i) / (numXGridLines - 1)) * bounds.getWidth();
+        g.fillAll(MyColors::viewBackground);
         
-        gridLines.startNewSubPath(x, bounds.getY());
-        gridLines.lineTo         (x, bounds.getBottom());
-    }
-    
-    for (int i = 1; i < numYGridLines - 1; i++)
-    {
-        const float y = bounds.getY() + (static_cast<float>(i) / (numYGridLines - 1)) * bounds.getHeight();
+        juce::Path gridLines;
         
-        gridLines.startNewSubPath(bounds.getX(), y);
-        gridLines.lineTo         (bounds.getRight(), y);
-    }
-    
-    g.setColour(MyColors::darkPrimary);
-    g.strokePath(gridLines, juce::PathStrokeType(MyWidths::standardWidth));
-    GUIHelper::drawRectangleWithThickness(g, bounds.toFloat(), MyWidths::standardWidth);
+        for (int i = 1; i < numXGridLines - 1; i++)
+        {
+            const float x = bounds.getX() + (static_cast<float>(i) / (numXGridLines - 1)) * bounds.getWidth();
+            
+            gridLines.startNewSubPath(x, bounds.getY());
+            gridLines.lineTo         (x, bounds.getBottom());
+        }
+        
+        for (int i = 1; i < numYGridLines - 1; i++)
+        {
+            const float y = bounds.getY() + (static_cast<float>(i) / (numYGridLines - 1)) * bounds.getHeight();
+            
+            gridLines.startNewSubPath(bounds.getX(), y);
+            gridLines.lineTo         (bounds.getRight(), y);
+        }
+        
+        g.setColour(MyColors::darkPrimary);
+        g.strokePath(gridLines, juce::PathStrokeType(MyWidths::standardWidth));
+        GUIHelper::drawRectangleWithThickness(g, bounds.toFloat(), MyWidths::standardWidth);
+    });
     
     /* ----- DRAW LFO GRAPH ----- */
     
@@ -132,8 +133,18 @@ void LFOVisualizer::resized()
     mainArea = getLocalBounds().reduced(2);
 }
 
-void LFOVisualizer::timerCallback()
+void LFOVisualizer::parentHierarchyChanged()
+{
+    frameAttachment.update();
+}
+
+juce::Rectangle<int> LFOVisualizer::advanceFrame()
 {
+    if (!viewOn)
+        return {};
+    
+    bool hasNewSamples = false;
+    
     float newSample;
     while (fifo.pop(newSample))
     {
@@ -142,7 +153,9 @@ void LFOVisualizer::timerCallback()
 
         values.set(arrayIndex, newSample);
         arrayIndex++;
+        hasNewSamples = true;
     }
     
-    repaint();
+    // the whole trace scrolls, so any new sample dirties all of it
+    return hasNewSamples ? mainArea : juce::Rectangle<int>();
 }
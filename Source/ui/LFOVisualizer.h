@@ -12,13 +12,15 @@
 
 #include <JuceHeader.h>
 #include "GUIHelper.h"
+#include "FrameScheduler.h"
+#include "CachedLayer.h"
 #include "../service/farbot/fifo.hpp"
 
 //==============================================================================
 /*
 */
 class LFOVisualizer  : public juce::Component,
-                       private juce::Timer
+                       private FrameScheduler::Client
 {
 public:
     LFOVisualizer ();
@@ -36,6 +38,7 @@ public:
 
     void paint (juce::Graphics&) override;
     void resized() override;
+    void parentHierarchyChanged() override;
 
 private:
     juce::Array<float> values;
@@ -47,12 +50,15 @@ private:
     farbot::fifo<float, farbot::fifo_options::concurrency::single, farbot::fifo_options::concurrency::single, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty> fifo;
     
     juce::Rectangle<int> mainArea;
+    CachedLayer backgroundLayer;
     
     const int numXGridLines { 6 }, numYGridLines { 5 };
     
     bool viewOn = true;
 
-    void timerCallback() override;
+    juce::Rectangle<int> advanceFrame() override;
+    
+    FrameScheduler::Attachment frameAttachment { *this, *this, repaintRate };
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LFOVisualizer)
 };
@@ -16,8 +16,6 @@ MeterPair::MeterPair(PluginProcessor& t_processor)
 {
     setOpaque(true);
     
-    startTimerHz(refreshRate);
-    
     leftLevel.reset(processor.getSampleRate(), 0.25f);
     rightLevel.reset(processor.getSampleRate(), 0.25f);
     leftPeak.reset(processor.getSampleRate(), 0.2f, 1.0f);
@@ -36,8 +34,6 @@ MeterPair::MeterPair(PluginProcessor& t_processor)
 
 MeterPair::~MeterPair()
 {
-    stopTimer();
-    
     for (auto* child: getChildren())
         child->removeMouseListener(this);
 }
@@ -48,6 +44,10 @@ void MeterPair::mouseDown (const juce::MouseEvent& event)
     {
         displayLevel = -100.0f;
     }
+    else if (event.originalComponent == this && onMetersClicked != nullptr)
+    {
+        onMetersClicked();
+    }
 }
 
 void MeterPair::paintMeter (juce::Graphics& g, juce::SmoothedValue<float>& level, PeakLevel& peak, juce::Rectangle<int>& area)
@@ -76,10 +76,6 @@ void MeterPair::paintMeter (juce::Graphics& g, juce::SmoothedValue<float>& level
                area.getRight(),
                area.getBottom() - area.proportionOfHeight(normPeak),
                MyWidths::standardWidth);
-    
-    const int numSamples = processor.getSampleRate() * 1.0f / refreshRate;
-    level.skip(numSamples);
-    peak.skip(numSamples);
 }
 
 void MeterPair::paint (juce::Graphics& g)
@@ -93,26 +89,30 @@ void MeterPair::paint (juce::Graphics& g)
     
     /* ----- DRAW MARKINGS ----- */
     
-    juce::Path levelMarks;
-    
-    for (int decibelValue = DSPHelper::minimumLevelDecibels;
-         decibelValue < 6;
-         decibelValue += 6)
+    // the 0 db mark crosses the meters, so the markings stay a transparent layer on top of them
+    markingLayer.draw(g, getLocalBounds(), [this] (juce::Graphics& g)
     {
-        const float thisY = markingArea.getBottom() - markingArea.getHeight() * meterRange.convertTo0to1(decibelValue);
-        const float nextY = markingArea.getBottom() - markingArea.getHeight() * meterRange.convertTo0to1(decibelValue + 6);
+        juce::Path levelMarks;
         
-        if (decibelValue == 0)
-            levelMarks.startNewSubPath(leftMeterArea.getX(), thisY);
-        else
-            levelMarks.startNewSubPath(markingArea.getX(), thisY);
-        levelMarks.lineTo(markingArea.getRight(), thisY);
-        levelMarks.lineTo(markingArea.getRight(), nextY);
-        levelMarks.lineTo(markingArea.getX(), nextY);
-    }
-    
-    g.setColour(MyColors::white);
-    g.strokePath(levelMarks, juce::PathStrokeType(MyWidths::thinWidth));
+        for (int decibelValue = DSPHelper::minimumLevelDecibels;
+             decibelValue < 6;
+             decibelValue += 6)
+        {
+            const float thisY = markingArea.getBottom() - markingArea.getHeight() * meterRange.convertTo0to1(decibelValue);
+            const float nextY = markingArea.getBottom() - markingArea.getHeight() * meterRange.convertTo0to1(decibelValue + 6);
+            
+            if (decibelValue == 0)
+                levelMarks.startNewSubPath(leftMeterArea.getX(), thisY);
+            else
+                levelMarks.startNewSubPath(markingArea.getX(), thisY);
+            levelMarks.lineTo(markingArea.getRight(), thisY);
+            levelMarks.lineTo(markingArea.getRight(), nextY);
+            levelMarks.lineTo(markingArea.getX(), nextY);
+        }
+        
+        g.setColour(MyColors::white);
+        g.strokePath(levelMarks, juce::PathStrokeType(MyWidths::thinWidth));
+    });
 }
 
 void MeterPair::resized()
@@ -144,7 +144,7 @@ void MeterPair::setNewLevelAndPeak (juce::SmoothedValue<float>& level, PeakLevel
     else
         level.setTargetValue(newLevel);
     
-    const float newPeak = processor.getSimplePeak(channel);
+    const float newPeak = processor.getTruePeak(channel);
     peak.setValue(newPeak);
     
     if (displayPeak)
@@ -156,14 +156,37 @@ void MeterPair::setNewLevelAndPeak (juce::SmoothedValue<float>& level, PeakLevel
         displayLevel = level.getCurrentValue();
 }
 
-void MeterPair::timerCallback()
+void MeterPair::parentHierarchyChanged()
+{
+    frameAttachment.update();
+}
+
+juce::Rectangle<int> MeterPair::advanceFrame()
 {
+    const int numSamples = processor.getSampleRate() * 1.0f / refreshRate;
+    leftLevel.skip(numSamples);
+    rightLevel.skip(numSamples);
+    leftPeak.skip(numSamples);
+    rightPeak.skip(numSamples);
+    
     setNewLevelAndPeak(leftLevel, leftPeak, 0);
     setNewLevelAndPeak(rightLevel, rightPeak, 1);
     
+    // the label only repaints itself when its text actually changes
     const juce::String text = displayLevel < -96.0f ? "-inf db" : juce::String(displayLevel, 1) + " db";
     
     levelLabel.setText(text, juce::dontSendNotification);
     
-    repaint();
+    const std::array<float, 4> levels {
+        juce::jlimit(DSPHelper::minimumLevelDecibels, DSPHelper::maximumLevelDecibels, leftLevel.getCurrentValue()),
+        juce::jlimit(DSPHelper::minimumLevelDecibels, DSPHelper::maximumLevelDecibels, rightLevel.getCurrentValue()),
+        juce::jlimit(DSPHelper::minimumLevelDecibels, DSPHelper::maximumLevelDecibels, leftPeak.getValue()),
+        juce::jlimit(DSPHelper::minimumLevelDecibels, DSPHelper::maximumLevelDecibels, rightPeak.getValue())
+    };
+    
+    if (levels == paintedLevels)
+        return {};
+    
+    paintedLevels = levels;
+    return leftMeterArea.getUnion(rightMeterArea).expanded(2);
 }
@@ -13,6 +13,8 @@
 #include <JuceHeader.h>
 #include "../PluginProcessor.h"
 #include "GUIHelper.h"
+#include "FrameScheduler.h"
+#include "CachedLayer.h"
 #include "../dsp/DSPHelper.h"
 
 class PeakLevel
@@ -62,7 +64,7 @@ private:
 };
 
 class MeterPair  : public juce::Component
-                 , public juce::Timer
+                 , private FrameScheduler::Client
 {
 public:
     MeterPair(PluginProcessor& processor);
@@ -73,10 +75,12 @@ public:
     void paintMeter (juce::Graphics&, juce::SmoothedValue<float>& level, PeakLevel& peak, juce::Rectangle<int>& area);
     void paint (juce::Graphics&) override;
     void resized() override;
+    void parentHierarchyChanged() override;
     
     void setNewLevelAndPeak (juce::SmoothedValue<float>& level, PeakLevel& peak, const int channel);
     
-    void timerCallback() override;
+    /* clicks on the meters themselves, rather than the label */
+    std::function<void()> onMetersClicked;
 
 private:
     PluginProcessor& processor;
@@ -89,11 +93,19 @@ private:
     juce::Label levelLabel;
     
     juce::Rectangle<int> leftMeterArea, rightMeterArea, labelArea, markingArea;
+    CachedLayer markingLayer;
     
     juce::NormalisableRange<float> meterRange;
     float displayLevel { -100.0f };
     
     bool displayPeak { true };
     
+    // what was last drawn, so frames where the meters haven't moved skip the repaint
+    std::array<float, 4> paintedLevels {};
+    
+    juce::Rectangle<int> advanceFrame() override;
+    
+    FrameScheduler::Attachment frameAttachment { *this, *this, refreshRate };
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MeterPair)
 };
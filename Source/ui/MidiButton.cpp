@@ -11,11 +11,11 @@
 #include <JuceHeader.h>
 #include "MidiButton.h"
 
-MidiButton::MidiButton(juce::RangedAudioParameter& midiNoteParam, farbot::fifo<juce::MidiMessage, farbot::fifo_options::concurrency::single, farbot::fifo_options::concurrency::single, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty>& fifo)
+MidiButton::MidiButton(juce::RangedAudioParameter& midiNoteParam, NoteEventQueue& t_noteEvents)
 : midiNoteAttachment(midiNoteParam, [&] (float val) { midiNoteChanged(static_cast<int>(val)); })
-, midiFifo(fifo)
-, buttonStandby(juce::Drawable::createFromImageData(BinaryData::big_red_button_standby_svg, BinaryData::big_red_button_standby_svgSize))
-, buttonPressed(juce::Drawable::createFromImageData(BinaryData::big_red_button_pressed_svg, BinaryData::big_red_button_pressed_svgSize))
+, noteEvents(t_noteEvents)
+, buttonStandby(svgCache->getDrawable(BinaryData::big_red_button_standby_svg, BinaryData::big_red_button_standby_svgSize))
+, buttonPressed(svgCache->getDrawable(BinaryData::big_red_button_pressed_svg, BinaryData::big_red_button_pressed_svgSize))
 {
     setOpaque(true);
     
@@ -24,7 +24,7 @@ MidiButton::MidiButton(juce::RangedAudioParameter& midiNoteParam, farbot::fifo<j
 
 void MidiButton::mouseDown (const juce::MouseEvent& event)
 {
-    midiFifo.push(juce::MidiMessage::noteOn(1, noteNumber.load(), 1.0f));
+    noteEvents.push(NoteEvent::noteOn(1, noteNumber.load(), 1.0f));
     
     pressed = true;
     repaint();
@@ -32,7 +32,9 @@ void MidiButton::mouseDown (const juce::MouseEvent& event)
 
 void MidiButton::mouseUp (const juce::MouseEvent& event)
 {
-    midiFifo.push(juce::MidiMessage::noteOff(1, noteNumber.load(), 1.0f));
+    // a dropped note off would leave the note hanging, so it's worth knowing about while debugging
+    if (! noteEvents.push(NoteEvent::noteOff(1, noteNumber.load(), 1.0f)))
+        DBG("Note event queue full, dropped a note off (" << (int) noteEvents.getNumDroppedEvents() << " dropped so far)");
     
     pressed = false;
     repaint();
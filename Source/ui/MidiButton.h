@@ -11,13 +11,14 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "../service/farbot/fifo.hpp"
+#include "../service/NoteEventQueue.h"
 #include "GUIHelper.h"
+#include "SvgCache.h"
 
 class MidiButton  : public juce::Component
 {
 public:
-    MidiButton(juce::RangedAudioParameter& midiNoteParam, farbot::fifo<juce::MidiMessage, farbot::fifo_options::concurrency::single, farbot::fifo_options::concurrency::single, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty>& fifo);
+    MidiButton(juce::RangedAudioParameter& midiNoteParam, NoteEventQueue& noteEvents);
     
     void mouseDown (const juce::MouseEvent& event) override;
     void mouseUp   (const juce::MouseEvent& event) override;
@@ -30,10 +31,12 @@ private:
     
     juce::ParameterAttachment midiNoteAttachment;
     
-    farbot::fifo<juce::MidiMessage, farbot::fifo_options::concurrency::single, farbot::fifo_options::concurrency::single, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty, farbot::fifo_options::full_empty_failure_mode::return_false_on_full_or_empty>& midiFifo;
+    NoteEventQueue& noteEvents;
     
     std::atomic<int> noteNumber;
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> buttonStandby;
     std::unique_ptr<juce::Drawable> buttonPressed;
     
@@ -12,10 +12,10 @@
 
 PresetPanel::PresetPanel(PresetManager& pm)
 : presetManager(pm)
-, saveIcon(juce::Drawable::createFromImageData(BinaryData::save_svg, BinaryData::save_svgSize))
-, deleteIcon(juce::Drawable::createFromImageData(BinaryData::delete_svg, BinaryData::delete_svgSize))
-, previousIcon(juce::Drawable::createFromImageData(BinaryData::previous_svg, BinaryData::previous_svgSize))
-, nextIcon(juce::Drawable::createFromImageData(BinaryData::next_svg, BinaryData::next_svgSize))
+, saveIcon(svgCache->getDrawable(BinaryData::save_svg, BinaryData::save_svgSize))
+, deleteIcon(svgCache->getDrawable(BinaryData::delete_svg, BinaryData::delete_svgSize))
+, previousIcon(svgCache->getDrawable(BinaryData::previous_svg, BinaryData::previous_svgSize))
+, nextIcon(svgCache->getDrawable(BinaryData::next_svg, BinaryData::next_svgSize))
 , saveButton(saveIcon)
 , deleteButton(deleteIcon)
 , previousPresetButton(previousIcon)
@@ -68,12 +68,18 @@ PresetPanel::PresetPanel(PresetManager& pm)
     addAndMakeVisible(presetList);
     presetList.setComponentID(ComponentIDs::presetMenu);
     presetList.addListener(this);
+    
+    presetManager.getCatalog().addChangeListener(this);
 
     loadPresetList();
 }
 
 PresetPanel::~PresetPanel()
 {
+    if (watchingCatalog)
+        presetManager.getCatalog().removeWatcher();
+    
+    presetManager.getCatalog().removeChangeListener(this);
     presetList.removeListener(this);
     
     setLookAndFeel(nullptr);
@@ -102,6 +108,19 @@ void PresetPanel::resized()
     deleteButton.setBounds(bounds.removeFromLeft(squareButtonWidth));
 }
 
+void PresetPanel::visibilityChanged()
+{
+    if (isVisible() == watchingCatalog)
+        return;
+    
+    watchingCatalog = isVisible();
+    
+    if (watchingCatalog)
+        presetManager.getCatalog().addWatcher();
+    else
+        presetManager.getCatalog().removeWatcher();
+}
+
 void PresetPanel::comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged)
 {
     // TODO need ability to reselect selected preset
@@ -113,6 +132,13 @@ void PresetPanel::comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged)
     }
 }
 
+void PresetPanel::changeListenerCallback(juce::ChangeBroadcaster* source)
+{
+    // the catalog picked up presets added, edited or removed outside the plugin
+    if (source == &presetManager.getCatalog())
+        loadPresetList();
+}
+
 void PresetPanel::loadPresetList()
 {
     presetList.clear(juce::dontSendNotification);
@@ -12,6 +12,7 @@
 #include <JuceHeader.h>
 #include "ComponentIDs.h"
 #include "FunctionalButton.h"
+#include "SvgCache.h"
 #include "lnfs/PresetPanelLNF.h"
 #include "../service/PresetManager.h"
 
@@ -20,19 +21,24 @@
 */
 class PresetPanel  : public juce::Component
                    , public juce::ComboBox::Listener
+                   , private juce::ChangeListener
 {
 public:
     PresetPanel(PresetManager& pm);
     ~PresetPanel() override;
 
     void resized() override;
+    void visibilityChanged() override;
     
     void comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged) override;
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
     
     void loadPresetList();
 
 private:
     PresetManager& presetManager;
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> saveIcon;
     std::unique_ptr<juce::Drawable> deleteIcon;
     std::unique_ptr<juce::Drawable> previousIcon;
@@ -43,5 +49,8 @@ private:
     
     PresetPanelLNF lnf;
     
+    // holds a catalog watcher while visible, so outside changes to the directory show up in the list
+    bool watchingCatalog { false };
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetPanel)
 };
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.cpp
+    Created: 20 Oct 2026 2:41:08am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "ResponseCurve.h"
+
+/* ----- WORKER ----- */
+
+ResponseCurve::Worker::Worker()
+: juce::Thread("Response Curves")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+ResponseCurve::Worker::~Worker()
+{
+    signalThreadShouldExit();
+    notify();
+    stopThread(1000);
+}
+
+void ResponseCurve::Worker::submit (ResponseCurve& curve, Job job)
+{
+    {
+        const juce::ScopedLock sl (lock);
+        curve.pendingJob = std::move(job);
+        queue.addIfNotAlreadyThere(&curve);
+    }
+    
+    notify();
+}
+
+void ResponseCurve::Worker::remove (ResponseCurve& curve)
+{
+    // a curve can't go away mid-compute, and computes are short enough to just wait out
+    for (;;)
+    {
+        {
+            const juce::ScopedLock sl (lock);
+            
+            if (computing != &curve)
+            {
+                queue.removeFirstMatchingValue(&curve);
+                return;
+            }
+        }
+        
+        juce::Thread::yield();
+    }
+}
+
+bool ResponseCurve::Worker::collect (ResponseCurve& curve)
+{
+    const juce::ScopedLock sl (lock);
+    
+    if (! curve.hasReadyDecibels)
+        return false;
+    
+    // the buffers swap round, so a steady drag doesn't allocate
+    curve.decibels.swap(curve.readyDecibels);
+    curve.hasReadyDecibels = false;
+    return true;
+}
+
+void ResponseCurve::Worker::run()
+{
+    while (! threadShouldExit())
+    {
+        ResponseCurve* curve = nullptr;
+        Job job;
+        
+        {
+            const juce::ScopedLock sl (lock);
+            
+            if (! queue.isEmpty())
+            {
+                curve = queue.removeAndReturn(0);
+                job = std::move(curve->pendingJob);
+                computing = curve;
+            }
+        }
+        
+        if (curve == nullptr)
+        {
+            wait(-1);
+            continue;
+        }
+        
+        curve->compute(job);
+        
+        const juce::ScopedLock sl (lock);
+        curve->readyDecibels.swap(curve->computedDecibels);
+        curve->hasReadyDecibels = true;
+        curve->triggerAsyncUpdate();
+        computing = nullptr;
+    }
+}
+
+/* ----- RESPONSE CURVE ----- */
+
+ResponseCurve::ResponseCurve()
+{
+}
+
+ResponseCurve::~ResponseCurve()
+{
+    worker->remove(*this);
+}
+
+ResponseCurve::Stage ResponseCurve::makeStage (const juce::dsp::IIR::Coefficients<float>& coefficients)
+{
+    jassert (coefficients.getFilterOrder() == 2);
+    
+    const float* raw = coefficients.getRawCoefficients();
+    return { raw[0], raw[1], raw[2], raw[3], raw[4] };
+}
+
+void ResponseCurve::request (std::vector<Stage> stages, int numPoints, double sampleRate)
+{
+    worker->submit(*this, { std::move(stages), juce::jmax(0, numPoints), sampleRate });
+}
+
+void ResponseCurve::handleAsyncUpdate()
+{
+    if (worker->collect(*this) && onResponseReady)
+        onResponseReady(decibels);
+}
+
+void ResponseCurve::compute (const Job& job)
+{
+    const int numPoints = job.numPoints;
+    
+    if (numPoints != gridPoints || job.sampleRate != gridSampleRate)
+    {
+        gridPhis.resize((size_t) numPoints);
+        
+        for (int i = 0; i < numPoints; i++)
+        {
+            const double frequency = DSPHelper::mapNormalizedToFrequency((float) i / numPoints);
+            const double halfOmega = job.sampleRate > 0.0 ? juce::MathConstants<double>::pi * frequency / job.sampleRate : 0.0;
+            gridPhis[(size_t) i] = (float) (std::sin(halfOmega) * std::sin(halfOmega));
+        }
+        
+        gridPoints = numPoints;
+        gridSampleRate = job.sampleRate;
+    }
+    
+    powerGains.assign((size_t) numPoints, 1.0f);
+    
+    const float* phis = gridPhis.data();
+    float* gains = powerGains.data();
+    
+    for (const auto& stage : job.stages)
+    {
+        const auto [b0, b1, b2, a1, a2] = stage;
+        
+        const float numerator0 = (float) ((b0 + b1 + b2) * (b0 + b1 + b2));
+        const float numerator1 = (float) (-4.0 * (b0 * b1 + 4.0 * b0 * b2 + b1 * b2));
+        const float numerator2 = (float) (16.0 * b0 * b2);
+        const float denominator0 = (float) ((1.0 + a1 + a2) * (1.0 + a1 + a2));
+        const float denominator1 = (float) (-4.0 * (a1 + 4.0 * a2 + a1 * a2));
+        const float denominator2 = (float) (16.0 * a2);
+        
+        for (int i = 0; i < numPoints; i++)
+        {
+            const float phi = phis[i];
+            const float numerator = numerator0 + phi * (numerator1 + phi * numerator2);
+            const float denominator = denominator0 + phi * (denominator1 + phi * denominator2);
+            gains[i] = std::max(gains[i] * numerator / denominator, minimumPowerGain);
+        }
+    }
+    
+    computedDecibels.resize((size_t) numPoints);
+    
+    for (int i = 0; i < numPoints; i++)
+        computedDecibels[(size_t) i] = 10.0f * std::log10(gains[i]);
+}
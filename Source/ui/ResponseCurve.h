@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    ResponseCurve.h
+    Created: 20 Oct 2026 2:41:08am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../dsp/DSPHelper.h"
+
+/*
+    The magnitude response of a cascade of biquads over the editor's log
+    frequency grid, worked out on a background thread shared by every curve.
+    
+    Each grid point keeps sin^2 (w / 2) for its frequency, cached until the
+    width or sample rate changes, and every stage is evaluated as a ratio of
+    two quadratics in that term:
+    
+        |H|^2 = ((b0 + b1 + b2)^2 - 4 (b0 b1 + 4 b0 b2 + b1 b2) phi + 16 b0 b2 phi^2)
+              / ((1 + a1 + a2)^2 - 4 (a1 + 4 a2 + a1 a2) phi + 16 a2 phi^2)
+    
+    which stays accurate in float far below the cutoff, and runs as one
+    straight loop over the grid per stage that the compiler vectorises.
+    
+    request() only replaces the curve's pending settings, so while a node is
+    dragged the thread skips straight to the latest position; the result
+    comes back on the message thread through onResponseReady.
+*/
+class ResponseCurve  : private juce::AsyncUpdater
+{
+public:
+    /* one biquad normalised by a0: b0, b1, b2, a1, a2 */
+    using Stage = std::array<double, 5>;
+    
+    ResponseCurve();
+    ~ResponseCurve() override;
+    
+    static Stage makeStage (const juce::dsp::IIR::Coefficients<float>& coefficients);
+    
+    /* message thread; anything still waiting from an earlier request is dropped */
+    void request (std::vector<Stage> stages, int numPoints, double sampleRate);
+    
+    /* message thread; the response in decibels at each grid point */
+    std::function<void (const std::vector<float>& decibels)> onResponseReady;
+
+private:
+    struct Job
+    {
+        std::vector<Stage> stages;
+        int numPoints { 0 };
+        double sampleRate { 0.0 };
+    };
+    
+    class Worker  : private juce::Thread
+    {
+    public:
+        Worker();
+        ~Worker() override;
+        
+        void submit (ResponseCurve& curve, Job job);
+        void remove (ResponseCurve& curve);
+        bool collect (ResponseCurve& curve);
+        
+    private:
+        void run() override;
+        
+        juce::CriticalSection lock;
+        juce::Array<ResponseCurve*> queue;
+        ResponseCurve* computing { nullptr };
+        
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker);
+    };
+    
+    void handleAsyncUpdate() override;
+    
+    /* worker thread */
+    void compute (const Job& job);
+    
+    // anything past this gets no quieter on screen, and it keeps deep cascades out of denormals
+    static constexpr float minimumPowerGain { 1.0e-12f };
+    
+    juce::SharedResourcePointer<Worker> worker;
+    
+    // guarded by the worker's lock
+    Job pendingJob;
+    std::vector<float> readyDecibels;
+    bool hasReadyDecibels { false };
+    
+    // only touched by the worker thread
+    std::vector<float> gridPhis, powerGains, computedDecibels;
+    int gridPoints { -1 };
+    double gridSampleRate { 0.0 };
+    
+    // only touched by the message thread
+    std::vector<float> decibels;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResponseCurve);
+};
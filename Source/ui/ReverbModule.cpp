@@ -11,15 +11,22 @@
 #include <JuceHeader.h>
 #include "ReverbModule.h"
 
+namespace
+{
+    enum impulseItem { currentImpulse = 1, loadImpulse, clearImpulse };
+}
+
 ReverbModule::ReverbModule(PluginProcessor& t_processor,
                            juce::AudioProcessorValueTreeState& t_apvts,
+                           juce::ValueTree t_reverbTree,
                            juce::ValueTree t_lfoTree,
                            juce::ValueTree effectsOrderTree)
 : EffectsSlot(ParamIDs::reverbNode, effectsOrderTree)
 , processor(t_processor)
 , apvts(t_apvts)
+, reverbTree(t_reverbTree)
 , lfoTree(t_lfoTree)
-, header(juce::Drawable::createFromImageData(BinaryData::reverb_header_svg, BinaryData::reverb_header_svgSize))
+, header(svgCache->getDrawable(BinaryData::reverb_header_svg, BinaryData::reverb_header_svgSize))
 , crosshair(ParamIDs::reverbNode.toString())
 , xyPad(*apvts.getParameter(ParamIDs::reverbWidth), *apvts.getParameter(ParamIDs::reverbSize), *apvts.getParameter(ParamIDs::reverbDamping))
 , reverbSizeKnob   (*apvts.getParameter(ParamIDs::reverbSize), "Size", lfoTree.getChildWithName(ParamIDs::lfoReverbSize))
@@ -42,10 +49,50 @@ ReverbModule::ReverbModule(PluginProcessor& t_processor,
     reverbDampingKnob.setComponentID(ComponentIDs::reverbDamping);
     reverbWidthKnob.setComponentID(ComponentIDs::reverbWidth);
     mixSlider.setComponentID(ComponentIDs::reverbMix);
+    
+    // item IDs are the engine enum plus one, since a ComboBox reserves 0 for nothing selected
+    engineList.addItem("Freeverb", ParameterHelper::freeverb + 1);
+    engineList.addItem("FDN", ParameterHelper::feedbackDelayNetwork + 1);
+    engineList.addItem("Convolution", ParameterHelper::convolution + 1);
+    engineList.setLookAndFeel(&lnf);
+    engineList.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    engineList.setComponentID(ComponentIDs::reverbEngine);
+    addAndMakeVisible(engineList);
+    
+    engineList.onChange = [this]
+    {
+        reverbTree.setProperty(ParamIDs::reverbEngine, engineList.getSelectedId() - 1, nullptr);
+    };
+    
+    impulseList.setLookAndFeel(&lnf);
+    impulseList.setMouseCursor(juce::MouseCursor::PointingHandCursor);
+    impulseList.setComponentID(ComponentIDs::reverbImpulse);
+    addAndMakeVisible(impulseList);
+    
+    impulseList.onChange = [this]
+    {
+        const int selection = impulseList.getSelectedId();
+        
+        // both actions leave the current file selected; the tree updates the list once it has changed
+        impulseList.setSelectedId(currentImpulse, juce::dontSendNotification);
+        
+        if (selection == loadImpulse)
+            chooseImpulseFile();
+        else if (selection == clearImpulse)
+            reverbTree.setProperty(ParamIDs::reverbImpulseFile, "", nullptr);
+    };
+    
+    reverbTree.addListener(this);
+    updateEngineControls();
+    updateImpulseList();
 }
 
 ReverbModule::~ReverbModule()
 {
+    reverbTree.removeListener(this);
+    
+    engineList.setLookAndFeel(nullptr);
+    impulseList.setLookAndFeel(nullptr);
 }
 
 void ReverbModule::paint (juce::Graphics& g)
@@ -69,8 +116,16 @@ void ReverbModule::resized()
     crosshair.setBounds(MyWidths::buttonBounds.withX(4).withY(9));
     mixSlider.setBounds(MyWidths::smallTextSliderBounds.withX(1).withBottomY(getHeight() - 16));
     
-    juce::Rectangle<int> xyPadBounds (165, 165);
-    xyPad.setBounds(xyPadBounds.withCentre(bounds.removeFromTop(180).getCentre()));
+    const int margin = MyWidths::standardMarginInt;
+    
+    juce::Rectangle<int> xyPadBounds (140, 140);
+    xyPad.setBounds(xyPadBounds.withCentre(bounds.removeFromTop(150).getCentre()));
+    
+    juce::Rectangle<int> selectorsArea = bounds.removeFromTop(MyWidths::buttonDimension).reduced(margin, 0);
+    engineList.setBounds(selectorsArea.removeFromLeft(selectorsArea.proportionOfWidth(0.45f)));
+    selectorsArea.removeFromLeft(margin);
+    impulseList.setBounds(selectorsArea);
+    bounds.removeFromTop(margin);
     
     juce::Rectangle<int> knobsArea = bounds.removeFromTop(MyWidths::knobDimension);
     reverbWidthKnob.setBounds(knobsArea.removeFromLeft(MyWidths::knobDimension));
@@ -78,3 +133,61 @@ void ReverbModule::resized()
     reverbDampingKnob.setBounds(knobsArea.removeFromLeft(MyWidths::knobDimension));
 }
 
+
+void ReverbModule::valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier& property)
+{
+    if (property == ParamIDs::reverbEngine)
+        updateEngineControls();
+    else if (property == ParamIDs::reverbImpulseFile)
+        updateImpulseList();
+}
+
+void ReverbModule::updateEngineControls()
+{
+    const int engine = reverbTree[ParamIDs::reverbEngine];
+    const bool isConvolution = engine == ParameterHelper::convolution;
+    
+    engineList.setSelectedId(engine + 1, juce::dontSendNotification);
+    
+    // the pad drives size and damping as well as width, and width still has its own knob
+    for (auto* control : std::initializer_list<juce::Component*> { &xyPad, &reverbSizeKnob, &reverbDampingKnob })
+    {
+        control->setEnabled(! isConvolution);
+        control->setAlpha(isConvolution ? 0.4f : 1.0f);
+    }
+    
+    impulseList.setEnabled(isConvolution);
+    impulseList.setAlpha(isConvolution ? 1.0f : 0.4f);
+}
+
+void ReverbModule::updateImpulseList()
+{
+    const juce::String path = reverbTree[ParamIDs::reverbImpulseFile];
+    
+    impulseList.clear(juce::dontSendNotification);
+    impulseList.addItem(path.isEmpty() ? "No Impulse" : juce::File(path).getFileNameWithoutExtension(), currentImpulse);
+    impulseList.addSeparator();
+    impulseList.addItem("Load Impulse...", loadImpulse);
+    impulseList.addItem("Clear", clearImpulse);
+    impulseList.setItemEnabled(clearImpulse, path.isNotEmpty());
+    impulseList.setSelectedId(currentImpulse, juce::dontSendNotification);
+}
+
+void ReverbModule::chooseImpulseFile()
+{
+    const juce::File current (reverbTree[ParamIDs::reverbImpulseFile].toString());
+    
+    fileChooser = std::make_unique<juce::FileChooser>(
+        "Choose an impulse response",
+        current.existsAsFile() ? current.getParentDirectory() : juce::File::getSpecialLocation(juce::File::userDocumentsDirectory),
+        "*.wav;*.aif;*.aiff;*.flac"
+    );
+    fileChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                             [this] (const juce::FileChooser& chooser)
+        {
+            const auto resultFile = chooser.getResult();
+            
+            if (resultFile.existsAsFile())
+                reverbTree.setProperty(ParamIDs::reverbImpulseFile, resultFile.getFullPathName(), nullptr);
+        });
+}
@@ -19,13 +19,18 @@
 #include "CrosshairDragger.h"
 #include "TextSlider.h"
 #include "XYControlPad.h"
+#include "SvgCache.h"
+#include "lnfs/PresetPanelLNF.h"
 #include "../service/ParamIDs.h"
+#include "../service/ParameterHelper.h"
 
 class ReverbModule  : public EffectsSlot
+                    , private juce::ValueTree::Listener
 {
 public:
     ReverbModule(PluginProcessor& processor,
                 juce::AudioProcessorValueTreeState& apvts,
+                juce::ValueTree reverbTree,
                 juce::ValueTree lfoTree,
                 juce::ValueTree effectsOrderTree);
     ~ReverbModule() override;
@@ -34,13 +39,23 @@ public:
     void resized() override;
 
 private:
+    void valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier& property) override;
+    
+    // convolution ignores size and damping, so their controls are greyed out while it's selected
+    void updateEngineControls();
+    void updateImpulseList();
+    void chooseImpulseFile();
+    
     PluginProcessor& processor;
     juce::AudioProcessorValueTreeState& apvts;
+    juce::ValueTree reverbTree;
     juce::ValueTree lfoTree;
     juce::ValueTree effectsOrderTree;
     
     juce::Rectangle<int> mainArea;
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> header;
     
     CrosshairDragger crosshair;
@@ -53,5 +68,11 @@ private:
     
     TextSlider mixSlider;
     
+    juce::ComboBox engineList;
+    juce::ComboBox impulseList;
+    std::unique_ptr<juce::FileChooser> fileChooser;
+    
+    PresetPanelLNF lnf;
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReverbModule)
 };
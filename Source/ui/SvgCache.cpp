@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    SvgCache.cpp
+    Created: 20 Oct 2026 4:37:12am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#include "SvgCache.h"
+
+struct SvgCache::Asset
+{
+    static constexpr int maxImages { 4 };
+    
+    const juce::Image& getImage (int width, int height)
+    {
+        for (const auto& image : images)
+            if (image.getWidth() == width && image.getHeight() == height)
+                return image;
+        
+        if ((int) images.size() >= maxImages)
+            images.erase(images.begin());
+        
+        juce::Image image (juce::Image::ARGB, width, height, true);
+        
+        {
+            juce::Graphics imageGraphics (image);
+            drawable->drawWithin(imageGraphics, image.getBounds().toFloat(), juce::RectanglePlacement::stretchToFit, 1.0f);
+        }
+        
+        images.push_back(image);
+        return images.back();
+    }
+    
+    std::unique_ptr<juce::Drawable> drawable;
+    juce::Rectangle<float> bounds;
+    std::vector<juce::Image> images;
+};
+
+/* stands in for the parsed SVG, drawing the asset's image for whatever size it's drawn at */
+class SvgCache::CachedDrawable  : public juce::Drawable
+{
+public:
+    CachedDrawable(std::shared_ptr<Asset> t_asset)
+    : asset(std::move(t_asset))
+    {
+    }
+    
+    void paint (juce::Graphics& g) override
+    {
+        if (asset->bounds.isEmpty())
+            return;
+        
+        // drawWithin() has already added the transform from the drawable's bounds onto the caller's area
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        const juce::Image& image = asset->getImage(juce::jmax(1, juce::roundToInt(asset->bounds.getWidth() * scale)),
+                                                   juce::jmax(1, juce::roundToInt(asset->bounds.getHeight() * scale)));
+        
+        // the caller's colour may be translucent; an SVG draws with its own colours
+        juce::Graphics::ScopedSaveState state (g);
+        g.setOpacity(1.0f);
+        g.drawImage(image, asset->bounds);
+    }
+    
+    std::unique_ptr<juce::Drawable> createCopy() const override { return std::make_unique<CachedDrawable>(asset); }
+    juce::Rectangle<float> getDrawableBounds() const override { return asset->bounds; }
+    juce::Path getOutlineAsPath() const override { return asset->drawable->getOutlineAsPath(); }
+
+private:
+    std::shared_ptr<Asset> asset;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedDrawable);
+};
+
+std::unique_ptr<juce::Drawable> SvgCache::getDrawable (const void* data, int size)
+{
+    auto& asset = assets[data];
+    
+    if (asset == nullptr)
+    {
+        asset = std::make_shared<Asset>();
+        asset->drawable = juce::Drawable::createFromImageData(data, (size_t) size);
+        
+        jassert (asset->drawable != nullptr);
+        if (asset->drawable == nullptr)
+            asset->drawable = std::make_unique<juce::DrawableComposite>();
+        
+        asset->bounds = asset->drawable->getDrawableBounds();
+    }
+    
+    return std::make_unique<CachedDrawable>(asset);
+}
@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    SvgCache.h
+    Created: 20 Oct 2026 4:37:12am
+    Author:  Daphne Wilkerson
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+    The editor's SVG assets, each parsed from BinaryData once and shared by
+    every editor in the process.
+    
+    getDrawable() hands each caller its own small drawable, so components
+    keep their std::unique_ptr<juce::Drawable> icons and drawWithin() calls.
+    Those drawables paint from an image of the SVG rendered at the size and
+    physical pixel scale they land on screen at, so an icon's paths are
+    filled once per size rather than on every repaint. Each asset keeps the
+    last few sizes, which covers an icon shown at a couple of sizes and a
+    change of display scale.
+    
+    Hold it with a juce::SharedResourcePointer declared before any member
+    built from it. PluginEditor.cpp also keeps one until JUCE shuts down,
+    so the parsed assets and images outlive the editor and reopening it
+    skips the parsing. The processor never touches it. Message thread only.
+*/
+class SvgCache
+{
+public:
+    SvgCache() = default;
+    
+    std::unique_ptr<juce::Drawable> getDrawable (const void* data, int size);
+
+private:
+    struct Asset;
+    class CachedDrawable;
+    
+    std::map<const void*, std::shared_ptr<Asset>> assets;
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SvgCache);
+};
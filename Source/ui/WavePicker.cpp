@@ -14,8 +14,8 @@
 WavePicker::WavePicker(juce::ValueTree t_waveTree, const juce::Identifier& t_waveProperty)
 : waveTree(t_waveTree)
 , waveProperty(t_waveProperty)
-, previousSVG(juce::Drawable::createFromImageData(BinaryData::previous_svg, BinaryData::previous_svgSize))
-, nextSVG(juce::Drawable::createFromImageData(BinaryData::next_svg, BinaryData::next_svgSize))
+, previousSVG(svgCache->getDrawable(BinaryData::previous_svg, BinaryData::previous_svgSize))
+, nextSVG(svgCache->getDrawable(BinaryData::next_svg, BinaryData::next_svgSize))
 , previousButton(previousSVG)
 , nextButton(nextSVG)
 {
@@ -25,10 +25,10 @@ WavePicker::WavePicker(juce::ValueTree t_waveTree, const juce::Identifier& t_wav
     
     waveTree.addListener(this);
     
-    sineSVG = juce::Drawable::createFromImageData(BinaryData::sine_wave_svg, BinaryData::sine_wave_svgSize);
-    triangleSVG = juce::Drawable::createFromImageData(BinaryData::triangle_wave_svg, BinaryData::triangle_wave_svgSize);
-    sawtoothSVG = juce::Drawable::createFromImageData(BinaryData::saw_wave_svg, BinaryData::saw_wave_svgSize);
-    squareSVG = juce::Drawable::createFromImageData(BinaryData::square_wave_svg, BinaryData::square_wave_svgSize);
+    sineSVG = svgCache->getDrawable(BinaryData::sine_wave_svg, BinaryData::sine_wave_svgSize);
+    triangleSVG = svgCache->getDrawable(BinaryData::triangle_wave_svg, BinaryData::triangle_wave_svgSize);
+    sawtoothSVG = svgCache->getDrawable(BinaryData::saw_wave_svg, BinaryData::saw_wave_svgSize);
+    squareSVG = svgCache->getDrawable(BinaryData::square_wave_svg, BinaryData::square_wave_svgSize);
     
     addAndMakeVisible(previousButton);
     addAndMakeVisible(nextButton);
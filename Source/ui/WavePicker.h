@@ -13,6 +13,7 @@
 #include <JuceHeader.h>
 #include "GUIHelper.h"
 #include "FunctionalButton.h"
+#include "SvgCache.h"
 #include "../service/ParamIDs.h"
 
 // ORDER OF WAVEFORMS: sine, triangle, sawtooth, square
@@ -35,6 +36,8 @@ private:
     
     int wave { 0 };
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> sineSVG, triangleSVG, sawtoothSVG, squareSVG, previousSVG, nextSVG;
     
     juce::Rectangle<float> waveArea, leftArrowArea, rightArrowArea;
@@ -20,29 +20,33 @@ WaveshaperRadar::WaveshaperRadar()
 
 void WaveshaperRadar::paint(juce::Graphics &g)
 {
-    g.setColour(MyColors::viewBackground);
-    g.fillRect(mainArea);
-    
-    g.setColour(MyColors::darkPrimary);
-    
-    float lineRadius = lineInterval;
-    
-    juce::Path radarCircles;
-    
-    while (lineRadius < mainArea.getWidth() * 0.8f)
+    // the graph above repaints this with every drag, and the circles never change
+    radarLayer.draw(g, getLocalBounds(), [this] (juce::Graphics& g)
     {
-        radarCircles.addEllipse(center.x - lineRadius, center.y - lineRadius, lineRadius * 2.0f, lineRadius * 2.0f);
-        lineRadius += lineInterval;
-    }
-    
-    radarCircles.startNewSubPath(mainArea.getX(), center.y);
-    radarCircles.lineTo(mainArea.getRight(), center.y);
-    radarCircles.startNewSubPath(center.x, mainArea.getY());
-    radarCircles.lineTo(center.x, mainArea.getBottom());
-    
-    g.strokePath(radarCircles, juce::PathStrokeType{MyWidths::standardWidth});
-    
-    GUIHelper::drawRectangleWithThickness(g, mainArea, MyWidths::standardWidth);
+        g.setColour(MyColors::viewBackground);
+        g.fillRect(mainArea);
+        
+        g.setColour(MyColors::darkPrimary);
+        
+        float lineRadius = lineInterval;
+        
+        juce::Path radarCircles;
+        
+        while (lineRadius < mainArea.getWidth() * 0.8f)
+        {
+            radarCircles.addEllipse(center.x - lineRadius, center.y - lineRadius, lineRadius * 2.0f, lineRadius * 2.0f);
+            lineRadius += lineInterval;
+        }
+        
+        radarCircles.startNewSubPath(mainArea.getX(), center.y);
+        radarCircles.lineTo(mainArea.getRight(), center.y);
+        radarCircles.startNewSubPath(center.x, mainArea.getY());
+        radarCircles.lineTo(center.x, mainArea.getBottom());
+        
+        g.strokePath(radarCircles, juce::PathStrokeType{MyWidths::standardWidth});
+        
+        GUIHelper::drawRectangleWithThickness(g, mainArea, MyWidths::standardWidth);
+    });
 }
 
 void WaveshaperRadar::resized()
@@ -57,8 +61,9 @@ WaveshaperGraph::WaveshaperGraph(juce::RangedAudioParameter& t_xTransformParam,
                                  juce::RangedAudioParameter& t_yTransformParam,
                                  juce::ValueTree t_nodeTree,
                                  juce::ValueTree t_toolTree,
-                                 juce::dsp::LookupTableTransform<float>& t_controlTable,
-                                 juce::dsp::LookupTableTransform<float>& t_transformTable)
+                                 SwappableTable& t_controlTable,
+                                 SwappableTable& t_transformTable,
+                                 const std::atomic<uint32_t>& t_tableVersion)
 : xTransformParam(t_xTransformParam)
 , yTransformParam(t_yTransformParam)
 , xAttachment(xTransformParam, [&] (float i) { repaint(); }, nullptr)
@@ -67,6 +72,7 @@ WaveshaperGraph::WaveshaperGraph(juce::RangedAudioParameter& t_xTransformParam,
 , toolTree(t_toolTree)
 , controlTable(t_controlTable)
 , transformTable(t_transformTable)
+, tableVersion(t_tableVersion)
 {
     nodeTree.addListener(this);
     toolTree.addListener(this);
@@ -80,28 +86,43 @@ WaveshaperGraph::~WaveshaperGraph()
 
 void WaveshaperGraph::paint (juce::Graphics& g)
 {
-    juce::Path funcGraph;
-    funcGraph.startNewSubPath(mainArea.getX(), center.y - quadHeight * transformTable.processSample(-1.0f));
+    const uint32_t currentTableVersion = tableVersion.load();
     
-    for (float j = -1.0f; j < 1.0f; j+= 0.01f)
+    if (! hasPaths || pathTableVersion != currentTableVersion)
     {
-        funcGraph.lineTo(center.x + quadWidth * j, center.y - quadHeight * transformTable.processSample(j));
+        rebuildPaths();
+        pathTableVersion = currentTableVersion;
+        hasPaths = true;
     }
     
     g.setColour(MyColors::lightSecondary);
-    g.strokePath(funcGraph, juce::PathStrokeType{MyWidths::standardWidth, juce::PathStrokeType::curved});
+    g.strokePath(transformPath, juce::PathStrokeType{MyWidths::standardWidth, juce::PathStrokeType::curved});
     
-    funcGraph.clear();
+    g.setColour(MyColors::white);
+    g.strokePath(controlPath, juce::PathStrokeType{MyWidths::standardWidth, juce::PathStrokeType::curved});
+}
+
+void WaveshaperGraph::rebuildPaths()
+{
+    // each path is drawn from one table, even if the rebuilder swaps in a new one meanwhile
+    const SwappableTable::ScopedRead transform (transformTable);
+    const SwappableTable::ScopedRead control (controlTable);
     
-    funcGraph.startNewSubPath(mainArea.getX(), center.y - quadHeight * controlTable.processSample(-1.0f));
+    transformPath.clear();
+    transformPath.startNewSubPath(mainArea.getX(), center.y - quadHeight * transform->processSample(-1.0f));
     
     for (float j = -1.0f; j < 1.0f; j+= 0.01f)
     {
-        funcGraph.lineTo(center.x + quadWidth * j, center.y - quadHeight * controlTable.processSample(j));
+        transformPath.lineTo(center.x + quadWidth * j, center.y - quadHeight * transform->processSample(j));
     }
     
-    g.setColour(MyColors::white);
-    g.strokePath(funcGraph, juce::PathStrokeType{MyWidths::standardWidth, juce::PathStrokeType::curved});
+    controlPath.clear();
+    controlPath.startNewSubPath(mainArea.getX(), center.y - quadHeight * control->processSample(-1.0f));
+    
+    for (float j = -1.0f; j < 1.0f; j+= 0.01f)
+    {
+        controlPath.lineTo(center.x + quadWidth * j, center.y - quadHeight * control->processSample(j));
+    }
 }
 
 void WaveshaperGraph::resized()
@@ -111,6 +132,18 @@ void WaveshaperGraph::resized()
     center = mainArea.getCentre();
     quadWidth = mainArea.getWidth() / 2.0f;
     quadHeight = mainArea.getHeight() / 2.0f;
+    
+    hasPaths = false;
+}
+
+void WaveshaperGraph::parentHierarchyChanged()
+{
+    frameAttachment.update();
+}
+
+juce::Rectangle<int> WaveshaperGraph::advanceFrame()
+{
+    return tableVersion.load() != pathTableVersion ? getLocalBounds() : juce::Rectangle<int>();
 }
 
 void WaveshaperGraph::valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged, const juce::Identifier &property)
@@ -505,16 +538,16 @@ WaveshaperModule::WaveshaperModule(PluginProcessor& t_processor,
 , processor(t_processor)
 , apvts(t_apvts)
 , lfoTree(t_lfoTree)
-, header(juce::Drawable::createFromImageData(BinaryData::waveshaper_header_svg, BinaryData::waveshaper_header_svgSize))
-, oddIcon(juce::Drawable::createFromImageData(BinaryData::odd_svg, BinaryData::odd_svgSize))
-, evenIcon(juce::Drawable::createFromImageData(BinaryData::even_svg, BinaryData::even_svgSize))
-, inIcon(juce::Drawable::createFromImageData(BinaryData::in_svg, BinaryData::in_svgSize))
-, outIcon(juce::Drawable::createFromImageData(BinaryData::out_svg, BinaryData::out_svgSize))
-, xTransformIcon(juce::Drawable::createFromImageData(BinaryData::x_transform_svg, BinaryData::x_transform_svgSize))
-, yTransformIcon(juce::Drawable::createFromImageData(BinaryData::y_transform_svg, BinaryData::y_transform_svgSize))
+, header(svgCache->getDrawable(BinaryData::waveshaper_header_svg, BinaryData::waveshaper_header_svgSize))
+, oddIcon(svgCache->getDrawable(BinaryData::odd_svg, BinaryData::odd_svgSize))
+, evenIcon(svgCache->getDrawable(BinaryData::even_svg, BinaryData::even_svgSize))
+, inIcon(svgCache->getDrawable(BinaryData::in_svg, BinaryData::in_svgSize))
+, outIcon(svgCache->getDrawable(BinaryData::out_svg, BinaryData::out_svgSize))
+, xTransformIcon(svgCache->getDrawable(BinaryData::x_transform_svg, BinaryData::x_transform_svgSize))
+, yTransformIcon(svgCache->getDrawable(BinaryData::y_transform_svg, BinaryData::y_transform_svgSize))
 , crosshair(ParamIDs::waveshaperNode.toString())
 , radar()
-, graph(*apvts.getParameter(ParamIDs::waveshaperXTransform), *apvts.getParameter(ParamIDs::waveshaperYTransform), nodeTree, toolTree, processor.waveshaperControlTable, processor.waveshaperTransformTable)
+, graph(*apvts.getParameter(ParamIDs::waveshaperXTransform), *apvts.getParameter(ParamIDs::waveshaperYTransform), nodeTree, toolTree, processor.waveshaperControlTable, processor.waveshaperTransformTable, processor.waveshaperTableVersion)
 , controls(nodeTree)
 , oddEvenButton(toolTree, ParamIDs::oddEven, evenIcon, oddIcon, ValueTreeToolButton::showColoredBackgrounds | ValueTreeToolButton::fitBorderToBounds)
 , inputGainSlider(*apvts.getParameter(ParamIDs::waveshaperInputGain), inIcon, IconSlider::showColoredBackgrounds, lfoTree.getChildWithName(ParamIDs::lfoWaveshaperInputGain))
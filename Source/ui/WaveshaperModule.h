@@ -20,6 +20,9 @@
 #include "IconSlider.h"
 #include "EffectsSlot.h"
 #include "CrosshairDragger.h"
+#include "CachedLayer.h"
+#include "FrameScheduler.h"
+#include "SvgCache.h"
 #include "../service/ParamIDs.h"
 
 /* ----- WAVESHAPER RADAR ----- */
@@ -35,6 +38,7 @@ public:
 private:
     juce::Rectangle<float> mainArea;
     juce::Point<float> center;
+    CachedLayer radarLayer;
     
     const float lineInterval { 15.0f };
     
@@ -44,23 +48,28 @@ private:
 /* ----- WAVESHAPER GRAPH ----- */
 
 class WaveshaperGraph : public juce::Component,
-                        public juce::ValueTree::Listener
+                        public juce::ValueTree::Listener,
+                        private FrameScheduler::Client
 {
 public:
     WaveshaperGraph(juce::RangedAudioParameter& xTransformParam,
                     juce::RangedAudioParameter& yTransformParam,
                     juce::ValueTree nodeTree,
                     juce::ValueTree toolTree,
-                    juce::dsp::LookupTableTransform<float>& controlTable,
-                    juce::dsp::LookupTableTransform<float>& transformTable);
+                    SwappableTable& controlTable,
+                    SwappableTable& transformTable,
+                    const std::atomic<uint32_t>& tableVersion);
     ~WaveshaperGraph() override;
     
     void paint (juce::Graphics&) override;
     void resized() override;
+    void parentHierarchyChanged() override;
     
     void valueTreePropertyChanged(juce::ValueTree &treeWhosePropertyHasChanged, const juce::Identifier &property) override;
 
 private:
+    juce::Rectangle<int> advanceFrame() override;
+    
     juce::RangedAudioParameter& xTransformParam;
     juce::RangedAudioParameter& yTransformParam;
     juce::ParameterAttachment xAttachment;
@@ -68,14 +77,26 @@ private:
     
     juce::ValueTree nodeTree;
     juce::ValueTree toolTree;
-    juce::dsp::LookupTableTransform<float>& controlTable;
-    juce::dsp::LookupTableTransform<float>& transformTable;
+    SwappableTable& controlTable;
+    SwappableTable& transformTable;
+    const std::atomic<uint32_t>& tableVersion;
     
     juce::Rectangle<float> mainArea;
     juce::Point<float> center;
     float quadWidth;
     float quadHeight;
     
+    void rebuildPaths();
+    
+    // both curves are read from the tables, so they only change with a rebuild or a resize
+    juce::Path transformPath, controlPath;
+    uint32_t pathTableVersion { 0 };
+    bool hasPaths { false };
+    
+    // the tables land from the rebuild thread a frame or so after an edit, so the graph polls for them
+    const int refreshRate { 60 };
+    FrameScheduler::Attachment frameAttachment { *this, *this, refreshRate };
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveshaperGraph)
 };
 
@@ -145,6 +166,8 @@ private:
     
     juce::ValueTree lfoTree;
     
+    juce::SharedResourcePointer<SvgCache> svgCache;
+    
     std::unique_ptr<juce::Drawable> header, oddIcon, evenIcon, inIcon, outIcon, xTransformIcon, yTransformIcon;
     
     CrosshairDragger crosshair;